@@ -36,28 +36,9 @@ namespace jade
             typedef basic_verification<value_type> verification_type;
             verification_type::validate_c(c);
 
-            const auto rk = c.get_height();
-            const auto k  = rk + 1;
-
-            matrix_type padded_c (k, k);
-            for (size_t i = 0; i < rk; i++)
-                for (size_t j = 0; j < rk; j++)
-                    padded_c(i + 1, j + 1) = c(i, j);
-
-            matrix_type distances (k, k);
-            for (size_t i = 0; i < k; i++)
-            {
-                const auto c_ii = padded_c(i, i);
-                for (size_t j = 0; j < k; j++)
-                {
-                    const auto c_jj = padded_c(j, j);
-                    const auto c_ij = padded_c(i, j);
-                    distances(i, j) = c_ii + c_jj - c_ij - c_ij;
-                }
-            }
-
             typedef basic_neighbor_joining<value_type> algorithm_type;
-            const algorithm_type algorithm (distances);
+            const algorithm_type algorithm (
+                algorithm_type::create_distances(c));
 
             algorithm.write(out);
             out << std::endl;
@@ -10,6 +10,7 @@
 #include "jade.nwk2cov.hpp"
 #include "jade.nwk2svg.hpp"
 #include "jade.ped2dgm.hpp"
+#include "jade.vcf2lgm.hpp"
 #include "jade.version.hpp"
 
 namespace
@@ -24,6 +25,7 @@ ARGUMENTS
            nwk2cov
            nwk2svg
            ped2dgm
+           vcf2lgm
 
 COMMANDS
   bgl2lgm  Converts a beagle file to an lgm matrix.  Each line of the beagle
@@ -53,6 +55,14 @@ COMMANDS
            symbols separated by a space. Each pair of symbols is considered a
            pair of a column.
 
+  vcf2lgm  Converts a VCF file to an lgm matrix.  Genotype likelihoods are
+           taken from the GL field of each sample, or from the PL field if GL
+           is not available, and they are normalized like beagle percentages.
+           The alternate allele is considered the minor allele.  Sites that
+           are not biallelic are skipped, and missing values are treated as
+           uninformative.  Compressed data may be streamed through
+           standard input, e.g. using 'bgzip -dc'.
+
   For all commands, if no arguments are given, the source file is read from
   standard input and the output file is written to standard output. Otherwise,
   the path to the input file and output file must be specified after the
@@ -67,6 +77,7 @@ DESCRIPTION
 EXAMPLE
   $ convert nwk2svg foo.nwk foo.svg
   $ cat bar.bgl | convert bgl2lgm > bar.lgm
+  $ bgzip -dc baz.vcf.gz | convert vcf2lgm > baz.lgm
 
 BUGS
   Report any bugs to Jade Cheng <info@jade-cheng.com>.
@@ -140,6 +151,7 @@ int main(const int argc, const char * argv[])
         typedef jade::basic_nwk2cov<value_type> nwk2cov_type;
         typedef jade::basic_nwk2svg<value_type> nwk2svg_type;
         typedef jade::basic_ped2dgm<value_type> ped2dgm_type;
+        typedef jade::basic_vcf2lgm<value_type> vcf2lgm_type;
 
         const auto command = args.pop<std::string>();
 
@@ -148,6 +160,7 @@ int main(const int argc, const char * argv[])
         if (command == "nwk2cov") return ::execute<nwk2cov_type>(args);
         if (command == "nwk2svg") return ::execute<nwk2svg_type>(args);
         if (command == "ped2dgm") return ::execute<ped2dgm_type>(args);
+        if (command == "vcf2lgm") return ::execute<vcf2lgm_type>(args);
 
         throw jade::error() << "unsupported command '" << command << "'";
     }
@@ -51,8 +51,7 @@ namespace jade
 
             c.copy_lower_to_upper();
 
-            matrix_type::set_high_precision(out);
-            out << c;
+            c.write_exact(out);
         }
     };
 }
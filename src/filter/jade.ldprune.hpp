@@ -0,0 +1,290 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_LDPRUNE_HPP__
+#define JADE_LDPRUNE_HPP__
+
+#include "jade.args.hpp"
+#include "jade.marker_data.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that prunes markers in linkage disequilibrium.
+    /// Markers are visited in order, and a marker is removed if its squared
+    /// correlation with any kept marker in the preceding window exceeds a
+    /// specified threshold. Correlations are computed over the individuals
+    /// with genotypes for both markers; for discrete genotype matrices, they
+    /// are computed from bit-packed genotypes, and for likelihood genotype
+    /// matrices, they are computed from the expected genotypes.
+    ///
+    template <typename TValue>
+    class basic_ldprune
+    {
+    public:
+        typedef TValue                         value_type; ///< A value.
+        typedef basic_marker_data<value_type>  data_type;  ///< The data.
+
+        ///
+        /// Initializes a new instance of the class, reading the command-line
+        /// arguments.
+        ///
+        explicit basic_ldprune(
+                jade::args & a) ///< The command-line arguments.
+            : _window (_read_window(a))
+            , _max_r2 (_read_max_r2(a))
+        {
+        }
+
+        ///
+        /// Executes the filter through the specified streams.
+        ///
+        void execute(
+                std::istream & in,  ///< The input stream.
+                std::ostream & out) ///< The output stream.
+        {
+            const data_type data (in);
+            data.write(out, select(data));
+        }
+
+        ///
+        /// \return Flags indicating the markers to keep.
+        ///
+        std::vector<bool> select(
+                const data_type & data) ///< The marker data.
+                const
+        {
+            static const size_t block_length = 1024;
+
+            const auto I = data.get_individual_count();
+            const auto J = data.get_marker_count();
+
+            //
+            // Discrete genotypes are packed into bit planes so correlations
+            // can be computed with population counts.
+            //
+            const auto words  = (I + 63) / 64;
+            const auto planes = data.is_dgm()
+                ? _pack(data, words)
+                : std::vector<word_type>();
+
+            //
+            // Visit the blocks of markers in order. The markers of a block
+            // are compared with the preceding markers of their windows on
+            // multiple threads; each thread skips markers already removed
+            // from earlier blocks, stops at the first kept marker in high
+            // linkage disequilibrium, and otherwise records the markers of
+            // the same block in high linkage disequilibrium. The markers of
+            // the block are then visited in order to determine which ones to
+            // keep, so only the links of the current block are stored.
+            //
+            std::vector<bool> keep (J, true);
+            std::vector< std::vector<size_t> > links (block_length);
+
+            for (size_t first = 0; first < J; first += block_length)
+            {
+                const auto last = std::min(J, first + block_length);
+
+                parallel::for_each(last - first, [&](
+                    const size_t index,
+                    size_t)
+                {
+                    const auto j  = first + index;
+                    const auto k0 = j + 1 > _window ? j + 1 - _window : 0;
+
+                    auto & link = links[index];
+                    link.clear();
+                    for (auto k = k0; k < j; k++)
+                    {
+                        if (k < first && !keep[k])
+                            continue;
+
+                        const auto r2 = data.is_dgm()
+                            ? _get_r2_dgm(planes, words, k, j)
+                            : _get_r2_lgm(data, k, j);
+
+                        if (!(r2 > _max_r2))
+                            continue;
+
+                        link.push_back(k);
+                        if (k < first)
+                            break;
+                    }
+                });
+
+                for (auto j = first; j < last; j++)
+                    for (const auto k : links[j - first])
+                        if (keep[k])
+                            keep[j] = false;
+            }
+
+            return keep;
+        }
+
+    private:
+        typedef unsigned long long word_type;
+
+        // --------------------------------------------------------------------
+        // Packs the genotypes into three bit planes per marker: one for the
+        // heterozygous genotypes, one for the homozygous minor genotypes, and
+        // one for the genotypes that are not missing.
+        //
+        static std::vector<word_type> _pack(
+                const data_type & data,
+                const size_t      words)
+        {
+            const auto I = data.get_individual_count();
+            const auto J = data.get_marker_count();
+
+            std::vector<word_type> out (3 * words * J, 0);
+
+            parallel::for_each(J, [&](const size_t j, size_t)
+            {
+                const auto dosage = data.get_dosages(j);
+                const auto valid  = data.get_valid_flags(j);
+                const auto planes = out.data() + 3 * words * j;
+
+                for (size_t i = 0; i < I; i++)
+                {
+                    if (!valid[i])
+                        continue;
+
+                    const auto bit = word_type(1) << (i % 64);
+                    const auto w   = i / 64;
+                    planes[2 * words + w] |= bit;
+                    if (dosage[i] > value_type(1.5))
+                        planes[words + w] |= bit;
+                    else if (dosage[i] > value_type(0.5))
+                        planes[w] |= bit;
+                }
+            });
+
+            return out;
+        }
+
+        // --------------------------------------------------------------------
+        static value_type _get_r2(
+                const value_type n,
+                const value_type sx,
+                const value_type sy,
+                const value_type sxx,
+                const value_type syy,
+                const value_type sxy)
+        {
+            const auto vx = n * sxx - sx * sx;
+            const auto vy = n * syy - sy * sy;
+            if (!(vx > value_type(0) && vy > value_type(0)))
+                return value_type(0);
+
+            const auto cov = n * sxy - sx * sy;
+            return cov * cov / (vx * vy);
+        }
+
+        // --------------------------------------------------------------------
+        static value_type _get_r2_dgm(
+                const std::vector<word_type> & planes,
+                const size_t                   words,
+                const size_t                   k,
+                const size_t                   j)
+        {
+            typedef std::bitset<64> bits;
+
+            const auto x = planes.data() + 3 * words * k;
+            const auto y = planes.data() + 3 * words * j;
+
+            size_t n = 0, sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0;
+            for (size_t w = 0; w < words; w++)
+            {
+                const auto mask = x[2 * words + w] & y[2 * words + w];
+                const auto x1   = x[w] & mask;
+                const auto x2   = x[words + w] & mask;
+                const auto y1   = y[w] & mask;
+                const auto y2   = y[words + w] & mask;
+
+                const auto cx1 = bits(x1).count();
+                const auto cx2 = bits(x2).count();
+                const auto cy1 = bits(y1).count();
+                const auto cy2 = bits(y2).count();
+
+                n   += bits(mask).count();
+                sx  += cx1 + 2 * cx2;
+                sy  += cy1 + 2 * cy2;
+                sxx += cx1 + 4 * cx2;
+                syy += cy1 + 4 * cy2;
+                sxy += bits(x1 & y1).count()
+                     + bits(x1 & y2).count() * 2
+                     + bits(x2 & y1).count() * 2
+                     + bits(x2 & y2).count() * 4;
+            }
+
+            return _get_r2(
+                value_type(n),   value_type(sx),  value_type(sy),
+                value_type(sxx), value_type(syy), value_type(sxy));
+        }
+
+        // --------------------------------------------------------------------
+        static value_type _get_r2_lgm(
+                const data_type & data,
+                const size_t      k,
+                const size_t      j)
+        {
+            const auto I  = data.get_individual_count();
+            const auto x  = data.get_dosages(k);
+            const auto y  = data.get_dosages(j);
+            const auto vx = data.get_valid_flags(k);
+            const auto vy = data.get_valid_flags(j);
+
+            value_type n = 0, sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0;
+            for (size_t i = 0; i < I; i++)
+            {
+                if (!vx[i] || !vy[i])
+                    continue;
+
+                n   += 1;
+                sx  += x[i];
+                sy  += y[i];
+                sxx += x[i] * x[i];
+                syy += y[i] * y[i];
+                sxy += x[i] * y[i];
+            }
+
+            return _get_r2(n, sx, sy, sxx, syy, sxy);
+        }
+
+        ///
+        /// Returns the maximum squared correlation.
+        /// \return The maximum squared correlation.
+        ///
+        static value_type _read_max_r2(
+                jade::args & a) ///< The command-line arguments.
+        {
+            const auto value = a.pop<value_type>();
+            if (!(value >= value_type(0) && value <= value_type(1)))
+                throw error() << "invalid squared correlation: " << value;
+            return value;
+        }
+
+        ///
+        /// Returns the window size.
+        /// \return The window size.
+        ///
+        static size_t _read_window(
+                jade::args & a) ///< The command-line arguments.
+        {
+            const auto value = a.read<size_t>("--window", "-w", 50);
+            if (value < 2)
+                throw error() << "invalid window size: " << value;
+            return value;
+        }
+
+        size_t     _window; ///< The window size.
+        value_type _max_r2; ///< The maximum squared correlation.
+    };
+
+    typedef basic_ldprune<double> ldprune;
+}
+
+#endif // JADE_LDPRUNE_HPP__
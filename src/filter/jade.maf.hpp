@@ -0,0 +1,74 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_MAF_HPP__
+#define JADE_MAF_HPP__
+
+#include "jade.args.hpp"
+#include "jade.marker_data.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that removes markers with a minor allele
+    /// frequency below a specified threshold. For likelihood genotype
+    /// matrices, the frequency is based on the expected genotypes.
+    ///
+    template <typename TValue>
+    class basic_maf
+    {
+    public:
+        typedef TValue                         value_type; ///< A value.
+        typedef basic_marker_data<value_type>  data_type;  ///< The data.
+
+        ///
+        /// Initializes a new instance of the class, reading the command-line
+        /// arguments.
+        ///
+        explicit basic_maf(
+                jade::args & a) ///< The command-line arguments.
+            : _min_maf (_read_min_maf(a))
+        {
+        }
+
+        ///
+        /// Executes the filter through the specified streams.
+        ///
+        void execute(
+                std::istream & in,  ///< The input stream.
+                std::ostream & out) ///< The output stream.
+        {
+            const data_type data (in);
+
+            const auto J = data.get_marker_count();
+            std::vector<bool> keep (J);
+            for (size_t j = 0; j < J; j++)
+                keep[j] = !(data.get_maf(j) < _min_maf);
+
+            data.write(out, keep);
+        }
+
+    private:
+        ///
+        /// Returns the minimum minor allele frequency.
+        /// \return The minimum minor allele frequency.
+        ///
+        static value_type _read_min_maf(
+                jade::args & a) ///< The command-line arguments.
+        {
+            const auto value = a.pop<value_type>();
+            if (!(value >= value_type(0) && value <= value_type(0.5)))
+                throw error() << "invalid minor allele frequency: " << value;
+            return value;
+        }
+
+        value_type _min_maf; ///< The minimum minor allele frequency.
+    };
+
+    typedef basic_maf<double> maf;
+}
+
+#endif // JADE_MAF_HPP__
@@ -6,6 +6,9 @@
 
 #include "jade.args.hpp"
 #include "jade.version.hpp"
+#include "jade.ldprune.hpp"
+#include "jade.maf.hpp"
+#include "jade.missing.hpp"
 #include "jade.rema.hpp"
 
 namespace
@@ -16,9 +19,68 @@ namespace
 ARGUMENTS
   command  one of the following conversion types:
 
-           rema    Reduces the number of markers in a matrix.
+           ldprune  Removes markers in linkage disequilibrium.
+           maf      Removes markers with low minor allele frequencies.
+           missing  Removes markers with many missing genotypes.
+           rema     Reduces the number of markers in a matrix.
 
 COMMANDS
+  ldprune
+
+    USAGE
+      filter ldprune [options] <max-r2> [<input> <output>]
+
+    DESCRIPTION
+      This filter removes markers in linkage disequilibrium from a discrete
+      genotype matrix or a likelihood genotype matrix. The markers are visited
+      in order, and a marker is removed if its squared correlation with any
+      kept marker within the preceding window is greater than the value
+      specified as a required argument. Correlations are computed from the
+      genotypes, or from the expected genotypes of a likelihood genotype
+      matrix, of the individuals that are not missing data for either marker.
+
+    OPTIONS
+      --window,-w  indicates the next argument is the number of consecutive
+                   markers in each window; if unspecified, the program uses a
+                   window of 50 markers
+
+    EXAMPLE
+      $ filter ldprune 0.2 in.dgm out.dgm
+      $ cat in.lgm | filter ldprune --window 100 0.5 > out.lgm
+
+  maf
+
+    USAGE
+      filter maf <min-maf> [<input> <output>]
+
+    DESCRIPTION
+      This filter removes markers from a discrete genotype matrix or a
+      likelihood genotype matrix if their minor allele frequencies are less
+      than the value specified as a required argument. Frequencies are
+      computed from the genotypes, or from the expected genotypes of a
+      likelihood genotype matrix, of the individuals that are not missing
+      data for the marker.
+
+    EXAMPLE
+      $ filter maf 0.05 in.dgm out.dgm
+      $ cat in.lgm | filter maf 0.01 > out.lgm
+
+  missing
+
+    USAGE
+      filter missing <max-rate> [<input> <output>]
+
+    DESCRIPTION
+      This filter removes markers from a discrete genotype matrix or a
+      likelihood genotype matrix if the fraction of individuals missing data
+      for the marker is greater than the value specified as a required
+      argument. In a likelihood genotype matrix, a genotype is considered
+      missing when its three likelihoods are equal.
+
+    EXAMPLE
+      $ filter missing 0.1 in.dgm out.dgm
+      $ cat in.lgm | filter missing 0.05 > out.lgm
+
   rema
 
     USAGE
@@ -56,6 +118,7 @@ DESCRIPTION
 EXAMPLE
   $ filter rema 1000 in.lgm out.lgm
   $ cat in.lgm | filter rema --seed 1864 1000 > out.lgm
+  $ filter maf 0.05 in.dgm | filter ldprune 0.2 > out.dgm
 
 BUGS
   Report any bugs to Jade Cheng <info@jade-cheng.com>.
@@ -131,11 +194,17 @@ int main(const int argc, const char * argv[])
             return EXIT_SUCCESS;
         }
 
-        typedef jade::rema rema_type;
+        typedef jade::ldprune ldprune_type;
+        typedef jade::maf     maf_type;
+        typedef jade::missing missing_type;
+        typedef jade::rema    rema_type;
 
         const auto command = args.pop<std::string>();
 
-        if (command == "rema") return ::execute<rema_type>(args);
+        if (command == "ldprune") return ::execute<ldprune_type>(args);
+        if (command == "maf")     return ::execute<maf_type>(args);
+        if (command == "missing") return ::execute<missing_type>(args);
+        if (command == "rema")    return ::execute<rema_type>(args);
 
         throw jade::error() << "unsupported command '" << command << "'";
     }
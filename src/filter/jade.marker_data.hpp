@@ -0,0 +1,293 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_MARKER_DATA_HPP__
+#define JADE_MARKER_DATA_HPP__
+
+#include "jade.matrix.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that reads a discrete or likelihood genotype
+    /// matrix for the marker filters, computes statistics for each marker,
+    /// and writes a subset of the markers in the original format. A stream
+    /// containing one matrix is read as a discrete genotype matrix, and a
+    /// stream containing three matrices is read as a likelihood genotype
+    /// matrix. In a likelihood genotype matrix, a genotype is considered
+    /// missing when its three likelihoods are equal.
+    ///
+    template <typename TValue>
+    class basic_marker_data
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The matrix type.
+        typedef basic_matrix<value_type> matrix_type;
+
+        ///
+        /// Initializes a new instance of the class based on the specified
+        /// input stream.
+        ///
+        explicit basic_marker_data(
+                std::istream & in) ///< The input stream.
+            : _g        ()
+            , _is_dgm   (false)
+            , _dosage   ()
+            , _valid    ()
+            , _freq     ()
+            , _missing  ()
+        {
+            text_reader reader (in);
+
+            _g.resize(1);
+            _g[0].read(reader);
+
+            _is_dgm = reader.at_end();
+            if (_is_dgm)
+            {
+                _validate_dgm();
+            }
+            else
+            {
+                _g.resize(3);
+                _g[1].read(reader);
+                _g[2].read(reader);
+                if (!_g[0].is_size(_g[1]) || !_g[0].is_size(_g[2]))
+                    throw error()
+                        << "inconsistent likelihood genotype matrix sizes "
+                        << _g[0].get_size_str() << ", "
+                        << _g[1].get_size_str() << ", and "
+                        << _g[2].get_size_str();
+            }
+
+            _compute_dosages();
+        }
+
+        ///
+        /// \return The minor allele frequency of the specified marker, which
+        /// is never more than one half; it is zero if the genotypes of the
+        /// marker are all missing.
+        ///
+        inline value_type get_maf(
+                const size_t j) ///< The marker.
+                const
+        {
+            assert(j < _freq.size());
+            return std::min(_freq[j], value_type(1) - _freq[j]);
+        }
+
+        ///
+        /// \return The number of individuals.
+        ///
+        inline size_t get_individual_count() const
+        {
+            return _g[0].get_height();
+        }
+
+        ///
+        /// \return The number of markers.
+        ///
+        inline size_t get_marker_count() const
+        {
+            return _g[0].get_width();
+        }
+
+        ///
+        /// \return The fraction of missing genotypes of the specified marker.
+        ///
+        inline value_type get_missing_rate(
+                const size_t j) ///< The marker.
+                const
+        {
+            assert(j < _missing.size());
+            return _missing[j];
+        }
+
+        ///
+        /// \return The expected minor allele counts, ranging from zero to two,
+        /// for the specified marker; the values of missing genotypes are
+        /// undefined.
+        ///
+        inline const value_type * get_dosages(
+                const size_t j) ///< The marker.
+                const
+        {
+            assert(j < get_marker_count());
+            return _dosage.data() + j * get_individual_count();
+        }
+
+        ///
+        /// \return Flags indicating the genotypes of the specified marker
+        /// that are not missing.
+        ///
+        inline const char * get_valid_flags(
+                const size_t j) ///< The marker.
+                const
+        {
+            assert(j < get_marker_count());
+            return _valid.data() + j * get_individual_count();
+        }
+
+        ///
+        /// \return True if the data is a discrete genotype matrix.
+        ///
+        inline bool is_dgm() const
+        {
+            return _is_dgm;
+        }
+
+        ///
+        /// Writes the markers selected by the specified flags to the output
+        /// stream, using the format of the input data.
+        ///
+        /// \throw An exception if no markers are selected.
+        ///
+        void write(
+                std::ostream &            out,  ///< The output stream.
+                const std::vector<bool> & keep) ///< The markers to keep.
+                const
+        {
+            assert(keep.size() == get_marker_count());
+
+            std::vector<size_t> columns;
+            for (size_t j = 0; j < keep.size(); j++)
+                if (keep[j])
+                    columns.push_back(j);
+
+            if (columns.empty())
+                throw error() << "no markers remain after filtering "
+                              << get_marker_count() << " markers";
+
+            const auto I = get_individual_count();
+            const auto J = columns.size();
+
+            for (size_t k = 0; k < _g.size(); k++)
+            {
+                if (k > 0)
+                    out << '\n';
+
+                if (_is_dgm)
+                {
+                    basic_matrix<char> m (I, J);
+                    for (size_t i = 0; i < I; i++)
+                        for (size_t j = 0; j < J; j++)
+                            m(i, j) = char('0' + int(_g[k](i, columns[j])));
+                    m.write_exact(out);
+                }
+                else
+                {
+                    matrix_type m (I, J);
+                    for (size_t i = 0; i < I; i++)
+                        for (size_t j = 0; j < J; j++)
+                            m(i, j) = _g[k](i, columns[j]);
+                    m.write_exact(out);
+                }
+            }
+
+            out.flush();
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        // Computes the dosages of each marker in marker-major order, along
+        // with the allele frequencies and missing rates. The markers are
+        // processed in blocks on multiple threads.
+        //
+        void _compute_dosages()
+        {
+            static const size_t block_length = 256;
+
+            const auto I = get_individual_count();
+            const auto J = get_marker_count();
+
+            _dosage.resize(I * J);
+            _valid.resize(I * J);
+            _freq.resize(J);
+            _missing.resize(J);
+
+            const auto count = (J + block_length - 1) / block_length;
+            parallel::for_each(count, [&](const size_t block, size_t)
+            {
+                const auto last = std::min(J, (block + 1) * block_length);
+                for (auto j = block * block_length; j < last; j++)
+                {
+                    auto dosage = _dosage.data() + j * I;
+                    auto valid  = _valid.data() + j * I;
+
+                    size_t     n   = 0;
+                    value_type sum = 0;
+                    for (size_t i = 0; i < I; i++)
+                    {
+                        valid[i] = _is_dgm
+                            ? _read_dgm(_g[0](i, j), dosage[i])
+                            : _read_lgm(_g[0](i, j), _g[1](i, j),
+                                        _g[2](i, j), dosage[i]);
+                        if (valid[i])
+                        {
+                            n++;
+                            sum += dosage[i];
+                        }
+                    }
+
+                    _freq[j]    = n == 0 ? 0 : sum / value_type(2 * n);
+                    _missing[j] = I == 0 ? 0 : value_type(I - n) / value_type(I);
+                }
+            });
+        }
+
+        // --------------------------------------------------------------------
+        static bool _read_dgm(const value_type code, value_type & dosage)
+        {
+            dosage = code;
+            return code < value_type(3);
+        }
+
+        // --------------------------------------------------------------------
+        static bool _read_lgm(
+                const value_type g_aa,
+                const value_type g_Aa,
+                const value_type g_AA,
+                value_type &     dosage)
+        {
+            const auto sum = g_aa + g_Aa + g_AA;
+            dosage = sum > value_type(0)
+                ? (g_Aa + 2 * g_aa) / sum
+                : value_type(0);
+
+            const auto equal = !(g_aa < g_Aa || g_Aa < g_aa)
+                            && !(g_Aa < g_AA || g_AA < g_Aa);
+            return !equal;
+        }
+
+        // --------------------------------------------------------------------
+        void _validate_dgm() const
+        {
+            const auto & g = _g[0];
+            for (size_t i = 0; i < g.get_length(); i++)
+            {
+                const auto code = g[i];
+                if (!(code >= value_type(0) && code <= value_type(3) &&
+                        !(std::floor(code) < code)))
+                    throw error()
+                        << "invalid genotype " << code << " at cell ["
+                        << i / g.get_width() + 1 << ","
+                        << i % g.get_width() + 1 << "]";
+            }
+        }
+
+        std::vector<matrix_type> _g;
+        bool                     _is_dgm;
+        std::vector<value_type>  _dosage;
+        std::vector<char>        _valid;
+        std::vector<value_type>  _freq;
+        std::vector<value_type>  _missing;
+    };
+}
+
+#endif // JADE_MARKER_DATA_HPP__
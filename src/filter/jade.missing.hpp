@@ -0,0 +1,73 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_MISSING_HPP__
+#define JADE_MISSING_HPP__
+
+#include "jade.args.hpp"
+#include "jade.marker_data.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that removes markers with a fraction of missing
+    /// genotypes above a specified threshold.
+    ///
+    template <typename TValue>
+    class basic_missing
+    {
+    public:
+        typedef TValue                         value_type; ///< A value.
+        typedef basic_marker_data<value_type>  data_type;  ///< The data.
+
+        ///
+        /// Initializes a new instance of the class, reading the command-line
+        /// arguments.
+        ///
+        explicit basic_missing(
+                jade::args & a) ///< The command-line arguments.
+            : _max_rate (_read_max_rate(a))
+        {
+        }
+
+        ///
+        /// Executes the filter through the specified streams.
+        ///
+        void execute(
+                std::istream & in,  ///< The input stream.
+                std::ostream & out) ///< The output stream.
+        {
+            const data_type data (in);
+
+            const auto J = data.get_marker_count();
+            std::vector<bool> keep (J);
+            for (size_t j = 0; j < J; j++)
+                keep[j] = !(data.get_missing_rate(j) > _max_rate);
+
+            data.write(out, keep);
+        }
+
+    private:
+        ///
+        /// Returns the maximum missing rate.
+        /// \return The maximum missing rate.
+        ///
+        static value_type _read_max_rate(
+                jade::args & a) ///< The command-line arguments.
+        {
+            const auto value = a.pop<value_type>();
+            if (!(value >= value_type(0) && value <= value_type(1)))
+                throw error() << "invalid missing rate: " << value;
+            return value;
+        }
+
+        value_type _max_rate; ///< The maximum missing rate.
+    };
+
+    typedef basic_missing<double> missing;
+}
+
+#endif // JADE_MISSING_HPP__
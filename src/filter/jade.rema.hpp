@@ -8,7 +8,7 @@
 #define JADE_REMA_HPP__
 
 #include "jade.args.hpp"
-#include "jade.matrix.hpp"
+#include "jade.parallel.hpp"
 
 namespace jade
 {
@@ -38,18 +38,22 @@ namespace jade
         }
 
         ///
-        /// Executes the filter through the specified streams.
+        /// Executes the filter through the specified streams. The input is
+        /// read in large blocks, and the markers of each block are filtered
+        /// on multiple threads before the results are written in order.
         ///
         void execute(
                 istream & in,  ///< The input stream.
                 ostream & out) ///< The output stream.
         {
+            _input src (in);
+
             //
             // Read the dimensions of the matrix; this must be successful for
             // the first matrix.
             //
             size_t row_count, col_count;
-            if (!(in >> row_count >> col_count))
+            if (!_read_size(src, row_count) || !_read_size(src, col_count))
                 throw jade::error("error reading matrix dimensions");
 
             //
@@ -59,67 +63,51 @@ namespace jade
             const auto marker_count = std::min(col_count, _num_markers);
 
             //
-            // Using the appropriate seed, randomly shuffle a vector that
-            // contains all the possible indices of the matrix; then record a
-            // set of bits to mark the columns to keep.
+            // Using the appropriate seed, randomly select the columns to keep
+            // and record a set of bits to mark them.
             //
-            std::vector<bool> filter_flags;
-            filter_flags.resize(col_count, true);
-            {
-                typedef std::vector<size_t> vector_type;
-                vector_type indices (col_count);
-                std::iota(indices.begin(), indices.end(), 0);
-                _engine.seed(_seed);
-                std::shuffle(indices.begin(), indices.end(), _engine);
-                indices.resize(marker_count);
-                for (const auto index : indices)
-                    filter_flags[index] = false;
-            }
+            std::vector<bool> keep_flags (col_count, false);
+            for (const auto index : _select(col_count, marker_count))
+                keep_flags[index] = true;
 
             //
             // Filter the first matrix.
             //
-            _filter(in, out, row_count, col_count, marker_count, filter_flags);
+            _filter(src, out, row_count, col_count, marker_count, keep_flags);
 
             //
-            // Attempt to read a row; if this fails, assume this is the end of
-            // the data (a discrete genotype matrix), but otherwise, require
+            // Attempt to read a row; if there is no more data, assume this is
+            // the end of a discrete genotype matrix, but otherwise, require
             // the column, require consistent dimensions, and then read the
             // second matrix.
             //
             size_t r, c;
-            if (!(in >> r) && in.eof())
+            if (!_skip_whitespace(src))
                 return;
-            if (!(in >> c))
+            if (!_read_size(src, r) || !_read_size(src, c))
                 throw jade::error("error reading second matrix dimensions");
             if (r != row_count || c != col_count)
                 throw jade::error("inconsistent second matrix dimensions");
 
             out << char_type('\n');
-            _filter(in, out, row_count, col_count, marker_count, filter_flags);
+            _filter(src, out, row_count, col_count, marker_count, keep_flags);
 
             //
             // Require the third matrix of a consistent size.
             //
-            if (!(in >> r >> c))
+            if (!_read_size(src, r) || !_read_size(src, c))
                 throw jade::error("error reading third matrix dimensions");
             if (r != row_count || c != col_count)
                 throw jade::error("inconsistent third matrix dimensions");
 
             out << char_type('\n');
-            _filter(in, out, row_count, col_count, marker_count, filter_flags);
+            _filter(src, out, row_count, col_count, marker_count, keep_flags);
 
             //
             // Require the end of the data.
             //
-            for (;;)
-            {
-                const auto ch = in.get();
-                if (ch < 0)
-                    return;
-                if (!std::isspace(ch))
-                    throw jade::error("unexpected symbol after matrix data");
-            }
+            if (_skip_whitespace(src))
+                throw jade::error("unexpected symbol after matrix data");
         }
 
     private:
@@ -133,57 +121,306 @@ namespace jade
         ///
         typedef engine_type::result_type seed_type;
 
+        // --------------------------------------------------------------------
+        // The input stream and a buffer of text read from it. The buffer is
+        // always refilled so that it ends with whitespace, unless the end of
+        // the stream is reached; therefore, no token is split across blocks.
+        //
+        struct _input
+        {
+            // ----------------------------------------------------------------
+            explicit _input(istream & in_)
+                : in   (in_)
+                , buf  ()
+                , pos  (0)
+                , end  (0)
+                , size (0)
+                , eof  (false)
+            {
+            }
+
+            // ----------------------------------------------------------------
+            bool refill()
+            {
+                static const size_t block_length = size_t(1) << 22;
+
+                std::copy(buf.begin() + std::ptrdiff_t(pos),
+                          buf.begin() + std::ptrdiff_t(size),
+                          buf.begin());
+                size -= pos;
+                pos   = 0;
+                end   = 0;
+
+                while (!eof)
+                {
+                    buf.resize(size + block_length);
+                    in.read(buf.data() + size, std::streamsize(block_length));
+                    const auto n = size_t(in.gcount());
+                    eof = !in;
+
+                    for (auto i = size + n; i > size; i--)
+                    {
+                        if (_is_space(buf[i - 1]))
+                        {
+                            end = i;
+                            break;
+                        }
+                    }
+
+                    size += n;
+                    if (end != 0)
+                        break;
+                }
+
+                if (eof)
+                    end = size;
+
+                return pos != end;
+            }
+
+            istream &              in;
+            std::vector<char_type> buf;
+            size_t                 pos;
+            size_t                 end;
+            size_t                 size;
+            bool                   eof;
+        };
+
+        // --------------------------------------------------------------------
+        // Filters a block of whitespace-delimited text: the number of markers
+        // that begin in the block is counted first, and then the markers are
+        // copied to the output buffer if their columns are kept.
+        //
+        struct _chunk
+        {
+            // ----------------------------------------------------------------
+            _chunk()
+                : first (0)
+                , last  (0)
+                , count (0)
+                , index (0)
+                , out   ()
+            {
+            }
+
+            size_t                 first;
+            size_t                 last;
+            size_t                 count;
+            size_t                 index;
+            std::vector<char_type> out;
+        };
+
         // --------------------------------------------------------------------
         void _filter(
-                istream &                 in,
+                _input &                  src,
                 ostream &                 out,
                 const size_t              row_count,
                 const size_t              col_count,
                 const size_t              marker_count,
-                const std::vector<bool> & filter_flags)
+                const std::vector<bool> & keep_flags)
         {
+            static const size_t chunk_length = 65536;
+
             out << row_count    << char_type(' ')
                 << marker_count << char_type('\n');
 
-            //
-            // Loop over the rows and columns of the input matrix.
-            //
-            for (size_t r = 0; r < row_count; r++)
+            const auto length    = row_count * col_count;
+            const auto last_kept = marker_count == 0 ? size_t(0) : size_t(
+                std::find(keep_flags.rbegin(), keep_flags.rend(), true)
+                    .base() - keep_flags.begin() - 1);
+
+            std::vector<_chunk> chunks;
+            size_t              done = 0;
+
+            while (done < length)
             {
-                size_t m = 0;
-                for (size_t c = 0; c < col_count; c++)
+                if (src.pos == src.end && !src.refill())
+                    throw jade::error("unexpected end of matrix data");
+
+                //
+                // Split the text into chunks that begin on whitespace so that
+                // every marker begins in exactly one chunk.
+                //
+                char_type const * const base  = src.buf.data();
+                char_type const * const end   = base + src.end;
+                char_type const *       first = base + src.pos;
+
+                const auto n = std::min(
+                    4 * parallel::get_thread_count(),
+                    1 + size_t(end - first) / chunk_length);
+                const auto step = size_t(end - first) / n;
+
+                chunks.resize(n);
+                for (size_t k = 0; k < n; k++)
+                {
+                    auto last = k + 1 == n ? end : first + step;
+                    while (last != end && !_is_space(*last))
+                        last++;
+
+                    chunks[k].first = size_t(first - base);
+                    chunks[k].last  = size_t(last - base);
+                    first = last;
+                }
+
+                parallel::for_each(n, [&](const size_t k, size_t)
+                {
+                    auto & chunk = chunks[k];
+                    chunk.count  = _count_markers(
+                        base + chunk.first, base + chunk.last);
+                });
+
+                //
+                // Assign the index of the first marker in each chunk, and
+                // filter only as many markers as remain in this matrix.
+                //
+                auto index = done;
+                for (auto & chunk : chunks)
+                {
+                    chunk.index = index;
+                    index += chunk.count;
+                }
+
+                const auto stop = std::min(index, length);
+
+                parallel::for_each(n, [&](const size_t k, size_t)
+                {
+                    auto & chunk = chunks[k];
+                    chunk.out.clear();
+                    if (chunk.index >= stop)
+                        return;
+
+                    const auto last = base + chunk.last;
+
+                    auto ptr = base + chunk.first;
+                    auto i   = chunk.index;
+                    auto col = i % col_count;
+                    for (; i < stop; i++)
+                    {
+                        while (ptr != last && _is_space(*ptr))
+                            ptr++;
+                        if (ptr == last)
+                            break;
+
+                        const auto token = ptr;
+                        while (ptr != last && !_is_space(*ptr))
+                            ptr++;
+
+                        if (keep_flags[col])
+                        {
+                            chunk.out.insert(chunk.out.end(), token, ptr);
+                            chunk.out.push_back(col == last_kept
+                                ? char_type('\n')
+                                : char_type('\t'));
+                        }
+
+                        if (++col == col_count)
+                            col = 0;
+                    }
+
+                    chunk.last = size_t(ptr - base);
+                });
+
+                for (const auto & chunk : chunks)
                 {
-                    const auto is_unfiltered = !filter_flags[c];
-
-                    //
-                    // Skip whitespace; do not allow an end of stream error.
-                    //
-                    int ch;
-                    do
-                        if ((ch = in.get()) < 0)
-                            throw jade::error("unexpected end of matrix data");
-                    while (std::isspace(ch));
-
-                    //
-                    // Read all characters for the column, and write them to
-                    // the output stream if this column is not discarded; allow
-                    // an end of stream error in case the source stream does
-                    // not end with an end-of-line character.
-                    //
-                    do
-                        if (is_unfiltered)
-                            out.put(static_cast<char_type>(ch));
-                    while ((ch = in.get()) >= 0 && !std::isspace(ch));
-
-                    //
-                    // Add white-space or the end-of-line after each unfiltered
-                    // marker written to the output stream.
-                    //
-                    if (is_unfiltered)
-                        out << (++m == _num_markers
-                            ? char_type('\n')
-                            : char_type('\t'));
+                    if (chunk.index >= stop)
+                        break;
+
+                    out.write(chunk.out.data(),
+                              std::streamsize(chunk.out.size()));
+                    src.pos = chunk.last;
                 }
+
+                if (stop == index)
+                    src.pos = src.end;
+
+                done = stop;
+            }
+        }
+
+        // --------------------------------------------------------------------
+        static size_t _count_markers(
+                char_type const * first,
+                char_type const * last)
+        {
+            //
+            // Chunks begin with whitespace or at the end of a marker, so a
+            // marker begins at every transition from whitespace.
+            //
+            size_t count    = 0;
+            auto   is_space = true;
+            for (; first != last; first++)
+            {
+                const auto s = _is_space(*first);
+                count += size_t(is_space && !s);
+                is_space = s;
+            }
+
+            return count;
+        }
+
+        // --------------------------------------------------------------------
+        inline static bool _is_space(const char_type ch)
+        {
+            return ch == ' ' || (ch >= '\t' && ch <= '\r');
+        }
+
+        // --------------------------------------------------------------------
+        static bool _read_size(_input & src, size_t & value)
+        {
+            if (!_skip_whitespace(src))
+                return false;
+
+            value = 0;
+            auto any = false;
+            for (; src.pos != src.end; src.pos++)
+            {
+                const auto ch = src.buf[src.pos];
+                if (_is_space(ch))
+                    break;
+                if (ch < '0' || ch > '9')
+                    return false;
+                value = value * 10 + size_t(ch - '0');
+                any = true;
+            }
+
+            return any;
+        }
+
+        // --------------------------------------------------------------------
+        // Randomly selects the specified number of columns using Floyd's
+        // algorithm, which requires one random number per selected column
+        // rather than a permutation of all columns.
+        //
+        std::vector<size_t> _select(
+                const size_t col_count,
+                const size_t marker_count)
+        {
+            _engine.seed(_seed);
+
+            std::set<size_t> selected;
+            for (auto j = col_count - marker_count; j < col_count; j++)
+            {
+                std::uniform_int_distribution<size_t> dist (0, j);
+                if (!selected.insert(dist(_engine)).second)
+                    selected.insert(j);
+            }
+
+            return std::vector<size_t>(selected.begin(), selected.end());
+        }
+
+        // --------------------------------------------------------------------
+        static bool _skip_whitespace(_input & src)
+        {
+            for (;;)
+            {
+                while (src.pos != src.end && _is_space(src.buf[src.pos]))
+                    src.pos++;
+
+                if (src.pos != src.end)
+                    return true;
+
+                if (!src.refill())
+                    return false;
             }
         }
 
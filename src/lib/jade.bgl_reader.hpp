@@ -8,6 +8,7 @@
 #define JADE_BGL_READER_HPP__
 
 #include "jade.error.hpp"
+#include "jade.text_writer.hpp"
 
 namespace jade
 {
@@ -124,11 +125,16 @@ namespace jade
             const auto r3  = _rows * 3;
             const auto cr3 = _cols * _rows * 3;
 
+            text_writer writer (out);
+
             auto       grp_ptr = _buf.data();
             const auto grp_end = grp_ptr + 3;
             for (;;)
             {
-                out << _rows << ' ' << _cols << std::endl;
+                writer.write(_rows);
+                writer.put(' ');
+                writer.write(_cols);
+                writer.put('\n');
 
                 auto       row_ptr = grp_ptr;
                 const auto row_end = row_ptr + r3;
@@ -138,21 +144,24 @@ namespace jade
                     const auto col_end = col_ptr + cr3;
                     for (;;)
                     {
-                        out << *col_ptr;
+                        writer.write(*col_ptr);
                         col_ptr += r3;
                         if (col_ptr == col_end)
                             break;
-                        out << '\t';
+                        writer.put('\t');
                     }
 
-                    out << '\n';
+                    writer.put('\n');
                     row_ptr += 3;
                 }
 
                 if (++grp_ptr == grp_end)
                     break;
-                out << std::endl;
+                writer.put('\n');
             }
+
+            writer.flush();
+            out.flush();
         }
 
         ///
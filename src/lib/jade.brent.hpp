@@ -0,0 +1,175 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_BRENT_HPP__
+#define JADE_BRENT_HPP__
+
+#include "jade.assert.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that maximizes a function of one variable over
+    /// a closed interval using Brent's method, which combines golden-section
+    /// search with successive parabolic interpolation. The function is
+    /// assumed to be unimodal over the interval; otherwise, the method finds
+    /// a local maximum.
+    ///
+    template <typename TValue>
+    class basic_brent
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        ///
+        /// Finds the maximum of a function over the specified interval. The
+        /// end points of the interval are not evaluated.
+        ///
+        /// \param fn        The function to maximize; this function or lambda
+        ///                  must take one argument of type value_type and
+        ///                  return a value of type value_type.
+        /// \param lower     The lower bound of the interval.
+        /// \param upper     The upper bound of the interval.
+        /// \param tolerance The absolute tolerance of the result.
+        /// \param x         The location of the maximum.
+        ///
+        /// \return The value of the function at the location of the maximum.
+        ///
+        template <typename TFunction>
+        static value_type maximize(
+                const TFunction & fn,
+                value_type        lower,
+                value_type        upper,
+                const value_type  tolerance,
+                value_type &      x)
+        {
+            typedef std::numeric_limits<value_type> limits_type;
+
+            static const size_t max_iterations = 100;
+
+            static const auto golden = value_type(0.5) *
+                (value_type(3) - std::sqrt(value_type(5)));
+
+            static const auto eps = std::sqrt(limits_type::epsilon());
+
+            assert(lower < upper);
+            assert(tolerance > value_type(0));
+
+            //
+            // The algorithm minimizes the negated function; x is the best
+            // point found, w is the second best, and v is the previous value
+            // of w.
+            //
+            x = lower + golden * (upper - lower);
+            auto w  = x;
+            auto v  = x;
+            auto fx = -fn(x);
+            auto fw = fx;
+            auto fv = fx;
+            auto d  = value_type(0);
+            auto e  = value_type(0);
+
+            for (size_t iteration = 0; iteration < max_iterations; iteration++)
+            {
+                const auto m    = value_type(0.5) * (lower + upper);
+                const auto tol1 = eps * std::fabs(x) + tolerance / 3;
+                const auto tol2 = value_type(2) * tol1;
+
+                const auto half = value_type(0.5) * (upper - lower);
+                if (std::fabs(x - m) <= tol2 - half)
+                    break;
+
+                //
+                // Attempt a parabolic step through x, w, and v; fall back to
+                // a golden-section step if it is unacceptable.
+                //
+                auto p = value_type(0);
+                auto q = value_type(0);
+                auto r = value_type(0);
+
+                if (std::fabs(e) > tol1)
+                {
+                    r = (x - w) * (fx - fv);
+                    q = (x - v) * (fx - fw);
+                    p = (x - v) * q - (x - w) * r;
+                    q = value_type(2) * (q - r);
+
+                    if (q > value_type(0))
+                        p = -p;
+                    else
+                        q = -q;
+
+                    r = e;
+                    e = d;
+                }
+
+                if (std::fabs(p) < std::fabs(value_type(0.5) * q * r) &&
+                        p > q * (lower - x) && p < q * (upper - x))
+                {
+                    d = p / q;
+                    const auto u = x + d;
+                    if (u - lower < tol2 || upper - u < tol2)
+                        d = x < m ? tol1 : -tol1;
+                }
+                else
+                {
+                    e = (x < m ? upper : lower) - x;
+                    d = golden * e;
+                }
+
+                const auto u = std::fabs(d) >= tol1
+                    ? x + d
+                    : x + (d > value_type(0) ? tol1 : -tol1);
+
+                const auto fu = -fn(u);
+
+                if (fu <= fx)
+                {
+                    if (u < x)
+                        upper = x;
+                    else
+                        lower = x;
+
+                    v = w; fv = fw;
+                    w = x; fw = fx;
+                    x = u; fx = fu;
+                }
+                else
+                {
+                    if (u < x)
+                        lower = u;
+                    else
+                        upper = u;
+
+                    if (fu <= fw || _equals(w, x))
+                    {
+                        v = w; fv = fw;
+                        w = u; fw = fu;
+                    }
+                    else if (fu <= fv || _equals(v, x) || _equals(v, w))
+                    {
+                        v = u; fv = fu;
+                    }
+                }
+            }
+
+            return -fx;
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        static bool _equals(const value_type a, const value_type b)
+        {
+            return !(a < b || b < a);
+        }
+    };
+
+    /// A class that maximizes a function of one variable.
+    typedef basic_brent<double> brent;
+}
+
+#endif // JADE_BRENT_HPP__
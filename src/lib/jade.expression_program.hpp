@@ -0,0 +1,289 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_EXPRESSION_PROGRAM_HPP__
+#define JADE_EXPRESSION_PROGRAM_HPP__
+
+#include "jade.error.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that holds arithmetic expressions compiled
+    /// into a flat sequence of stack instructions. Variables are resolved to
+    /// indices into an array of arguments, and each expression stores its
+    /// result into an array of outputs, so one pass through the program
+    /// evaluates every expression without allocating memory or looking up
+    /// names.
+    ///
+    template <typename TFloat>
+    class basic_expression_program
+    {
+    public:
+        typedef TFloat float_type; ///< The floating-point type.
+
+        ///
+        /// The operation performed by an instruction.
+        ///
+        enum opcode
+        {
+            number,   ///< Pushes a constant.
+            variable, ///< Pushes an argument.
+            plus,     ///< Adds the top two values.
+            minus,    ///< Subtracts the top value from the one below it.
+            star,     ///< Multiplies the top two values.
+            slash,    ///< Divides the value below the top by the top value.
+            store     ///< Pops the top value into an output.
+        };
+
+        ///
+        /// An instruction of the program.
+        ///
+        struct instruction
+        {
+            opcode     op;    ///< The operation.
+            size_t     index; ///< The argument or output index.
+            float_type value; ///< The constant.
+        };
+
+        ///
+        /// Initializes a new instance of the class with no instructions.
+        ///
+        basic_expression_program()
+            : _code       ()
+            , _depth      (0)
+            , _stack_size (0)
+            , _outputs    (0)
+        {
+        }
+
+        ///
+        /// Appends an instruction that pushes a constant.
+        ///
+        void push_number(
+                const float_type value) ///< The constant.
+        {
+            _append(number, 0, value);
+            _push();
+        }
+
+        ///
+        /// Appends an instruction that pushes an argument.
+        ///
+        void push_variable(
+                const size_t index) ///< The argument index.
+        {
+            _append(variable, index, float_type(0));
+            _push();
+        }
+
+        ///
+        /// Appends an instruction that combines the top two values of the
+        /// stack using an arithmetic operator.
+        ///
+        void apply(
+                const opcode op) ///< The operator.
+        {
+            if (op != plus && op != minus && op != star && op != slash)
+                throw jade::error("invalid operator");
+            if (_depth < 2)
+                throw jade::error("invalid expression");
+
+            _append(op, 0, float_type(0));
+            _depth--;
+        }
+
+        ///
+        /// Appends an instruction that stores the value of the current
+        /// expression into an output. The stack must hold exactly the one
+        /// value computed by the expression.
+        ///
+        void store_output(
+                const size_t index) ///< The output index.
+        {
+            if (_depth != 1)
+                throw jade::error("invalid expression");
+
+            _append(store, index, float_type(0));
+            _outputs = std::max(_outputs, index + 1);
+            _depth   = 0;
+        }
+
+        ///
+        /// \return The instructions of the program.
+        ///
+        inline const std::vector<instruction> & get_code() const
+        {
+            return _code;
+        }
+
+        ///
+        /// \return The number of values the outputs must hold to evaluate the
+        /// program.
+        ///
+        inline size_t get_output_count() const
+        {
+            return _outputs;
+        }
+
+        ///
+        /// \return The number of values the stack must hold to evaluate the
+        /// program.
+        ///
+        inline size_t get_stack_size() const
+        {
+            return _stack_size;
+        }
+
+        ///
+        /// Evaluates the program. The caller provides the stack, which must
+        /// hold get_stack_size() values, so several threads may evaluate the
+        /// same program concurrently.
+        ///
+        void evaluate(
+                const float_type * args,  ///< The arguments.
+                float_type *       stack, ///< The stack.
+                float_type *       out)   ///< The outputs.
+                const
+        {
+            auto top = stack;
+
+            for (const auto & i : _code)
+            {
+                switch (i.op)
+                {
+                    case number:   *top++ = i.value;       break;
+                    case variable: *top++ = args[i.index]; break;
+                    case plus:     top--; top[-1] += *top; break;
+                    case minus:    top--; top[-1] -= *top; break;
+                    case star:     top--; top[-1] *= *top; break;
+                    case slash:    top--; top[-1] /= *top; break;
+                    case store:    out[i.index] = *--top;  break;
+                }
+            }
+
+            assert(top == stack);
+        }
+
+        ///
+        /// Evaluates the program and, using forward-mode differentiation, the
+        /// partial derivatives of each output with respect to each argument.
+        /// Every value on the stack carries the derivatives of that value, so
+        /// the derivative stack must hold get_stack_size() * n values, and
+        /// the derivatives of output i with respect to argument k are stored
+        /// at index i * n + k of the output derivatives.
+        ///
+        void evaluate_gradient(
+                const float_type * args,   ///< The arguments.
+                const size_t       n,      ///< The number of arguments.
+                float_type *       stack,  ///< The stack.
+                float_type *       dstack, ///< The derivative stack.
+                float_type *       out,    ///< The outputs.
+                float_type *       dout)   ///< The output derivatives.
+                const
+        {
+            auto top  = stack;
+            auto dtop = dstack;
+
+            for (const auto & i : _code)
+            {
+                if (i.op == number || i.op == variable)
+                {
+                    std::fill(dtop, dtop + n, float_type(0));
+                    if (i.op == variable)
+                        dtop[i.index] = float_type(1);
+
+                    *top++ = i.op == number ? i.value : args[i.index];
+                    dtop += n;
+                    continue;
+                }
+
+                //
+                // Pop the top value; for operators, lhs and dlhs refer to the
+                // value below it, which receives the result.
+                //
+                top--;
+                dtop -= n;
+
+                const auto rhs  = *top;
+                const auto drhs = dtop;
+
+                if (i.op == store)
+                {
+                    out[i.index] = rhs;
+                    std::copy(drhs, drhs + n, dout + i.index * n);
+                    continue;
+                }
+
+                auto &     lhs  = top[-1];
+                const auto dlhs = dtop - n;
+
+                switch (i.op)
+                {
+                    case plus:
+                        for (size_t k = 0; k < n; k++)
+                            dlhs[k] += drhs[k];
+                        lhs += rhs;
+                        break;
+
+                    case minus:
+                        for (size_t k = 0; k < n; k++)
+                            dlhs[k] -= drhs[k];
+                        lhs -= rhs;
+                        break;
+
+                    case star:
+                        for (size_t k = 0; k < n; k++)
+                            dlhs[k] = dlhs[k] * rhs + lhs * drhs[k];
+                        lhs *= rhs;
+                        break;
+
+                    case slash:
+                        lhs /= rhs;
+                        for (size_t k = 0; k < n; k++)
+                            dlhs[k] = (dlhs[k] - lhs * drhs[k]) / rhs;
+                        break;
+
+                    default:
+                        assert(false);
+                        break;
+                }
+            }
+
+            assert(top == stack);
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        void _append(
+                const opcode     op,
+                const size_t     index,
+                const float_type value)
+        {
+            instruction i;
+            i.op    = op;
+            i.index = index;
+            i.value = value;
+            _code.push_back(i);
+        }
+
+        // --------------------------------------------------------------------
+        void _push()
+        {
+            _stack_size = std::max(_stack_size, ++_depth);
+        }
+
+        std::vector<instruction> _code;       // The instructions.
+        size_t                   _depth;      // The depth while compiling.
+        size_t                   _stack_size; // The maximum depth.
+        size_t                   _outputs;    // The maximum output index + 1.
+    };
+
+    /// A class that holds compiled arithmetic expressions.
+    typedef basic_expression_program<double> expression_program;
+}
+
+#endif // JADE_EXPRESSION_PROGRAM_HPP__
@@ -9,6 +9,7 @@
 
 #include "jade.discrete_genotype_matrix.hpp"
 #include "jade.likelihood_genotype_matrix.hpp"
+#include "jade.vcf_reader.hpp"
 
 namespace jade
 {
@@ -35,6 +36,10 @@ namespace jade
         typedef basic_likelihood_genotype_matrix<value_type>
             likelihood_genotype_matrix_type;
 
+        /// The VCF reader type.
+        typedef basic_vcf_reader<value_type>
+            vcf_reader_type;
+
         ///
         /// Creates a genotype matrix based on values from a file. This function
         /// determines what kind of genotype matrix to create based on the file
@@ -60,6 +65,9 @@ namespace jade
             if (extension == ".lgm")
                 return new likelihood_genotype_matrix_type(path);
 
+            if (extension == ".vcf")
+                return _create_from_vcf(path);
+
             throw error() << "unsupported file extension for G matrix '"
                           << path << "'.";
         }
@@ -80,6 +88,29 @@ namespace jade
             assert(path != nullptr);
             return create(std::string(path));
         }
+
+    private:
+        // --------------------------------------------------------------------
+        static genotype_matrix_type * _create_from_vcf(
+                const std::string & path)
+        {
+            try
+            {
+                std::ifstream in (path);
+                if (!in.good())
+                    throw error("error reading file");
+
+                const vcf_reader_type reader (in);
+                return new likelihood_genotype_matrix_type(
+                    reader.create_lgm());
+            }
+            catch (const std::exception & e)
+            {
+                throw error()
+                    << "error reading vcf data '"
+                    << path << "': " << e.what();
+            }
+        }
     };
 }
 
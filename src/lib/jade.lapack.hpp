@@ -88,6 +88,25 @@ namespace jade
             int          lda)    ///< The stride of the matrix.
             ;
 
+        ///
+        /// Computes all eigenvalues and eigenvectors of a real symmetric
+        /// matrix. On success, the eigenvalues are stored in ascending order,
+        /// and the columns of the matrix are the orthonormal eigenvectors.
+        ///
+        /// Matrices must be in column-major order.
+        ///
+        /// \return Zero if successful; otherwise, non-zero.
+        ///
+        static int syev(
+            layout_type  layout, ///< The matrix layout.
+            char         jobz,   ///< The eigenvectors flag.
+            char         uplo,   ///< The upper-lower flag.
+            int          n,      ///< The order of the matrix.
+            value_type * a,      ///< The matrix data.
+            int          lda,    ///< The stride of the matrix.
+            value_type * w)      ///< The eigenvalues.
+            ;
+
     private:
         // --------------------------------------------------------------------
         class col_storage
@@ -325,6 +344,74 @@ namespace jade
 #endif
     }
 
+    // ------------------------------------------------------------------------
+    template <>
+    inline int basic_lapack<double>::syev(
+        layout_type layout,
+        char        jobz,
+        char        uplo,
+        int         n,
+        double *    a,
+        int         lda,
+        double *    w)
+    {
+        assert(a != nullptr);
+        assert(w != nullptr);
+
+#if defined(JADE_USE_ACCELERATE_FRAMEWORK)
+        const auto storage = init_storage(layout, &a, &lda, n, n);
+        int    info;
+        int    lwork = -1;
+        double query;
+        (void)::dsyev_(&jobz, &uplo, &n, a, &lda, w, &query, &lwork, &info);
+        if (info != 0)
+            return info;
+        lwork = int(query);
+        std::vector<double> work (size_t(lwork));
+        (void)::dsyev_(
+            &jobz, &uplo, &n, a, &lda, w, work.data(), &lwork, &info);
+        return info;
+#elif defined(JADE_USE_NETLIB_PACKAGES)
+        return LAPACKE_dsyev(layout, jobz, uplo, n, a, lda, w);
+#else
+        #error Unsupported build environment
+#endif
+    }
+
+    // ------------------------------------------------------------------------
+    template <>
+    inline int basic_lapack<float>::syev(
+        layout_type layout,
+        char        jobz,
+        char        uplo,
+        int         n,
+        float *     a,
+        int         lda,
+        float *     w)
+    {
+        assert(a != nullptr);
+        assert(w != nullptr);
+
+#if defined(JADE_USE_ACCELERATE_FRAMEWORK)
+        const auto storage = init_storage(layout, &a, &lda, n, n);
+        int    info;
+        int    lwork = -1;
+        float  query;
+        (void)::ssyev_(&jobz, &uplo, &n, a, &lda, w, &query, &lwork, &info);
+        if (info != 0)
+            return info;
+        lwork = int(query);
+        std::vector<float> work (size_t(lwork));
+        (void)::ssyev_(
+            &jobz, &uplo, &n, a, &lda, w, work.data(), &lwork, &info);
+        return info;
+#elif defined(JADE_USE_NETLIB_PACKAGES)
+        return LAPACKE_ssyev(layout, jobz, uplo, n, a, lda, w);
+#else
+        #error Unsupported build environment
+#endif
+    }
+
     #endif // DOXYGEN_IGNORE
 }
 
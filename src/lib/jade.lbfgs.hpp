@@ -0,0 +1,288 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_LBFGS_HPP__
+#define JADE_LBFGS_HPP__
+
+#include "jade.assert.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that implements the limited-memory BFGS
+    /// method, which attempts to minimize a differentiable objective function
+    /// in a many-dimensional space. Each iteration approximates the inverse
+    /// Hessian from the most recent changes in the parameters and gradients
+    /// and then searches along the resulting direction by backtracking until
+    /// the objective function decreases sufficiently.
+    ///
+    /// The objective function or lambda must take two arguments, the
+    /// parameters and a container receiving the gradient, and it must return
+    /// the value of the function at the parameters.
+    ///
+    template <typename TValue>
+    class basic_lbfgs
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The container type.
+        typedef std::vector<value_type> container_type;
+
+        /// The number of corrections stored.
+        static constexpr size_t memory = 8;
+
+        ///
+        /// Initializes a new instance of the class by evaluating the
+        /// objective function at the specified parameters.
+        ///
+        template <typename TObjfunc>
+        basic_lbfgs(
+                const TObjfunc &       objfunc, ///< The objective function.
+                const container_type & params)  ///< The initial parameters.
+            : _x           (params)
+            , _g           (params.size())
+            , _f           (0)
+            , _s           ()
+            , _y           ()
+            , _rho         ()
+            , _alpha       (memory)
+            , _d           (params.size())
+            , _xt          (params.size())
+            , _gt          (params.size())
+            , _evaluations (0)
+            , _iterations  (0)
+        {
+            assert(!params.empty());
+
+            _f = _evaluate(objfunc, _x, _g);
+        }
+
+        ///
+        /// \return The number of evaluations of the objective function.
+        ///
+        inline size_t get_evaluations() const
+        {
+            return _evaluations;
+        }
+
+        ///
+        /// \return The gradient at the current parameters.
+        ///
+        inline const container_type & get_gradient() const
+        {
+            return _g;
+        }
+
+        ///
+        /// \return The Euclidean norm of the gradient at the current
+        /// parameters.
+        ///
+        inline value_type get_gradient_norm() const
+        {
+            return std::sqrt(_dot(_g, _g));
+        }
+
+        ///
+        /// \return The number of iterations that have executed.
+        ///
+        inline size_t get_iterations() const
+        {
+            return _iterations;
+        }
+
+        ///
+        /// \return The value of the objective function at the current
+        /// parameters.
+        ///
+        inline value_type get_objval() const
+        {
+            return _f;
+        }
+
+        ///
+        /// \return The current parameters.
+        ///
+        inline const container_type & get_vertex() const
+        {
+            return _x;
+        }
+
+        ///
+        /// Performs one iteration of the algorithm.
+        ///
+        /// \return True if the iteration decreased the objective function;
+        /// false if no step along the search direction decreased it, in which
+        /// case the parameters are unchanged and the algorithm has converged.
+        ///
+        template <typename TObjfunc>
+        bool iterate(
+                const TObjfunc & objfunc) ///< The objective function.
+        {
+            static const auto c1        = value_type(1.0e-4);
+            static const auto max_steps = size_t(60);
+
+            //
+            // Compute the search direction; if it is not a descent direction,
+            // discard the corrections and follow the negative gradient.
+            //
+            _compute_direction();
+            auto slope = _dot(_g, _d);
+            if (!(slope < value_type(0)))
+            {
+                _s.clear();
+                _y.clear();
+                _rho.clear();
+                _compute_direction();
+                slope = _dot(_g, _d);
+                if (!(slope < value_type(0)))
+                    return false;
+            }
+
+            //
+            // Without corrections, the direction is not scaled, so the first
+            // trial step has unit length; otherwise, the first trial step is
+            // the full quasi-Newton step.
+            //
+            auto step = _s.empty()
+                ? value_type(1) / std::sqrt(_dot(_d, _d))
+                : value_type(1);
+
+            //
+            // Backtrack until the objective function decreases sufficiently.
+            //
+            for (size_t i = 0; i < max_steps; i++, step /= 2)
+            {
+                for (size_t k = 0; k < _x.size(); k++)
+                    _xt[k] = _x[k] + step * _d[k];
+
+                const auto ft = _evaluate(objfunc, _xt, _gt);
+                if (!(ft < _f && ft <= _f + c1 * step * slope))
+                    continue;
+
+                //
+                // Store the correction if it keeps the approximation of the
+                // inverse Hessian positive definite.
+                //
+                container_type s (_x.size()), y (_x.size());
+                for (size_t k = 0; k < _x.size(); k++)
+                {
+                    s[k] = _xt[k] - _x[k];
+                    y[k] = _gt[k] - _g[k];
+                }
+
+                const auto sy = _dot(s, y);
+                if (sy > std::numeric_limits<value_type>::epsilon() *
+                        _dot(y, y))
+                {
+                    if (_s.size() == memory)
+                    {
+                        _s.pop_front();
+                        _y.pop_front();
+                        _rho.pop_front();
+                    }
+
+                    _s.push_back(std::move(s));
+                    _y.push_back(std::move(y));
+                    _rho.push_back(value_type(1) / sy);
+                }
+
+                _x.swap(_xt);
+                _g.swap(_gt);
+                _f = ft;
+                _iterations++;
+                return true;
+            }
+
+            return false;
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        // Computes the search direction, the negation of the approximate
+        // inverse Hessian multiplied by the gradient, using the two-loop
+        // recursion.
+        //
+        void _compute_direction()
+        {
+            const auto m = _s.size();
+
+            for (size_t k = 0; k < _d.size(); k++)
+                _d[k] = -_g[k];
+
+            for (size_t i = m; i-- > 0; )
+            {
+                _alpha[i] = _rho[i] * _dot(_s[i], _d);
+                _axpy(-_alpha[i], _y[i], _d);
+            }
+
+            if (m > 0)
+            {
+                const auto gamma = value_type(1) /
+                    (_rho[m - 1] * _dot(_y[m - 1], _y[m - 1]));
+                for (auto & d : _d)
+                    d *= gamma;
+            }
+
+            for (size_t i = 0; i < m; i++)
+            {
+                const auto beta = _rho[i] * _dot(_y[i], _d);
+                _axpy(_alpha[i] - beta, _s[i], _d);
+            }
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TObjfunc>
+        value_type _evaluate(
+                const TObjfunc &       objfunc,
+                const container_type & params,
+                container_type &       gradient)
+        {
+            _evaluations++;
+            return objfunc(params, gradient);
+        }
+
+        // --------------------------------------------------------------------
+        static void _axpy(
+                const value_type       a,
+                const container_type & x,
+                container_type &       y)
+        {
+            assert(x.size() == y.size());
+            for (size_t k = 0; k < x.size(); k++)
+                y[k] += a * x[k];
+        }
+
+        // --------------------------------------------------------------------
+        static value_type _dot(
+                const container_type & lhs,
+                const container_type & rhs)
+        {
+            assert(lhs.size() == rhs.size());
+            return std::inner_product(
+                lhs.begin(), lhs.end(), rhs.begin(), value_type(0));
+        }
+
+        container_type             _x;           // current parameters
+        container_type             _g;           // current gradient
+        value_type                 _f;           // current objective value
+        std::deque<container_type> _s;           // changes in parameters
+        std::deque<container_type> _y;           // changes in gradients
+        std::deque<value_type>     _rho;         // reciprocals of s'y
+        container_type             _alpha;       // two-loop coefficients
+        container_type             _d;           // search direction
+        container_type             _xt;          // trial parameters
+        container_type             _gt;          // trial gradient
+        size_t                     _evaluations; // objective evaluations
+        size_t                     _iterations;  // iterations executed
+    };
+
+    /// A class that implements the limited-memory BFGS method.
+    typedef basic_lbfgs<double> lbfgs;
+}
+
+#endif // JADE_LBFGS_HPP__
@@ -14,6 +14,24 @@ namespace jade
     ///
     /// A template for a class that implements Lemke's algorithm.
     ///
+    /// The class pivots on a factored form of the tableau, B^-1 * [I, -M,
+    /// -1, q], where B is the basis. The basis is the identity matrix except
+    /// for the columns of the z variables that are basic, so solving with it
+    /// reduces to a dense core: the rows of those columns that are not
+    /// covered by basic w variables. Only the inverse of the core is stored
+    /// and updated, and the tableau columns are computed when they become
+    /// pivot columns, using the nonzero values of M. For quadratic programs
+    /// with simple constraints, such as the bounds and sums of qpas, M is
+    /// mostly zero and the core is much smaller than the tableau, so each
+    /// pivot takes time proportional to the square of the size of the core.
+    /// Instances may be reset and reused for many problems without
+    /// reallocating memory.
+    ///
+    /// The ratio test breaks ties lexicographically, so degenerate problems,
+    /// such as bounds combined with a sum written as a pair of opposite
+    /// inequalities, neither cycle nor depend on rounding errors to choose
+    /// among rows that tie exactly in exact arithmetic.
+    ///
     template <typename TValue>
     class basic_lemke
     {
@@ -74,63 +92,72 @@ namespace jade
         /// The state type.
         typedef typename state::type state_type;
 
+        ///
+        /// Initializes a new instance of the class without a problem; one of
+        /// the reset methods assigns it. Pivots smaller than epsilon abort
+        /// the algorithm; callers whose problems are ill-conditioned enough
+        /// to have legitimately smaller pivots may lower it.
+        ///
+        explicit basic_lemke(
+                const value_type epsilon = value_type(0.000001)) ///< Tolerance.
+            : _core_cols   ()
+            , _core_rows   ()
+            , _col_indices ()
+            , _column      ()
+            , _core_column ()
+            , _d           ()
+            , _epsilon     (epsilon)
+            , _inverse     ()
+            , _labels      ()
+            , _lex_column  ()
+            , _lex_core    ()
+            , _nz_offsets  ()
+            , _nz_rows     ()
+            , _pivot_col   (invalid_index)
+            , _pivot_row   (invalid_index)
+            , _row_indices ()
+            , _state       (state::aborted_initialization)
+            , _ties        ()
+            , _values      ()
+            , _work        ()
+        {
+        }
+
         ///
         /// Initializes a new instance of the class based on the specified
         /// tableau.
         ///
         explicit basic_lemke(
                 const matrix_type & tableau) ///< The tableau.
-            : _labels    ()
-            , _pivot_col (invalid_index)
-            , _pivot_row (invalid_index)
-            , _state     (state::executing)
-            , _tableau   (tableau)
+            : basic_lemke()
         {
-            assert(tableau.get_height() > 0);
-            assert(tableau.get_width() == tableau.get_height() * 2 + 2);
-
-            const auto & t  = _tableau;
-            const auto   n  = t.get_height();
-            const auto   z0 = n + n;
-
-            //
-            // Initially add the labels.
-            //
-            _labels.reserve(n);
-            for (size_t i = 0; i < n; i++)
-                _labels.push_back(i);
-
-            //
-            // The first pivot column is z_0; attempt to find the first pivot
-            // row, but abort if necessary.
-            //
-            _pivot_col = z0;
-            if (!_find_initial_pivot_row())
-                _terminate(state::aborted_initialization);
+            reset(tableau);
         }
 
         ///
         /// Initializes a new instance of the class based on the specified
         /// M and Q matrices.
         ///
-        inline basic_lemke(
+        basic_lemke(
                 const matrix_type & m, ///< The M matrix.
                 const matrix_type & q) ///< The Q matrix.
-            : basic_lemke(_create_tableau(m, q))
+            : basic_lemke()
         {
+            reset(m, q);
         }
 
         ///
         /// Initializes a new instance of the class based on the specified
         /// Q and A matrices and c and b vectors.
         ///
-        inline basic_lemke(
+        basic_lemke(
                 const matrix_type & q, ///< The Q matrix.
                 const matrix_type & a, ///< The A matrix.
                 const matrix_type & c, ///< The c vector.
                 const matrix_type & b) ///< The b vector.
-            : basic_lemke(_create_tableau(q, a, c, b))
+            : basic_lemke()
         {
+            reset(q, a, c, b);
         }
 
         ///
@@ -141,11 +168,10 @@ namespace jade
                 const size_t label) ///< The label to format.
                 const
         {
-            const auto & t  = _tableau;
-            const auto   n  = t.get_height();
-            const auto   z1 = n;
-            const auto   z0 = n + n;
-            const auto   q  = n + n + 1;
+            const auto n  = _values.size();
+            const auto z1 = n;
+            const auto z0 = n + n;
+            const auto q  = n + n + 1;
 
             std::ostringstream out;
             if      (label  < z1) out << "w_" << label + 1;
@@ -169,18 +195,17 @@ namespace jade
         ///
         matrix_type get_output() const
         {
-            const auto & t  = _tableau;
-            const auto   n  = t.get_height();
-            const auto   z1 = n;
-            const auto   q  = n + n + 1;
+            const auto n  = _values.size();
+            const auto z1 = n;
+            const auto z0 = n + n;
 
             matrix_type out (n, 1);
 
             for (size_t i = 0; i < n; i++)
             {
                 const auto label = _labels[i];
-                if (label >= z1)
-                    out[label - z1] = t(i, q);
+                if (label >= z1 && label < z0)
+                    out[label - z1] = _values[i];
             }
 
             return out;
@@ -213,11 +238,31 @@ namespace jade
         }
 
         ///
-        /// \return The tableau.
+        /// \return The tableau, which is computed from its factored form;
+        /// this is intended for testing and debugging.
         ///
-        inline const matrix_type & get_tableau() const
+        matrix_type get_tableau() const
         {
-            return _tableau;
+            const auto n = _values.size();
+            const auto q = n + n + 1;
+
+            std::vector<value_type> column      (n);
+            std::vector<value_type> core_column (n);
+            std::vector<value_type> work        (n);
+
+            matrix_type t (n, q + 1);
+            for (size_t j = 0; j < q; j++)
+            {
+                _compute_column(
+                    j, column.data(), core_column.data(), work.data());
+                for (size_t i = 0; i < n; i++)
+                    t(i, j) = column[i];
+            }
+
+            for (size_t i = 0; i < n; i++)
+                t(i, q) = _values[i];
+
+            return t;
         }
 
         ///
@@ -249,6 +294,103 @@ namespace jade
             return true;
         }
 
+        ///
+        /// Restarts the algorithm for the specified tableau, [I, -M, -1, q].
+        ///
+        void reset(
+                const matrix_type & tableau) ///< The tableau.
+        {
+            assert(tableau.get_height() > 0);
+            assert(tableau.get_width() == tableau.get_height() * 2 + 2);
+
+            const auto n = tableau.get_height();
+            _init_problem(n);
+
+            for (size_t i = 0; i < n; i++)
+            {
+                for (size_t j = 0; j <= n; j++)
+                    _d(i, j) = tableau(i, n + j);
+                _values[i] = tableau(i, n + n + 1);
+            }
+
+            _init();
+        }
+
+        ///
+        /// Restarts the algorithm for the specified M and Q matrices.
+        ///
+        void reset(
+                const matrix_type & m, ///< The M matrix.
+                const matrix_type & q) ///< The Q matrix.
+        {
+            assert(m.is_square());
+            assert(q.is_column_vector());
+            assert(m.get_height() == q.get_height());
+
+            const auto n = q.get_length();
+            _init_problem(n);
+
+            for (size_t i = 0; i < n; i++)
+            {
+                for (size_t j = 0; j < n; j++)
+                    _d(i, j) = -m(i, j);
+                _d(i, n)   = value_type(-1);
+                _values[i] = q[i];
+            }
+
+            _init();
+        }
+
+        ///
+        /// Restarts the algorithm for the specified Q and A matrices and c
+        /// and b vectors, which define M = [Q, -A^T; A, 0] and q = [c; -b].
+        ///
+        void reset(
+                const matrix_type & q, ///< The Q matrix.
+                const matrix_type & a, ///< The A matrix.
+                const matrix_type & c, ///< The c vector.
+                const matrix_type & b) ///< The b vector.
+        {
+            assert(q.get_width() == a.get_width() || a.is_empty());
+            assert(q.is_square());
+            assert(q.get_height() >= 1);
+            assert(c.is_column_vector());
+            assert(b.is_column_vector() || b.is_empty());
+            assert(c.get_height() == q.get_height());
+            assert(b.get_height() == a.get_height());
+
+            const auto qn = q.get_height();
+            const auto ah = a.get_height();
+            const auto n  = qn + ah;
+            _init_problem(n);
+
+            //
+            // Assign -Q and A^T to the top rows, and assign c.
+            //
+            for (size_t i = 0; i < qn; i++)
+            {
+                for (size_t j = 0; j < qn; j++)
+                    _d(i, j) = -q(i, j);
+                for (size_t j = 0; j < ah; j++)
+                    _d(i, qn + j) = a(j, i);
+                _d(i, n)   = value_type(-1);
+                _values[i] = c[i];
+            }
+
+            //
+            // Assign -A to the bottom rows, and assign -b.
+            //
+            for (size_t i = 0; i < ah; i++)
+            {
+                for (size_t j = 0; j < qn; j++)
+                    _d(qn + i, j) = -a(i, j);
+                _d(qn + i, n)   = value_type(-1);
+                _values[qn + i] = -b[i];
+            }
+
+            _init();
+        }
+
         ///
         /// Executes the algorithm until it has completed or has aborted.
         /// \return True if completed; otherwise, false.
@@ -273,11 +415,7 @@ namespace jade
                 const matrix_type & tableau) ///< The tableau.
         {
             basic_lemke lemke (tableau);
-            if (!lemke.solve())
-                return false;
-
-            out = lemke.get_output();
-            return true;
+            return lemke._solve(out);
         }
 
         ///
@@ -287,12 +425,13 @@ namespace jade
         ///
         /// \return True if successful; otherwise, false.
         ///
-        inline static bool solve(
+        static bool solve(
                 matrix_type &       out, ///< The output vector.
                 const matrix_type & m,   ///< The M matrix.
                 const matrix_type & q)   ///< The q vector.
         {
-            return solve(out, _create_tableau(m, q));
+            basic_lemke lemke (m, q);
+            return lemke._solve(out);
         }
 
         ///
@@ -302,14 +441,15 @@ namespace jade
         ///
         /// \return True if successful; otherwise, false.
         ///
-        inline static bool solve(
+        static bool solve(
                 matrix_type &       out, ///< The output vector.
                 const matrix_type & q,   ///< The Q matrix.
                 const matrix_type & a,   ///< The A matrix.
                 const matrix_type & c,   ///< The c vector.
                 const matrix_type & b)   ///< The b vector.
         {
-            return solve(out, _create_tableau(q, a, c, b));
+            basic_lemke lemke (q, a, c, b);
+            return lemke._solve(out);
         }
 
         ///
@@ -317,9 +457,9 @@ namespace jade
         ///
         std::string str() const
         {
-            const auto & t = _tableau;
-            const auto   n = t.get_height();
-            const auto   q = n + n + 1;
+            const auto t = get_tableau();
+            const auto n = t.get_height();
+            const auto q = n + n + 1;
 
             static const size_t cx = 8;
             std::ostringstream out;
@@ -354,158 +494,114 @@ namespace jade
 
     private:
         // --------------------------------------------------------------------
-        static matrix_type _create_m(
-                const matrix_type & q,
-                const matrix_type & a)
-        {
-            assert(q.get_width() == a.get_width() || a.is_empty());
-            assert(q.is_square());
-            assert(q.get_height() >= 1);
-
-            const auto qn = q.get_height();
-            const auto ah = a.get_height();
-            const auto mn = qn + ah;
-
-            matrix_type m (mn, mn);
-
-            //
-            // Assign Q to the top-left quadrant.
-            //
-            for (size_t i = 0; i < qn; i++)
-                for (size_t j = 0; j < qn; j++)
-                    m(i, j) = q(i, j);
-
-            //
-            // Assign A to the bottom-left quadrant.
-            //
-            for (size_t i = 0; i < ah; i++)
-                for (size_t j = 0; j < qn; j++)
-                    m(qn + i, j) = a(i, j);
-
-            //
-            // Assign -A^T to the top-right quadrant.
-            //
-            for (size_t i = 0; i < ah; i++)
-                for (size_t j = 0; j < qn; j++)
-                    m(j, qn + i) = -a(i, j);
-
-            return m;
-        }
-
-        // --------------------------------------------------------------------
-        static matrix_type _create_q(
-                const matrix_type & c,
-                const matrix_type & b)
+        // Computes the tableau column of the specified label, which is B^-1
+        // times the column of [I, -M, -1], for each row of the tableau. The
+        // core values of the column, which are the values of the basic z
+        // variables, are stored in the order of the columns of the core.
+        //
+        void _compute_column(
+                const size_t label,
+                value_type * column,
+                value_type * core_column,
+                value_type * work)
+                const
         {
-            assert(c.is_column_vector());
-            assert(b.is_column_vector() || b.is_empty());
-            assert(c.get_height() >= 1);
-
-            const auto ch = c.get_height();
-            const auto bh = b.get_height();
-
-            matrix_type q (ch + bh, 1);
+            const auto n = _values.size();
+            const auto r = _core_cols.size();
 
             //
-            // Assign C to the top.
-            //
-            for (size_t i = 0; i < ch; i++)
-                q[i] = c[i];
-
+            // Copy the column of [I, -M, -1] for the label.
             //
-            // Assign -B to the bottom.
-            //
-            for (size_t i = 0; i < bh; i++)
-                q[ch + i] = -b[i];
-
-            return q;
-        }
-
-        // --------------------------------------------------------------------
-        static matrix_type _create_tableau(
-                const matrix_type & m,
-                const matrix_type & q)
-        {
-            assert(m.is_square());
-            assert(q.is_column_vector());
-            assert(m.get_height() == q.get_height());
-
-            const auto n = q.get_length();
-            matrix_type t (n, 2 * n + 2);
+            if (label < n)
+            {
+                std::fill(work, work + n, value_type(0));
+                work[label] = value_type(1);
+            }
+            else
+            {
+                const auto j = label - n;
+                for (size_t i = 0; i < n; i++)
+                    work[i] = _d(i, j);
+            }
 
             //
-            // Assign the identity matrix to w_1, w_2, ..., w_n.
+            // Solve for the basic z variables using the inverse of the core.
             //
-            for (size_t i = 0; i < n; i++)
-                t(i, i) = 1;
+            for (size_t a = 0; a < r; a++)
+            {
+                auto sum = value_type(0);
+                for (size_t b = 0; b < r; b++)
+                    sum += _inverse(a, b) * work[_core_rows[b]];
+                core_column[a] = sum;
+            }
 
             //
-            // Assign -M_ij to z_ik where k = n + j.
+            // Subtract the contributions of the basic z variables from the
+            // rows of the basic w variables.
             //
-            for (size_t i = 0; i < n; i++)
-                for (size_t j = 0; j < n; j++)
-                    t(i, n + j) = -m(i, j);
+            for (size_t a = 0; a < r; a++)
+            {
+                const auto y_a = core_column[a];
+                if (!(std::fabs(y_a) > value_type(0)))
+                    continue;
 
-            //
-            // Assign -1 to z_0.
-            //
-            for (size_t i = 0; i < n; i++)
-                t(i, 2 * n) = -1;
+                const auto j = _core_cols[a];
+                for (auto k = _nz_offsets[j]; k < _nz_offsets[j + 1]; k++)
+                {
+                    const auto i = _nz_rows[k];
+                    work[i] -= _d(i, j) * y_a;
+                }
+            }
 
-            //
-            // Assign q.
-            //
             for (size_t i = 0; i < n; i++)
-                t(i, 2 * n + 1) = q[i];
-
-            return t;
-        }
-
-        // --------------------------------------------------------------------
-        inline static matrix_type _create_tableau(
-                const matrix_type & q,
-                const matrix_type & a,
-                const matrix_type & c,
-                const matrix_type & b)
-        {
-            return _create_tableau(_create_m(q, a), _create_q(c, b));
+            {
+                const auto basic = _labels[i];
+                column[i] = basic < n
+                    ? work[basic]
+                    : core_column[_col_indices[basic - n]];
+            }
         }
 
         // --------------------------------------------------------------------
         bool _eliminate()
         {
-            auto &     t = _tableau;
-            const auto w = t.get_width();
-            const auto n = t.get_height();
+            const auto n = _values.size();
 
             //
             // If the pivot is zero, then abort.
             //
-            auto & t_pivot = t(_pivot_row, _pivot_col);
-            if (std::fabs(t_pivot) < _epsilon)
+            const auto pivot = _column[_pivot_row];
+            if (std::fabs(pivot) < _epsilon)
                 return false;
 
             //
-            // Normalize the pivot row.
+            // Update the values of the basic variables.
             //
-            for (size_t j = 0; j < w; j++)
-                if (j != _pivot_col)
-                    t(_pivot_row, j) /= t_pivot;
-            t_pivot = value_type(1);
+            const auto ratio = _values[_pivot_row] / pivot;
+            for (size_t i = 0; i < n; i++)
+                if (i != _pivot_row)
+                    _values[i] -= _column[i] * ratio;
+            _values[_pivot_row] = ratio;
 
             //
-            // Eliminate the non-pivot rows.
+            // Update the inverse of the core for the entering and leaving
+            // variables.
             //
-            for (size_t i = 0; i < n; i++)
+            const auto entering = _pivot_col;
+            const auto leaving  = _labels[_pivot_row];
+            if (entering >= n)
             {
-                if (i == _pivot_row)
-                    continue;
-
-                auto & t_ip = t(i, _pivot_col);
-                for (size_t j = 0; j < w; j++)
-                    if (j != _pivot_col)
-                        t(i, j) -= t_ip * t(_pivot_row, j);
-                t_ip = value_type(0);
+                if (leaving < n)
+                    _grow_core(entering - n, leaving);
+                else
+                    _replace_core_col(entering - n, leaving - n);
+            }
+            else
+            {
+                if (leaving < n)
+                    _replace_core_row(entering, leaving);
+                else
+                    _shrink_core(entering, leaving - n);
             }
 
             return true;
@@ -514,9 +610,7 @@ namespace jade
         // --------------------------------------------------------------------
         bool _find_initial_pivot_row()
         {
-            const auto & t = _tableau;
-            const auto   n = t.get_height();
-            const auto   q = n + n + 1;
+            const auto n = _values.size();
 
             _pivot_row = invalid_index;
 
@@ -530,7 +624,7 @@ namespace jade
                 //
                 // Skip rows with a non-negative q value.
                 //
-                const auto t_iq = t(i, q);
+                const auto t_iq = _values[i];
                 if (t_iq >= 0)
                     continue;
 
@@ -553,30 +647,30 @@ namespace jade
         // --------------------------------------------------------------------
         bool _find_pivot_row()
         {
-            const auto & t = _tableau;
-            const auto   n = t.get_height();
-            const auto   q = n + n + 1;
+            const auto n = _values.size();
+
+            _compute_column(
+                _pivot_col,
+                _column.data(),
+                _core_column.data(),
+                _work.data());
 
             _pivot_row = invalid_index;
 
             auto ratio = value_type(0);
 
             //
-            // Loop over each row.
+            // Find the lowest ratio, skipping rows whose values in the pivot
+            // column are too small to pivot on; those values are often
+            // rounding errors of zeros.
             //
             for (size_t i = 0; i < n; i++)
             {
-                //
-                // Skip rows that are non-positive in the pivot column.
-                //
-                const auto t_ip = t(i, _pivot_col);
-                if (t_ip <= 0)
+                const auto t_ip = _column[i];
+                if (t_ip < _epsilon)
                     continue;
 
-                //
-                // Select the row with the lowest ratio.
-                //
-                const auto r_i = t(i, q) / t_ip;
+                const auto r_i = _values[i] / t_ip;
                 if (_pivot_row == invalid_index || r_i < ratio)
                 {
                     _pivot_row = i;
@@ -584,19 +678,169 @@ namespace jade
                 }
             }
 
+            if (_pivot_row == invalid_index)
+                return false;
+
             //
-            // Return true if the pivot row was found.
+            // Collect the rows that tie with the lowest ratio.
             //
-            return _pivot_row != invalid_index;
+            const auto tolerance = _tie_tolerance *
+                std::max(value_type(1), std::fabs(ratio));
+
+            _ties.clear();
+            for (size_t i = 0; i < n; i++)
+            {
+                const auto t_ip = _column[i];
+                if (t_ip >= _epsilon && _values[i] / t_ip <= ratio + tolerance)
+                    _ties.push_back(i);
+            }
+
+            //
+            // Break the ties with the rows of B^-1 divided by the values in
+            // the pivot column; the columns of B^-1 are the tableau columns
+            // of the w variables. The rows of B^-1 are distinct, so one row
+            // remains.
+            //
+            for (size_t j = 0; _ties.size() > 1 && j < n; j++)
+            {
+                _compute_column(
+                    j,
+                    _lex_column.data(),
+                    _lex_core.data(),
+                    _work.data());
+
+                auto lowest = _lex_column[_ties[0]] / _column[_ties[0]];
+                for (const auto i : _ties)
+                    lowest = std::min(lowest, _lex_column[i] / _column[i]);
+
+                size_t count = 0;
+                for (const auto i : _ties)
+                    if (_lex_column[i] / _column[i] <= lowest + _tie_tolerance)
+                        _ties[count++] = i;
+                _ties.resize(count);
+            }
+
+            _pivot_row = _ties.front();
+            return true;
+        }
+
+        // --------------------------------------------------------------------
+        // Adds a row and a column to the core when z_j enters the basis and
+        // w_i leaves it. With the core K, the new column u, the new row v,
+        // and the new corner d, the inverse of the bordered core follows from
+        // g = K^-1 * u, h = v * K^-1, and the Schur complement d - v * g.
+        //
+        void _grow_core(const size_t j, const size_t i)
+        {
+            const auto r = _core_cols.size();
+            const auto g = _core_column.data();
+            const auto h = _work.data();
+
+            auto s = _d(i, j);
+            for (size_t a = 0; a < r; a++)
+                s -= _d(i, _core_cols[a]) * g[a];
+
+            for (size_t b = 0; b < r; b++)
+            {
+                auto sum = value_type(0);
+                for (size_t a = 0; a < r; a++)
+                    sum += _d(i, _core_cols[a]) * _inverse(a, b);
+                h[b] = sum;
+            }
+
+            for (size_t a = 0; a < r; a++)
+            {
+                const auto g_a = g[a] / s;
+                for (size_t b = 0; b < r; b++)
+                    _inverse(a, b) += g_a * h[b];
+                _inverse(a, r) = -g_a;
+            }
+
+            for (size_t b = 0; b < r; b++)
+                _inverse(r, b) = -h[b] / s;
+            _inverse(r, r) = value_type(1) / s;
+
+            _col_indices[j] = r;
+            _row_indices[i] = r;
+            _core_cols.push_back(j);
+            _core_rows.push_back(i);
+        }
+
+        // --------------------------------------------------------------------
+        // Resizes the buffers for a problem of the specified size; the D
+        // matrix, which is [-M, -1], is assigned zero.
+        //
+        void _init_problem(const size_t n)
+        {
+            assert(n > 0);
+
+            _d.resize(n, n + 1);
+            _d.set_values(value_type(0));
+            _inverse.resize(n, n);
+            _column.resize(n);
+            _core_column.resize(n);
+            _labels.resize(n);
+            _lex_column.resize(n);
+            _lex_core.resize(n);
+            _ties.reserve(n);
+            _values.resize(n);
+            _work.resize(n);
+        }
+
+        // --------------------------------------------------------------------
+        // Initializes the nonzero values of D, the labels, and the empty
+        // core, and finds the first pivot, which is in the z_0 column, or
+        // aborts if none exists.
+        //
+        void _init()
+        {
+            const auto n  = _values.size();
+            const auto z0 = n + n;
+
+            //
+            // Store the row indices of the nonzero values of each column of
+            // D; the values themselves are read from D.
+            //
+            _nz_offsets.resize(n + 2);
+            _nz_rows.clear();
+            for (size_t j = 0; j <= n; j++)
+            {
+                _nz_offsets[j] = _nz_rows.size();
+                for (size_t i = 0; i < n; i++)
+                    if (std::fabs(_d(i, j)) > value_type(0))
+                        _nz_rows.push_back(i);
+            }
+            _nz_offsets[n + 1] = _nz_rows.size();
+
+            for (size_t i = 0; i < n; i++)
+                _labels[i] = i;
+
+            _core_cols.clear();
+            _core_rows.clear();
+            _col_indices.assign(n + 1, size_t(invalid_index));
+            _row_indices.assign(n, size_t(invalid_index));
+
+            _state     = state::executing;
+            _pivot_col = z0;
+            if (!_find_initial_pivot_row())
+            {
+                _terminate(state::aborted_initialization);
+                return;
+            }
+
+            _compute_column(
+                _pivot_col,
+                _column.data(),
+                _core_column.data(),
+                _work.data());
         }
 
         // --------------------------------------------------------------------
         bool _relabel()
         {
-            const auto & t  = _tableau;
-            const auto   n  = t.get_height();
-            const auto   z1 = n;
-            const auto   z0 = n + n;
+            const auto n  = _values.size();
+            const auto z1 = n;
+            const auto z0 = n + n;
 
             //
             // Keep track of the label being replaced.
@@ -625,6 +869,141 @@ namespace jade
             return true;
         }
 
+        // --------------------------------------------------------------------
+        // Replaces the column of z_k in the core with the column of z_j,
+        // where g = K^-1 * u for the new column u; this is a product-form
+        // update of the inverse.
+        //
+        void _replace_core_col(const size_t j, const size_t k)
+        {
+            const auto r  = _core_cols.size();
+            const auto ci = _col_indices[k];
+            const auto g  = _core_column.data();
+
+            assert(ci < r);
+
+            const auto g_ci = g[ci];
+            for (size_t b = 0; b < r; b++)
+                _inverse(ci, b) /= g_ci;
+
+            for (size_t a = 0; a < r; a++)
+            {
+                const auto g_a = g[a];
+                if (a == ci || !(std::fabs(g_a) > value_type(0)))
+                    continue;
+
+                for (size_t b = 0; b < r; b++)
+                    _inverse(a, b) -= g_a * _inverse(ci, b);
+            }
+
+            _col_indices[k] = invalid_index;
+            _col_indices[j] = ci;
+            _core_cols[ci]  = j;
+        }
+
+        // --------------------------------------------------------------------
+        // Replaces the row i of the core with the row k when w_i enters the
+        // basis and w_k leaves it. The tableau column of w_i holds g = K^-1 *
+        // e, where e selects the row of i in the core, so the Sherman-Morrison
+        // update only requires h = delta * K^-1, where delta is the change of
+        // the row.
+        //
+        void _replace_core_row(const size_t i, const size_t k)
+        {
+            const auto r  = _core_cols.size();
+            const auto ri = _row_indices[i];
+            const auto g  = _core_column.data();
+            const auto h  = _work.data();
+
+            assert(ri < r);
+
+            for (size_t b = 0; b < r; b++)
+            {
+                auto sum = value_type(0);
+                for (size_t a = 0; a < r; a++)
+                {
+                    const auto j = _core_cols[a];
+                    sum += (_d(k, j) - _d(i, j)) * _inverse(a, b);
+                }
+                h[b] = sum;
+            }
+
+            const auto denominator = value_type(1) + h[ri];
+            for (size_t a = 0; a < r; a++)
+            {
+                const auto g_a = g[a] / denominator;
+                for (size_t b = 0; b < r; b++)
+                    _inverse(a, b) -= g_a * h[b];
+            }
+
+            _row_indices[i] = invalid_index;
+            _row_indices[k] = ri;
+            _core_rows[ri]  = k;
+        }
+
+        // --------------------------------------------------------------------
+        // Removes the row i and the column of z_j from the core when w_i
+        // enters the basis and z_j leaves it. The inverse of the smaller core
+        // is the Schur complement of the corresponding value of the inverse;
+        // the last row and column of the core fill the removed ones.
+        //
+        void _shrink_core(const size_t i, const size_t j)
+        {
+            const auto r    = _core_cols.size();
+            const auto ri   = _row_indices[i];
+            const auto ci   = _col_indices[j];
+            const auto last = r - 1;
+
+            assert(ri < r && ci < r);
+
+            const auto pivot = _inverse(ci, ri);
+            for (size_t a = 0; a < r; a++)
+            {
+                if (a == ci)
+                    continue;
+
+                const auto e_a = _inverse(a, ri) / pivot;
+                if (!(std::fabs(e_a) > value_type(0)))
+                    continue;
+
+                for (size_t b = 0; b < r; b++)
+                    if (b != ri)
+                        _inverse(a, b) -= e_a * _inverse(ci, b);
+            }
+
+            _row_indices[i] = invalid_index;
+            _col_indices[j] = invalid_index;
+
+            if (ci != last)
+            {
+                for (size_t b = 0; b < r; b++)
+                    _inverse(ci, b) = _inverse(last, b);
+                _core_cols[ci] = _core_cols[last];
+                _col_indices[_core_cols[ci]] = ci;
+            }
+
+            if (ri != last)
+            {
+                for (size_t a = 0; a < r; a++)
+                    _inverse(a, ri) = _inverse(a, last);
+                _core_rows[ri] = _core_rows[last];
+                _row_indices[_core_rows[ri]] = ri;
+            }
+
+            _core_cols.pop_back();
+            _core_rows.pop_back();
+        }
+
+        // --------------------------------------------------------------------
+        bool _solve(matrix_type & out)
+        {
+            if (!solve())
+                return false;
+
+            out = get_output();
+            return true;
+        }
+
         // --------------------------------------------------------------------
         bool _terminate(const state_type new_state)
         {
@@ -634,13 +1013,29 @@ namespace jade
             return false;
         }
 
-        static constexpr auto _epsilon = value_type(0.000001);
-
-        labels_type _labels;
-        size_t      _pivot_col;
-        size_t      _pivot_row;
-        state_type  _state;
-        matrix_type _tableau;
+        // The tolerance within which ratios tie, relative to the lowest one.
+        static constexpr auto _tie_tolerance = value_type(1.0e-7);
+
+        labels_type             _core_cols;   // D columns of the core
+        labels_type             _core_rows;   // D rows of the core
+        labels_type             _col_indices; // core index of each D column
+        std::vector<value_type> _column;      // tableau pivot column
+        std::vector<value_type> _core_column; // core values of _column
+        matrix_type             _d;           // [-M, -1]
+        value_type              _epsilon;     // smallest pivot magnitude
+        matrix_type             _inverse;     // inverse of the core
+        labels_type             _labels;      // basic variable of each row
+        std::vector<value_type> _lex_column;  // tableau column of a tie
+        std::vector<value_type> _lex_core;    // core values of _lex_column
+        labels_type             _nz_offsets;  // first nonzero of D columns
+        labels_type             _nz_rows;     // rows of the D nonzeros
+        size_t                  _pivot_col;
+        size_t                  _pivot_row;
+        labels_type             _row_indices; // core index of each D row
+        state_type              _state;
+        labels_type             _ties;        // rows tying in the ratio test
+        std::vector<value_type> _values;      // values of basic variables
+        std::vector<value_type> _work;        // scratch space
     };
 }
 
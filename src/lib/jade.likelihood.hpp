@@ -18,6 +18,14 @@ namespace jade
     /// [K-1 x J] rooted F matrix for major allele frequencies and a [J x 1] mu
     /// vector.
     ///
+    /// The log-likelihood depends on the data only through the number of
+    /// markers, the sum of RK * log(2*pi * mux[j]), and the [K-1 x K-1]
+    /// matrix S, the sum of rf[j] * rf[j]' / mux[j], where rf[j] is a column
+    /// of the rooted F matrix and mux[j] is mu[j] * (1 - mu[j]); columns with
+    /// non-positive mux[j] are excluded. Since sum(rf[j]' * C^-1 * rf[j] /
+    /// mux[j]) is equal to trace(C^-1 * S), each evaluation takes time
+    /// independent of the number of markers.
+    ///
     template <typename TValue>
     class basic_likelihood
     {
@@ -36,153 +44,211 @@ namespace jade
         basic_likelihood(
                 const matrix_type & rf, ///< The rooted F matrix.
                 const matrix_type & mu) ///< The mu vector.
-            : _rf      (rf)
-            , _mux     (_init_mux(mu))
-            , _rkltmux (_init_rkltmux(rf.get_height(), _mux))
-            , _mul     (rf.get_height(), rf.get_width())
+            : _j        (rf.get_width())
+            , _s        (rf.get_height(), rf.get_height())
+            , _constant (0)
         {
             assert(mu.get_height() == rf.get_width());
+            _init_statistics(rf, mu, 0, rf.get_width());
+        }
+
+        ///
+        /// Initializes the class based on the markers in the range [first,
+        /// last) of a rooted F matrix and a mu vector. Instances for disjoint
+        /// ranges may be combined with the add method.
+        ///
+        basic_likelihood(
+                const matrix_type & rf,    ///< The rooted F matrix.
+                const matrix_type & mu,    ///< The mu vector.
+                const size_t        first, ///< The first marker.
+                const size_t        last)  ///< The end of the markers.
+            : _j        (last - first)
+            , _s        (rf.get_height(), rf.get_height())
+            , _constant (0)
+        {
+            assert(mu.get_height() == rf.get_width());
+            assert(first <= last && last <= rf.get_width());
+            _init_statistics(rf, mu, first, last);
+        }
+
+        ///
+        /// Initializes the class for no markers.
+        ///
+        explicit basic_likelihood(
+                const size_t rk) ///< The rooted K value.
+            : _j        (0)
+            , _s        (rk, rk)
+            , _constant (0)
+        {
+        }
+
+        ///
+        /// Adds the markers of another instance to this instance the
+        /// specified number of times, e.g. to combine blocks of markers drawn
+        /// with replacement. This takes time independent of the number of
+        /// markers.
+        ///
+        void add(
+                const basic_likelihood & other, ///< The other instance.
+                const size_t             count) ///< The number of copies.
+        {
+            assert(other._s.is_size(_s.get_height(), _s.get_width()));
+
+            const auto n = value_type(count);
+            _j        += other._j * count;
+            _constant += other._constant * n;
+
+            const auto src = other._s.get_data();
+            const auto dst = _s.get_data();
+            for (size_t i = 0; i < _s.get_length(); i++)
+                dst[i] += src[i] * n;
+        }
+
+        ///
+        /// \return The number of markers.
+        ///
+        inline size_t get_j() const
+        {
+            return _j;
+        }
+
+        ///
+        /// \return The rooted K value.
+        ///
+        inline size_t get_rk() const
+        {
+            return _s.get_height();
         }
 
         ///
         /// \return The log-likelihood using values cached during the
-        /// initializaiton of this instance and the supplied arguments.
+        /// initialization of this instance and the supplied arguments.
         ///
         value_type operator () (
                 const matrix_type & c_inv,     ///< The inverted C matrix.
                 const value_type    log_c_det) ///< The log of det(C).
+                const
         {
-            const auto RK = _rf.get_height();
-            const auto J  = _rf.get_width();
+            assert(c_inv.is_size(_s.get_height(), _s.get_width()));
 
-            assert(c_inv.is_size(RK, RK));
+            //
+            // Both matrices are symmetric, so trace(C^-1 * S) is the sum of
+            // the products of their corresponding cells.
+            //
+            const auto trace = std::inner_product(
+                c_inv.get_data(),
+                c_inv.get_data() + c_inv.get_length(),
+                _s.get_data(),
+                value_type(0));
 
             //
-            // Use LAPACK to multiply c_inv and _rf; store the result in the
-            // pre-allocated _mul matrix, which is of size [RK x J].
+            // The log-likelihood: -0.5 * (J * log(det(C)) + sum), where sum
+            // is the cached constant plus trace(C^-1 * S).
             //
-            matrix_type::gemm(c_inv, _rf, _mul);
+            return value_type(-0.5) *
+                ((value_type(_j) * log_c_det) + _constant + trace);
+        }
+
+        ///
+        /// Computes the log-likelihood, as the function operator does, and
+        /// its gradient with respect to the covariance matrix C, which is
+        /// -0.5 * (J * C^-1 - C^-1 * S * C^-1).
+        ///
+        /// \return The log-likelihood.
+        ///
+        value_type compute_gradient(
+                const matrix_type & c_inv,     ///< The inverted C matrix.
+                const value_type    log_c_det, ///< The log of det(C).
+                matrix_type &       gradient)  ///< The [RK x RK] gradient.
+                const
+        {
+            const auto RK = _s.get_height();
 
-            auto sum = value_type(0);
+            assert(gradient.is_size(RK, RK));
 
             //
-            // Loop over the J columns of _mul.
+            // Compute C^-1 * S, and then multiply it by C^-1.
             //
-            auto       rkltmux_ptr = _rkltmux.get_data();
-            auto       mux_ptr     = _mux.get_data();
-            const auto mux_end     = _mux.get_data() + J;
-            auto       rf_ptr      = _rf.get_data();
-            auto       mul_ptr     = _mul.get_data();
-            while (mux_ptr != mux_end)
+            matrix_type product (RK, RK);
+            matrix_type::gemm(c_inv, _s, product);
+
+            for (size_t row = 0; row < RK; row++)
             {
-                //
-                // Do not process columns with non-positive mux[j].
-                //
-                const auto rkltmux = *rkltmux_ptr++;
-                const auto mux     = *mux_ptr++;
-                if (mux <= value_type(0))
-                    continue;
+                for (size_t col = 0; col <= row; col++)
+                {
+                    auto sum = value_type(0);
+                    for (size_t i = 0; i < RK; i++)
+                        sum += product(row, i) * c_inv(i, col);
 
-                auto zip = value_type(0);
+                    const auto value = value_type(-0.5) *
+                        (value_type(_j) * c_inv(row, col) - sum);
 
-                //
-                // Loop over the RK rows of _mul and _rf and sum the products of
-                // rf[rk, j] * mul[rk, j].
-                //
-                const auto rf_anchor  = rf_ptr;
-                const auto mul_anchor = mul_ptr;
-                const auto mul_end    = mul_ptr + (RK * J);
-                while (mul_ptr != mul_end)
-                {
-                    zip     += *rf_ptr * *mul_ptr;
-                    rf_ptr  += J;
-                    mul_ptr += J;
+                    gradient(row, col) = value;
+                    gradient(col, row) = value;
                 }
-
-                //
-                // For this column of J, add
-                // RK*log(2*pi * mux[j]) + (zip / mux[j]).
-                //
-                sum += rkltmux + (zip / mux);
-
-                //
-                // Advance to the next columns.
-                //
-                rf_ptr  = rf_anchor + 1;
-                mul_ptr = mul_anchor + 1;
             }
 
-            //
-            // The log-likelihood: -0.5 * (J * log(det(C)) + sum).
-            //
-            return value_type(-0.5) * ((value_type(J) * log_c_det) + sum);
+            return (*this)(c_inv, log_c_det);
         }
 
     private:
         // --------------------------------------------------------------------
-        static matrix_type _init_mux(const matrix_type & mu)
+        // Computes S and the sum of RK * log(2*pi * mux[j]) over the columns
+        // in the range [first, last) with positive mux[j].
+        //
+        void _init_statistics(
+                const matrix_type & rf,
+                const matrix_type & mu,
+                const size_t        first,
+                const size_t        last)
         {
+            static const auto tau = value_type(2.0 * std::acos(-1.0));
+
             assert(mu.is_column_vector());
 
-            //
-            // Declare a vector of the same size.
-            //
-            const auto J = mu.get_height();
-            matrix_type mux (J, 1);
+            const auto RK = rf.get_height();
+            const auto J  = rf.get_width();
 
             //
-            // Loop over all values in the mu vector.
+            // Cache the weights 1 / mux[j], or zero for the columns that do
+            // not contribute to the likelihood.
             //
-            const auto mu_end  = mu.get_data() + J;
-            auto       mu_ptr  = mu.get_data();
-            auto       mux_ptr = mux.get_data();
-            while (mu_ptr != mu_end)
+            std::vector<value_type> weights (J, value_type(0));
+            for (size_t j = first; j < last; j++)
             {
-                //
-                // Cache the value for mu[j] * (1.0 - mu[j]).
-                //
-                const auto mu_j = *mu_ptr++;
-                *mux_ptr++ = mu_j * (value_type(1) - mu_j);
-            }
-
-            return mux;
-        }
-
-        // --------------------------------------------------------------------
-        static matrix_type _init_rkltmux(
-                const size_t        RK,
-                const matrix_type & mux)
-        {
-            static const auto tau = value_type(2.0 * std::acos(-1.0));
-
-            assert(mux.is_column_vector());
+                const auto mu_j = mu[j];
+                const auto mux  = mu_j * (value_type(1) - mu_j);
+                if (mux <= value_type(0))
+                    continue;
 
-            //
-            // Declare a vector of the same size.
-            //
-            const auto J = mux.get_height();
-            matrix_type rkltmux (J, 1);
+                weights[j] = value_type(1) / mux;
+                _constant += value_type(RK) * std::log(tau * mux);
+            }
 
             //
-            // Loop over all values in the mux vector.
+            // Each cell of the lower triangle of S is the weighted dot
+            // product of two rows of the rooted F matrix.
             //
-            const auto mux_end     = mux.get_data() + J;
-            auto       mux_ptr     = mux.get_data();
-            auto       rkltmux_ptr = rkltmux.get_data();
+            for (size_t row = 0; row < RK; row++)
+            {
+                const auto row_ptr = rf.get_data() + row * J;
+                for (size_t col = 0; col <= row; col++)
+                {
+                    const auto col_ptr = rf.get_data() + col * J;
 
-            //
-            // Cache the values for RK * log(2*pi * mux[j]).
-            //
-            while (mux_ptr != mux_end)
-                *rkltmux_ptr++ = value_type(RK) * std::log(tau * *mux_ptr++);
+                    auto sum = value_type(0);
+                    for (size_t j = first; j < last; j++)
+                        sum += row_ptr[j] * col_ptr[j] * weights[j];
 
-            return rkltmux;
+                    _s(row, col) = sum;
+                    _s(col, row) = sum;
+                }
+            }
         }
 
-        const matrix_type & _rf;      // rooted F matrix
-        const matrix_type   _mux;     // cache of mu[j] * (1-mu[j])
-        const matrix_type   _rkltmux; // cached of (K-1) * log(2*pi * mu[j]).
-        matrix_type         _mul;     // placeholder for matrix multiplication.
+        size_t      _j;        // number of markers
+        matrix_type _s;        // sum of rf[j] * rf[j]' / mux[j]
+        value_type  _constant; // sum of RK * log(2*pi * mux[j])
     };
 }
 
@@ -42,10 +42,12 @@ namespace jade
         ///
         explicit basic_likelihood_genotype_matrix(
                 std::istream & in) ///< The input stream.
-            : _g_aa (in)
-            , _g_Aa (in)
-            , _g_AA (in)
+            : basic_likelihood_genotype_matrix()
         {
+            text_reader reader (in);
+            _g_aa.read(reader);
+            _g_Aa.read(reader);
+            _g_AA.read(reader);
             _validate_sizes();
         }
 
@@ -10,6 +10,8 @@
 #include "jade.blas.hpp"
 #include "jade.error.hpp"
 #include "jade.lapack.hpp"
+#include "jade.text_reader.hpp"
+#include "jade.text_writer.hpp"
 
 namespace jade
 {
@@ -1095,9 +1097,21 @@ namespace jade
         ///
         void read(
                 std::istream & in) ///< The input stream.
+        {
+            text_reader reader (in);
+            read(reader);
+        }
+
+        ///
+        /// Reads the matrix values from the specified text reader.
+        ///
+        /// \throw An exception if there is an error reading the text.
+        ///
+        void read(
+                text_reader & in) ///< The text reader.
         {
             size_t cx, cy;
-            if (!(in >> cy >> cx))
+            if (!in.read(cy) || !in.read(cx))
                 throw error()
                     << "failed to parse matrix size";
 
@@ -1106,22 +1120,13 @@ namespace jade
                     << "invalid matrix size ["
                     << cy << "x" << cx << "]";
 
-            vector_type m;
-            m.reserve(cx * cy);
-
-            for (size_t y = 0; y < cy; y++)
-            {
-                for (size_t x = 0; x < cx; x++)
-                {
-                    value_type value;
-                    if (!(in >> value))
-                        throw error()
-                            << "failed to parse matrix value at cell ["
-                            << y+1 << "," << x+1 << "]";
+            vector_type m (cx * cy);
 
-                    m.push_back(value);
-                }
-            }
+            const auto n = in.read_table(m.data(), cy, cx);
+            if (n != m.size())
+                throw error()
+                    << "failed to parse matrix value at cell ["
+                    << n / cx + 1 << "," << n % cx + 1 << "]";
 
             _cx = cx;
             _cy = cy;
@@ -1214,6 +1219,34 @@ namespace jade
             _m.swap(other._m);
         }
 
+        ///
+        /// Computes the eigenvalues and eigenvectors of this symmetric matrix.
+        /// Only the lower-left triangle is used to perform the calculation. If
+        /// this method succeeds, the columns of this matrix are replaced with
+        /// the orthonormal eigenvectors, and the specified column vector is
+        /// assigned the corresponding eigenvalues in ascending order.
+        ///
+        /// \return True if the method is successful.
+        ///
+        bool syev_lower(
+                basic_matrix & eigenvalues) ///< The eigenvalues.
+        {
+            assert(is_square());
+            assert(!is_empty());
+
+            const auto n = int(get_width());
+            eigenvalues.resize(get_width(), 1);
+
+            return 0 == lapack_type::syev(
+                lapack_type::row_major, // layout
+                'V',                    // jobz
+                'L',                    // uplo
+                n,                      // n
+                get_data(),             // a
+                n,                      // lda
+                eigenvalues.get_data()); // w
+        }
+
         ///
         /// Transposes this matrix.
         ///
@@ -1278,6 +1311,29 @@ namespace jade
             }
         }
 
+        ///
+        /// Writes this matrix to the specified output stream. Unlike the
+        /// formatted output of write, floating-point values are written with
+        /// the fewest digits that read back to exactly the same value, and
+        /// large matrices are formatted on multiple threads. The formatting
+        /// flags of the stream are ignored.
+        ///
+        void write_exact(
+                std::ostream & out) ///< The output stream.
+                const
+        {
+            text_writer writer (out);
+            writer.write(_cy);
+            writer.put(' ');
+            writer.write(_cx);
+            writer.put('\n');
+
+            if (_cx == 0)
+                return;
+
+            writer.write_table(_m.data(), _cy, _cx);
+        }
+
         ///
         /// \return The element at the specified index.
         ///
@@ -13,6 +13,10 @@ namespace jade
 {
     ///
     /// A template for a class that implements the neighbor joining algorithm.
+    /// The distances are reduced in place in a packed lower triangle, the
+    /// row sums are updated incrementally after each join, and the minimum
+    /// Q value is found concurrently for large matrices; each join takes
+    /// O(n^2) time without allocating memory.
     ///
     template <typename TValue>
     class basic_neighbor_joining
@@ -24,6 +28,9 @@ namespace jade
         /// The matrix type.
         typedef basic_matrix<value_type> matrix_type;
 
+        /// The minimum number of nodes for finding Q values concurrently.
+        static constexpr size_t min_parallel_size = 256;
+
         ///
         /// Initializes a new instance of the class.
         ///
@@ -46,7 +53,7 @@ namespace jade
             // method will consist on only the node name ("0").
             //
             assert(distances.is_square());
-            auto n = distances.get_height();
+            const auto n = distances.get_height();
             id_type next_id = 0;
             if (n == 1)
             {
@@ -55,72 +62,145 @@ namespace jade
             }
 
             //
-            // Prepare a list of ids for the initial set of nodes.
+            // Prepare a list of ids for the initial set of nodes; the list
+            // holds the id of the node stored in each row of the distances.
+            // The ranks order the nodes as if each parent were inserted
+            // before all other nodes, which determines how ties are broken
+            // and how the tree is written; leaves are ranked by their ids,
+            // after all parents, and each parent is ranked before the last.
             //
-            typedef std::vector<id_type> vector_type;
-            vector_type x;
+            std::vector<id_type> x;
+            std::vector<size_t>  ranks;
             for (size_t i = 0; i < n; i++)
+            {
                 x.push_back(_add_leaf(next_id));
+                ranks.push_back(n + i);
+            }
 
             //
-            // Prepare the distance matrix that will be reduced by the
-            // algorithm.
+            // Copy the lower triangle, excluding the diagonal, of the
+            // distance matrix, and cache the sums of its rows.
             //
-            matrix_type d (distances);
+            std::vector<value_type> d;
+            d.reserve((n * (n - 1)) / 2);
+            std::vector<value_type> sigma (n, value_type(0));
+            for (size_t r = 1; r < n; r++)
+            {
+                for (size_t c = 0; c < r; c++)
+                {
+                    const auto d_rc = distances(r, c);
+                    d.push_back(d_rc);
+                    sigma[r] += d_rc;
+                    sigma[c] += d_rc;
+                }
+            }
 
             //
             // Loop until there are only two nodes remaining in the distance
             // matrix.
             //
-            while (n > 2)
+            for (auto m = n; m > 2; m--)
             {
                 //
                 // Find the minimum Q value in the matrix, and use it to find
                 // the two nodes that will be joined. Join them by creating a
                 // new parent node.
                 //
-                const q_data  q  (d);
+                const auto q     = _find_minimum_q(d, sigma, ranks, m);
+                const auto k_n_2 = value_type(m - 2);
+                const auto d_ij  = d[_index(q.i, q.j)];
+                const auto d_ik  = value_type(0.5) *
+                    (d_ij + ((sigma[q.i] - sigma[q.j]) / k_n_2));
+                const auto d_jk  = d_ij - d_ik;
+
                 const id_type id (next_id++);
-                _add_parent(id, x[q.i], q.d_ik);
-                _add_parent(id, x[q.j], q.d_jk);
+                _add_parent(id, x[q.i], d_ik);
+                _add_parent(id, x[q.j], d_jk);
 
                 //
-                // Prepare the new, reduced distance matrix as well as the
-                // corresponding id vector.
+                // Store the new node in the lower of the two rows, and
+                // update the row sums of the other nodes.
                 //
-                matrix_type dd (n - 1, n - 1);
-                vector_type xx { id };
-                for (size_t r = 0, rr = 1; r < n; r++)
+                const auto a = std::min(q.i, q.j);
+                const auto b = std::max(q.i, q.j);
+
+                auto sigma_k = value_type(0);
+                for (size_t r = 0; r < m; r++)
                 {
-                    if (r == q.i || r == q.j)
+                    if (r == a || r == b)
                         continue;
-                    xx.push_back(x[r]);
-                    dd(rr, 0) = value_type(0.5) *
-                        (d(r, q.i) + d(r, q.j) - q.d_ij);
-                    for (size_t c = 0, cc = 1; c < r; c++)
-                        if (c != q.i && c != q.j)
-                            dd(rr, cc++) = d(r, c);
-                    rr++;
+
+                    auto &     d_ra = d[_index(r, a)];
+                    const auto d_rb = d[_index(r, b)];
+                    const auto d_rk = value_type(0.5) * (d_ra + d_rb - d_ij);
+
+                    sigma[r] += d_rk - d_ra - d_rb;
+                    sigma_k  += d_rk;
+                    d_ra      = d_rk;
                 }
 
+                x[a]     = id;
+                ranks[a] = 2 * n - 1 - id;
+                sigma[a] = sigma_k;
+
                 //
-                // Copy the lower triangle to the upper triangle so the data
-                // in the next Q matrix matches the expected values.
+                // Move the node in the last row into the other row, so the
+                // remaining nodes occupy the first m - 1 rows.
                 //
-                dd.copy_lower_to_upper();
+                const auto last = m - 1;
+                if (b != last)
+                {
+                    for (size_t r = 0; r < last; r++)
+                        if (r != b)
+                            d[_index(b, r)] = d[_index(last, r)];
 
-                d.swap(dd);
-                x.swap(xx);
-                n--;
+                    x[b]     = x[last];
+                    ranks[b] = ranks[last];
+                    sigma[b] = sigma[last];
+                }
             }
 
             //
-            // Connect the last two nodes; note the loop above places new nodes
-            // at index zero, so here it is known that the leaf node must be at
-            // index 1, and so the root note must be at index 0.
+            // Connect the last two nodes; the node ordered first, which is
+            // the last parent created, becomes the root.
             //
-            _root = x[0];
-            _add_parent(_root, x[1], d(1, 0));
+            const size_t first = ranks[0] < ranks[1] ? 0 : 1;
+            _root = x[first];
+            _add_parent(_root, x[1 - first], d[0]);
+        }
+
+        ///
+        /// Creates a distance matrix for the K components of a [K-1 x K-1]
+        /// covariance matrix rooted at component zero; the distance between
+        /// components i and j is C(i,i) + C(j,j) - 2 * C(i,j), where the row
+        /// and column of the root are zero.
+        ///
+        /// \return The [K x K] distance matrix.
+        ///
+        static matrix_type create_distances(
+                const matrix_type & c) ///< The covariance matrix.
+        {
+            const auto rk = c.get_height();
+            const auto k  = rk + 1;
+
+            matrix_type padded_c (k, k);
+            for (size_t i = 0; i < rk; i++)
+                for (size_t j = 0; j < rk; j++)
+                    padded_c(i + 1, j + 1) = c(i, j);
+
+            matrix_type distances (k, k);
+            for (size_t i = 0; i < k; i++)
+            {
+                const auto c_ii = padded_c(i, i);
+                for (size_t j = 0; j < k; j++)
+                {
+                    const auto c_jj = padded_c(j, j);
+                    const auto c_ij = padded_c(i, j);
+                    distances(i, j) = c_ii + c_jj - c_ij - c_ij;
+                }
+            }
+
+            return distances;
         }
 
         ///
@@ -203,60 +283,130 @@ namespace jade
         }
 
         // --------------------------------------------------------------------
+        // The pair of rows with the minimum Q value; i is the row of the node
+        // ranked after the node in row j.
+        //
         struct q_data
         {
-            value_type d_ij;
-            value_type d_ik;
-            value_type d_jk;
+            value_type q;
             size_t     i;
             size_t     j;
+        };
+
+        // --------------------------------------------------------------------
+        // Returns the pair of the first m rows with the minimum Q value. Ties
+        // are broken in favor of the pair whose later node, and then earlier
+        // node, is ranked first.
+        //
+        static q_data _find_minimum_q(
+                const std::vector<value_type> & d,
+                const std::vector<value_type> & sigma,
+                const std::vector<size_t> &     ranks,
+                const size_t                    m)
+        {
+            static const auto inf = std::numeric_limits<value_type>::max();
 
-            // ----------------------------------------------------------------
-            explicit q_data(const matrix_type & d)
-                : d_ij ()
-                , d_ik ()
-                , d_jk ()
-                , i    ()
-                , j    ()
+            //
+            // With three nodes, every Q value is the negation of the sum of
+            // the distances, so join the two nodes ranked first rather than
+            // the pair favored by rounding errors.
+            //
+            if (m == 3)
             {
-                static const auto k_0_5 = value_type(0.5);
+                std::array<size_t, 3> rows { { 0, 1, 2 } };
+                std::sort(rows.begin(), rows.end(), [&](
+                        const size_t lhs,
+                        const size_t rhs) -> bool
+                {
+                    return ranks[lhs] < ranks[rhs];
+                });
 
-                const auto n     = d.get_height();
-                const auto k_n_2 = value_type(n - 2);
+                return q_data { value_type(0), rows[1], rows[0] };
+            }
 
-                //
-                // Cache the row sums; column sums would work equally well
-                // because the matrix is symmetric.
-                //
-                std::vector<value_type> sigma;
-                for (size_t c = 0; c < n; c++)
-                    sigma.push_back(d.get_row_sum(c));
+            const auto k_n_2 = value_type(m - 2);
 
+            const auto is_better = [&](
+                    const q_data & lhs,
+                    const q_data & rhs) -> bool
+            {
+                if (rhs.i == invalid_id || lhs.q < rhs.q)
+                    return true;
+                if (rhs.q < lhs.q)
+                    return false;
+                if (lhs.i != rhs.i)
+                    return ranks[lhs.i] < ranks[rhs.i];
+                return ranks[lhs.j] < ranks[rhs.j];
+            };
+
+            const auto scan_row = [&](const size_t r, q_data & best) -> void
+            {
                 //
-                // Compute the values of the Q matrix.
+                // Keep the minimum in a local variable so the loop does not
+                // reload it; values equal to the minimum are rare and are
+                // compared by rank.
                 //
-                matrix_type q (n, n);
-                for (size_t r = 0; r < n; r++)
-                    for (size_t c = 0; c < r; c++)
-                        q(r, c) = k_n_2 * d(r, c) - sigma[r] - sigma[c];
+                const auto row     = d.data() + _index(r, 0);
+                const auto sigma_r = sigma[r];
+                auto       min_q   = best.q;
+                for (size_t c = 0; c < r; c++)
+                {
+                    const auto q = k_n_2 * row[c] - sigma_r - sigma[c];
+                    if (min_q < q)
+                        continue;
 
-                //
-                // Find the cell with the minimum value.
-                //
-                i = 1, j = 0;
-                for (size_t r = 2; r < n; r++)
-                    for (size_t c = 0; c < r; c++)
-                        if (q(r, c) < q(i, j))
-                            i = r, j = c;
+                    const auto is_r_later = ranks[c] < ranks[r];
+                    const q_data candidate {
+                        q, is_r_later ? r : c, is_r_later ? c : r };
+                    if (is_better(candidate, best))
+                    {
+                        best  = candidate;
+                        min_q = q;
+                    }
+                }
+            };
 
-                //
-                // Compute distances between the new nodes.
-                //
-                d_ij = d(i, j);
-                d_ik = k_0_5 * (d_ij + ((sigma[i] - sigma[j]) / k_n_2));
-                d_jk = d_ij - d_ik;
-            }
-        };
+            //
+            // Each thread finds the minimum of the rows it scans; the rows
+            // are scanned from longest to shortest to balance the work.
+            //
+            const auto threads = m < min_parallel_size
+                ? size_t(1)
+                : parallel::get_thread_count();
+            std::vector<q_data> bests (
+                threads,
+                q_data { inf, size_t(invalid_id), 0 });
+
+            if (threads == 1)
+                for (size_t r = 1; r < m; r++)
+                    scan_row(r, bests[0]);
+            else
+                parallel::for_each(m - 1, [&](
+                        const size_t index,
+                        const size_t thread) -> void
+                {
+                    scan_row(m - 1 - index, bests[thread]);
+                });
+
+            auto best = bests.front();
+            for (const auto & candidate : bests)
+                if (candidate.i != invalid_id && is_better(candidate, best))
+                    best = candidate;
+
+            assert(best.i != invalid_id);
+            return best;
+        }
+
+        // --------------------------------------------------------------------
+        // Returns the index of a cell in the packed lower triangle.
+        //
+        static inline size_t _index(const size_t r, const size_t c)
+        {
+            assert(r != c);
+            return r > c
+                ? ((r * (r - 1)) / 2) + c
+                : ((c * (c - 1)) / 2) + r;
+        }
 
         std::map<id_type, std::vector<id_type>> _children;
         std::map<id_type, value_type>           _lengths;
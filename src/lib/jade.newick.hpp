@@ -12,7 +12,11 @@
 namespace jade
 {
     ///
-    /// A template class representing a node from a Newick tree.
+    /// A template class representing a node from a Newick tree. The node
+    /// constructed by the user is the root of the tree, and it owns an arena
+    /// that stores the remaining nodes contiguously, so parsing a tree
+    /// allocates the nodes once. The parser and the methods that traverse
+    /// the tree are iterative, so deep trees do not overflow the stack.
     ///
     template <typename TValue>
     class basic_newick_node
@@ -33,14 +37,6 @@ namespace jade
         /// The scanner type.
         typedef basic_scanner<char> scanner_type;
 
-        ///
-        /// Reclaims resources used by this instance and its children.
-        ///
-        inline ~basic_newick_node()
-        {
-            _destruct();
-        }
-
         ///
         /// Initializes a new instance of the class. Initially, the instance
         /// has no name, no length, no parent, and no children.
@@ -52,6 +48,7 @@ namespace jade
             , _length     (0)
             , _name       ()
             , _parent     ()
+            , _arena      ()
         {
         }
 
@@ -167,18 +164,11 @@ namespace jade
         /// well.
         ///
         template <typename TPredicate>
-        const_pointer_type find_first(
+        inline const_pointer_type find_first(
                 const TPredicate predicate) ///< The predicate to match.
                 const
         {
-            for (auto child : _children)
-            {
-                const auto first = child->find_first(predicate);
-                if (nullptr != first)
-                    return first;
-            }
-
-            return predicate(this) ? this : nullptr;
+            return _find_first(this, predicate);
         }
 
         ///
@@ -187,26 +177,23 @@ namespace jade
         /// well.
         ///
         template <typename TPredicate>
-        pointer_type find_first(
+        inline pointer_type find_first(
                 const TPredicate predicate) ///< The predicate to match.
         {
-            for (auto child : _children)
-            {
-                const pointer_type first = child->find_first(predicate);
-                if (nullptr != first)
-                    return first;
-            }
-
-            return predicate(this) ? this : nullptr;
+            return _find_first(this, predicate);
         }
 
         ///
-        /// \return The node with the specified id.
+        /// \return The node with the specified id. If this node is the root
+        /// of a tree, the method takes constant time.
         ///
         const_pointer_type find_id(
                 const int id) ///< The id of the node to find.
                 const
         {
+            if (_arena && id > 0 && size_t(id) <= _arena->index.size())
+                return _arena->index[size_t(id) - 1];
+
             return find_first([id](const_pointer_type node) -> bool
             {
                 return node->_id == id;
@@ -214,11 +201,15 @@ namespace jade
         }
 
         ///
-        /// \return The node with the specified id.
+        /// \return The node with the specified id. If this node is the root
+        /// of a tree, the method takes constant time.
         ///
         pointer_type find_id(
                 const int id) ///< The id of the node to find.
         {
+            if (_arena && id > 0 && size_t(id) <= _arena->index.size())
+                return _arena->index[size_t(id) - 1];
+
             return find_first([id](pointer_type node) -> bool
             {
                 return node->_id == id;
@@ -279,7 +270,10 @@ namespace jade
         ///
         const_pointer_type find_root() const
         {
-            return is_root() ? this : _parent->find_root();
+            auto node = this;
+            while (!node->is_root())
+                node = node->_parent;
+            return node;
         }
 
         ///
@@ -287,7 +281,10 @@ namespace jade
         ///
         pointer_type find_root()
         {
-            return is_root() ? this : _parent->find_root();
+            auto node = this;
+            while (!node->is_root())
+                node = node->_parent;
+            return node;
         }
 
         ///
@@ -299,10 +296,11 @@ namespace jade
                 const TAction action) ///< The action to perform.
                 const
         {
-            for (auto child : _children)
-                child->for_each(action);
-
-            action(this);
+            _find_first(this, [&action](const_pointer_type node) -> bool
+            {
+                action(node);
+                return false;
+            });
         }
 
         ///
@@ -313,10 +311,11 @@ namespace jade
         void for_each(
                 const TAction action) ///< The action to perform.
         {
-            for (auto child : _children)
-                child->for_each(action);
-
-            action(this);
+            _find_first(this, [&action](pointer_type node) -> bool
+            {
+                action(node);
+                return false;
+            });
         }
 
         ///
@@ -433,21 +432,128 @@ namespace jade
         pointer_type reroot() const
         {
             //
-            // Reroot the structure of the tree.
+            // Copy the tree into a new arena, and then reroot the copy at the
+            // copy of this node.
+            //
+            const auto old_root = find_root();
+
+            size_t size = 0;
+            old_root->for_each([&size](const_pointer_type) -> void
+            {
+                size++;
+            });
+
+            std::unique_ptr<basic_newick_node> root (new basic_newick_node());
+            root->_arena.reset(new _arena_type(size));
+            root->_copy_fields(*old_root);
+
+            auto next = root->_arena->nodes.get();
+            auto self = root.get();
+
+            typedef std::pair<const_pointer_type, pointer_type> pair_type;
+            std::vector<pair_type> stack { pair_type(old_root, root.get()) };
+            while (!stack.empty())
+            {
+                const auto source = stack.back().first;
+                const auto target = stack.back().second;
+                stack.pop_back();
+
+                if (source == this)
+                    self = target;
+
+                target->_children.reserve(source->_children.size());
+                for (const auto source_child : source->_children)
+                {
+                    const auto target_child = next++;
+                    target_child->_copy_fields(*source_child);
+                    target_child->_parent = target;
+                    target->_children.push_back(target_child);
+                    stack.emplace_back(source_child, target_child);
+                }
+            }
+
+            root->_index_arena();
+            root->reroot(self);
+            return root.release();
+        }
+
+        ///
+        /// Reroots the tree in place at the specified node, which must belong
+        /// to the tree of this node, and this node must be the root. The
+        /// links along the path between the nodes are reversed, so the method
+        /// takes time proportional to the depth of the specified node. This
+        /// node remains the root by exchanging its contents, i.e. its id,
+        /// name, length, and children, with the specified node; afterward,
+        /// the specified node holds the contents of the old root. As with
+        /// the other reroot method, the new root receives the length of the
+        /// old root, and each node along the path receives the length of its
+        /// former child.
+        ///
+        void reroot(
+                const pointer_type node) ///< The node to become the root.
+        {
+            assert(node != nullptr);
+            assert(is_root());
+            assert(node->find_root() == this);
+
+            if (node == this)
+                return;
+
+            //
+            // Reverse the links along the path from the node to the root,
+            // shifting the lengths toward the old root.
             //
-            auto root = _clone();
-            _copy_children(this, root, nullptr);
-            _copy_parents(this, root);
+            auto child      = node;
+            auto parent     = node->_parent;
+            auto has_length = node->_has_length;
+            auto length     = node->_length;
+            while (child != this)
+            {
+                const auto grandparent = parent->_parent;
+
+                auto & siblings = parent->_children;
+                siblings.erase(std::find(
+                    siblings.begin(), siblings.end(), child));
+                child->_children.push_back(parent);
+
+                std::swap(has_length, parent->_has_length);
+                std::swap(length,     parent->_length);
+
+                parent->_parent = child;
+                child  = parent;
+                parent = grandparent;
+            }
+
+            node->_parent     = nullptr;
+            node->_has_length = has_length;
+            node->_length     = length;
 
             //
-            // To preserve information, assign the length
-            // to the old root to this new root.
+            // Exchange the contents of this node and the new root so this
+            // node remains the root, and then update the links to both.
             //
-            auto old_root = find_root();
-            root->_length = old_root->_length;
-            root->_has_length = old_root->_has_length;
+            std::swap(_children,   node->_children);
+            std::swap(_has_length, node->_has_length);
+            std::swap(_id,         node->_id);
+            std::swap(_length,     node->_length);
+            std::swap(_name,       node->_name);
+
+            node->_parent = _parent == node ? this : _parent;
+            _parent       = nullptr;
+
+            auto & siblings = node->_parent->_children;
+            *std::find(siblings.begin(), siblings.end(), this) = node;
 
-            return root;
+            for (const auto c : _children)
+                c->_parent = this;
+            for (const auto c : node->_children)
+                c->_parent = node;
+
+            if (_arena)
+            {
+                _set_index(this);
+                _set_index(node);
+            }
         }
 
         ///
@@ -526,181 +632,218 @@ namespace jade
         basic_newick_node & operator = (const basic_newick_node &) = delete;
 
         // --------------------------------------------------------------------
-        pointer_type _clone() const
+        // The storage for the nodes of a tree other than its root, and the
+        // nodes of the tree indexed by id.
+        //
+        struct _arena_type
         {
-            auto node = new basic_newick_node();
-            node->_has_length = _has_length;
-            node->_id         = _id;
-            node->_length     = _length;
-            node->_name       = _name;
-            return node;
-        }
+            std::unique_ptr<basic_newick_node[]> nodes;
+            std::vector<pointer_type>            index;
 
-        // --------------------------------------------------------------------
-        static void _copy_children(
-                const_pointer_type source,
-                pointer_type       target,
-                const_pointer_type excluded)
-        {
-            //
-            // Loop over the children from the source node.
-            //
-            for (auto source_child : source->_children)
+            explicit _arena_type(const size_t size)
+                : nodes (new basic_newick_node[size == 0 ? 0 : size - 1])
+                , index ()
             {
-                //
-                // Skip the excluded child, if necessary.
-                //
-                if (source_child == excluded)
-                    continue;
+            }
+        };
 
-                //
-                // Clone the source child and insert it into the target children.
-                //
-                auto target_child = source_child->_clone();
-                target->_children.push_back(target_child);
-                target_child->_parent = target;
+        // --------------------------------------------------------------------
+        // A node read by the parser before the arena is allocated.
+        //
+        struct _record_type
+        {
+            size_t      parent;     // The index of the parent.
+            std::string name;       // The name.
+            value_type  length;     // The length.
+            bool        has_length; // A flag for a defined length.
 
-                //
-                // Recursively copy children.
-                //
-                _copy_children(source_child, target_child, nullptr);
+            explicit _record_type(const size_t p)
+                : parent (p), name (), length (0), has_length (false)
+            {
             }
-        }
+        };
 
         // --------------------------------------------------------------------
-        static void _copy_parents(
-                const_pointer_type source,
-                pointer_type       target)
+        void _copy_fields(const basic_newick_node & other)
         {
-            //
-            // Do nothing if the source is the root.
-            //
-            const auto source_parent = source->_parent;
-            if (source_parent == nullptr)
-                return;
+            _has_length = other._has_length;
+            _id         = other._id;
+            _length     = other._length;
+            _name       = other._name;
+        }
 
-            //
-            // Clone the source parent and assign it as a child of the target.
-            //
-            auto target_child = source_parent->_clone();
-            target->_children.push_back(target_child);
-            target_child->_parent = target;
+        // --------------------------------------------------------------------
+        // Returns the first node that matches the predicate in depth-first
+        // order, visiting the children of each node before the node itself.
+        //
+        template <typename TNode, typename TPredicate>
+        static TNode * _find_first(
+                TNode * const      root,
+                const TPredicate & predicate)
+        {
+            typedef std::pair<TNode *, size_t> pair_type;
+            std::vector<pair_type> stack { pair_type(root, 0) };
+
+            while (!stack.empty())
+            {
+                const auto node = stack.back().first;
+                auto &     next = stack.back().second;
 
-            //
-            // Recursively process the children and parents.
-            //
-            _copy_children(source_parent, target_child, source);
-            _copy_parents(source_parent, target_child);
+                if (next < node->_children.size())
+                {
+                    const auto child = node->_children[next++];
+                    stack.emplace_back(child, size_t(0));
+                    continue;
+                }
 
-            //
-            // Reverse the direction of the length for the new child.
-            //
-            target_child->_length = source->_length;
-            target_child->_has_length = source->_has_length;
+                stack.pop_back();
+                if (predicate(node))
+                    return node;
+            }
+
+            return nullptr;
         }
 
         // --------------------------------------------------------------------
-        inline void _destruct()
+        // Indexes the nodes of the tree of this root by id.
+        //
+        void _index_arena()
         {
-            for (auto child : _children)
-                delete child;
-            _children.clear();
+            auto & index = _arena->index;
+            for_each([&index](const pointer_type node) -> void
+            {
+                if (node->_id <= 0)
+                    return;
+                const auto i = size_t(node->_id) - 1;
+                if (i >= index.size())
+                    index.resize(i + 1, nullptr);
+                index[i] = node;
+            });
         }
 
         // --------------------------------------------------------------------
         void _read(scanner_type & in)
         {
+            static const size_t none = std::numeric_limits<size_t>::max();
+
             //
-            // This method executes from the constructor and also throws
-            // exceptions, so take care to reclaim resources (the children) in
-            // case an exception occurs.
+            // Read the nodes iteratively in depth-first order, assigning ids
+            // in the order the nodes are encountered; the stack holds the
+            // nodes with open parentheses.
             //
-            try
+            std::vector<_record_type> records;
+            std::vector<size_t>       stack;
+
+            records.emplace_back(none);
+            for (auto current = size_t(0); ; )
             {
-                //
-                // Recursively create all nodes in the tree.
-                //
-                auto node_count = 0;
-                _read(in, node_count);
+                while (in.try_char('('))
+                {
+                    stack.push_back(current);
+                    current = records.size();
+                    records.emplace_back(stack.back());
+                }
 
-                //
-                // Require the last non-whitespace character, the semicolon.
-                //
-                in.expect(';');
+                _read_label(in, records[current]);
 
                 //
-                // Ensure no more non-whitespace characters are in the stream.
+                // Close parentheses until encountering the next sibling, if
+                // any; children are separated by commas.
                 //
-                in.skip_whitespace();
-                if (in.is_end_of_data())
-                    return;
+                while (!stack.empty() && !in.try_char(','))
+                {
+                    in.expect(')');
+                    current = stack.back();
+                    stack.pop_back();
+                    _read_label(in, records[current]);
+                }
 
-                throw jade::error()
-                    << "expected end of stream but encountered "
-                    << " '" << in.read_token() << "'";
-            }
-            catch (...)
-            {
-                //
-                // Reclaim resources before rethrowing the exception.
-                //
-                _destruct();
-                throw;
+                if (stack.empty())
+                    break;
+
+                current = records.size();
+                records.emplace_back(stack.back());
             }
-        }
 
-        // --------------------------------------------------------------------
-        void _read(scanner_type & in, int & node_count)
-        {
-            static const char delims[] = ";:(),";
+            //
+            // Require the last non-whitespace character, the semicolon.
+            //
+            in.expect(';');
 
             //
-            // Create a new id for each node created.
+            // Ensure no more non-whitespace characters are in the stream.
             //
-            _id = ++node_count;
+            in.skip_whitespace();
+            if (!in.is_end_of_data())
+                throw jade::error()
+                    << "expected end of stream but encountered "
+                    << " '" << in.read_token() << "'";
 
             //
-            // Determine if this node has children.
+            // Allocate the nodes once; this node is the root, and the arena
+            // stores the other nodes in the order of their ids.
             //
-            if (in.try_char('('))
+            const auto size = records.size();
+            _arena.reset(new _arena_type(size));
+
+            auto & index = _arena->index;
+            index.reserve(size);
+            index.push_back(this);
+            for (size_t i = 1; i < size; i++)
+                index.push_back(&_arena->nodes[i - 1]);
+
+            std::vector<size_t> degrees (size, 0);
+            for (size_t i = 1; i < size; i++)
+                degrees[records[i].parent]++;
+
+            for (size_t i = 0; i < size; i++)
             {
-                //
-                // Loop over all children, which are separated by colons.
-                //
-                do
+                auto & record = records[i];
+                const auto node = index[i];
+
+                node->_children.reserve(degrees[i]);
+                node->_has_length = record.has_length;
+                node->_id         = int(i + 1);
+                node->_length     = record.length;
+                node->_name       = std::move(record.name);
+
+                if (record.parent != none)
                 {
-                    //
-                    // Create the child, storing it into the collection of
-                    // children, and updating the child to reference the parent.
-                    //
-                    auto child = new basic_newick_node();
-                    child->_parent = this;
-                    _children.push_back(child);
-                    child->_read(in, node_count);
+                    node->_parent = index[record.parent];
+                    node->_parent->_children.push_back(node);
                 }
-                while (in.try_char(','));
-
-                //
-                // Require a closing parenthesis after the last child.
-                //
-                in.expect(')');
             }
+        }
+
+        // --------------------------------------------------------------------
+        // Reads the name and the length, if any, of a node.
+        //
+        static void _read_label(scanner_type & in, _record_type & record)
+        {
+            static const char delims[] = ";:(),";
 
             //
             // Parse the name, if any.
             //
-            _name = _trim(in.read_token(delims));
+            record.name = _trim(in.read_token(delims));
 
             //
             // If the stream provides a colon, parse the length.
             //
             if (in.try_char(':'))
             {
-                _length     = in.read_real<value_type>();
-                _has_length = true;
+                record.length     = in.read_real<value_type>();
+                record.has_length = true;
             }
         }
 
+        // --------------------------------------------------------------------
+        void _set_index(const pointer_type node)
+        {
+            if (node->_id > 0 && size_t(node->_id) <= _arena->index.size())
+                _arena->index[size_t(node->_id) - 1] = node;
+        }
+
         // --------------------------------------------------------------------
         static std::string _trim(const std::string & s)
         {
@@ -716,46 +859,47 @@ namespace jade
         // --------------------------------------------------------------------
         void _write(std::ostream & out) const
         {
-            const auto end = _children.end();
-
             //
-            // Loop over each child, if any.
+            // Write the nodes iteratively; the stack holds each node being
+            // written and the index of its next child.
             //
-            auto iter = _children.begin();
-            if (iter != end)
+            typedef std::pair<const_pointer_type, size_t> pair_type;
+            std::vector<pair_type> stack { pair_type(this, 0) };
+
+            while (!stack.empty())
             {
-                //
-                // Enclose all children in parentheses.
-                //
-                out << '(';
-                (*iter)->_write(out);
+                const auto node = stack.back().first;
+                auto &     next = stack.back().second;
 
                 //
-                // Separate children with commas.
+                // Enclose all children in parentheses, and separate them with
+                // commas.
                 //
-                while (++iter != end)
+                if (next < node->_children.size())
                 {
-                    out << ',';
-                    (*iter)->_write(out);
+                    out << (next == 0 ? '(' : ',');
+                    const auto child = node->_children[next++];
+                    stack.emplace_back(child, size_t(0));
+                    continue;
                 }
 
+                if (!node->_children.empty())
+                    out << ')';
+
                 //
-                // Close the parentheses for the children.
+                // Write the name, if one exists.
                 //
-                out << ')';
-            }
+                if (node->has_name())
+                    out << node->_name;
 
-            //
-            // Write the name, if one exists.
-            //
-            if (has_name())
-                out << _name;
+                //
+                // Write the length, if one exists.
+                //
+                if (node->_has_length)
+                    out << ':' << node->_length;
 
-            //
-            // Write the length, if one exists.
-            //
-            if (_has_length)
-                out << ':' << _length;
+                stack.pop_back();
+            }
         }
 
         children_type _children;   ///< A container for children.
@@ -764,6 +908,8 @@ namespace jade
         value_type    _length;     ///< A possible length.
         std::string   _name;       ///< A name.
         pointer_type  _parent;     ///< A parent node.
+
+        std::unique_ptr<_arena_type> _arena; ///< The nodes, for a root.
     };
 }
 
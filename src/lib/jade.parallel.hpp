@@ -0,0 +1,135 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_PARALLEL_HPP__
+#define JADE_PARALLEL_HPP__
+
+#include "jade.assert.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that distributes independent units of work
+    /// across a number of threads.
+    ///
+    template <typename TThread>
+    class basic_parallel
+    {
+    public:
+        /// The thread type.
+        typedef TThread thread_type;
+
+        ///
+        /// \return The number of threads used to process work. Unless it is
+        /// assigned explicitly, this is the number of hardware threads.
+        ///
+        inline static size_t get_thread_count()
+        {
+            return _thread_count();
+        }
+
+        ///
+        /// Assigns the number of threads used to process work.
+        ///
+        inline static void set_thread_count(
+                const size_t value) ///< The number of threads.
+        {
+            assert(value > 0);
+            _thread_count() = value;
+        }
+
+        ///
+        /// Invokes the specified function once for each index in the range
+        /// [0, count). The function receives the index and the number of the
+        /// thread, in the range [0, get_thread_count()), that processes it;
+        /// callers may use the thread number to select scratch space that is
+        /// not shared between threads. Indices are handed out in increasing
+        /// order, but they may complete in any order. If any invocation throws
+        /// an exception, no further indices are started, and the first
+        /// exception is rethrown after all threads finish.
+        ///
+        template <typename TFunction>
+        static void for_each(
+                const size_t      count,    ///< The number of indices.
+                const TFunction & function) ///< The function to invoke.
+        {
+            const auto n = std::min(count, get_thread_count());
+
+            if (n <= 1)
+            {
+                for (size_t index = 0; index < count; index++)
+                    function(index, size_t(0));
+                return;
+            }
+
+            std::atomic<size_t> next      (0);
+            std::atomic<bool>   failed    (false);
+            std::exception_ptr  exception (nullptr);
+
+            const auto worker = [&](const size_t thread)
+            {
+                try
+                {
+                    while (!failed)
+                    {
+                        const auto index = next++;
+                        if (index >= count)
+                            break;
+
+                        function(index, thread);
+                    }
+                }
+                catch (...)
+                {
+                    if (!failed.exchange(true))
+                        exception = std::current_exception();
+                }
+            };
+
+            std::vector<thread_type> threads;
+            threads.reserve(n - 1);
+            for (size_t thread = 1; thread < n; thread++)
+            {
+                //
+                // If the system refuses to create more threads, the threads
+                // that already exist process the remaining work.
+                //
+                try
+                {
+                    threads.push_back(thread_type(worker, thread));
+                }
+                catch (const std::exception &)
+                {
+                    break;
+                }
+            }
+
+            worker(0);
+
+            for (auto & thread : threads)
+                thread.join();
+
+            if (exception != nullptr)
+                std::rethrow_exception(exception);
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        static size_t & _thread_count()
+        {
+            static size_t value = std::max(
+                size_t(1),
+                size_t(thread_type::hardware_concurrency()));
+
+            return value;
+        }
+    };
+
+    /// A class that distributes independent units of work across threads.
+    typedef basic_parallel<std::thread> parallel;
+}
+
+#endif // JADE_PARALLEL_HPP__
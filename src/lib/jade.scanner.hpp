@@ -177,32 +177,45 @@ namespace jade
             //
             skip_whitespace();
 
-            ostringstream_type out;
+            string_type length_str;
 
             //
             // Check for negative values.
             //
             if (try_char(hyphen))
-                out << hyphen;
+                length_str.push_back(hyphen);
 
             //
             // Read values before the decimal place.
             //
-            read_digits(out);
+            _read_digits(length_str);
 
             //
             // Check for a decimal, possibly reading additional digits.
             //
             if (try_char(period))
             {
-                out << period;
-                read_digits(out);
+                length_str.push_back(period);
+                _read_digits(length_str);
+            }
+
+            //
+            // Check for an exponent, possibly with a sign, as written for
+            // small and large values.
+            //
+            const auto ch = _in.peek();
+            if (!length_str.empty() && (ch == 'e' || ch == 'E'))
+            {
+                length_str.push_back(char_type(_in.get()));
+                const auto sign = _in.peek();
+                if (sign == '-' || sign == '+')
+                    length_str.push_back(char_type(_in.get()));
+                _read_digits(length_str);
             }
 
             //
             // If no symbols exist in the output buffer, this is invalid.
             //
-            const auto length_str = out.str();
             if (length_str.empty())
                 throw error(
                     "expected a floating-point value but "
@@ -212,9 +225,8 @@ namespace jade
             // Parse and return the digits as a floating-point value, throwing
             // an exception in the case of an error.
             //
-            istringstream_type length_in (length_str);
             TValue length;
-            if (length_in >> length)
+            if (_parse_real(length_str, length))
                 return length;
             throw error()
                 << "expected a length but encountered '"
@@ -245,7 +257,7 @@ namespace jade
             const auto delims = delimeters == nullptr ? fallback : delimeters;
             const auto length = char_traits_type::length(delims);
 
-            ostringstream_type out;
+            string_type out;
 
             for (;;)
             {
@@ -253,9 +265,9 @@ namespace jade
 
                 if (ch < 0 || nullptr != char_traits_type::find(
                     delims, length, char_type(ch)))
-                    return out.str();
+                    return out;
 
-                out << char_type(_in.get());
+                out.push_back(char_type(_in.get()));
             }
         }
 
@@ -304,6 +316,40 @@ namespace jade
         basic_scanner(const basic_scanner &) = delete;
         basic_scanner & operator = (const basic_scanner &) = delete;
 
+        // --------------------------------------------------------------------
+        // Parses a value validated by read_real; the C library converts the
+        // common cases without constructing a string stream.
+        //
+        static bool _parse_real(const std::string & str, double & value)
+        {
+            char * end;
+            value = std::strtod(str.c_str(), &end);
+            return *end == '\0';
+        }
+
+        // --------------------------------------------------------------------
+        static bool _parse_real(const std::string & str, float & value)
+        {
+            char * end;
+            value = std::strtof(str.c_str(), &end);
+            return *end == '\0';
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        static bool _parse_real(const string_type & str, TValue & value)
+        {
+            istringstream_type in (str);
+            return bool(in >> value);
+        }
+
+        // --------------------------------------------------------------------
+        void _read_digits(string_type & out)
+        {
+            while (::isdigit(_in.peek()))
+                out.push_back(char_type(_in.get()));
+        }
+
         std::unique_ptr<istream_type> _ptr;
         istream_type &                _in;
     };
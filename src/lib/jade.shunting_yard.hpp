@@ -7,7 +7,7 @@
 #ifndef JADE_SHUNTING_YARD_HPP__
 #define JADE_SHUNTING_YARD_HPP__
 
-#include "jade.error.hpp"
+#include "jade.expression_program.hpp"
 
 namespace jade
 {
@@ -32,6 +32,9 @@ namespace jade
         ///
         typedef std::map<std::string, float_type> args_type;
 
+        /// The compiled expression program type.
+        typedef basic_expression_program<float_type> program_type;
+
         ///
         /// Initializes a new instance of the class. The specified input stream
         /// provides tokens for the expression.
@@ -76,6 +79,56 @@ namespace jade
             return _args;
         }
 
+        ///
+        /// Compiles the expression and appends its instructions to the
+        /// specified program. Each variable is resolved to its index in the
+        /// specified list of names, and the output of the expression is
+        /// stored at the specified index.
+        /// \param names   The names of the arguments.
+        /// \param index   The output index.
+        /// \param program The program receiving the instructions.
+        ///
+        void compile(
+                const std::vector<std::string> & names,
+                const size_t                     index,
+                program_type &                   program)
+                const
+        {
+            for (const auto & t : _queue)
+            {
+                if (t.type == _token::number)
+                {
+                    program.push_number(t.get_value());
+                }
+                else if (t.type == _token::variable)
+                {
+                    const auto item = std::find(
+                        names.begin(), names.end(), t.text);
+
+                    if (item == names.end())
+                        throw jade::error()
+                            << "undefined variable '"
+                            << t.text
+                            << "'";
+
+                    program.push_variable(
+                        size_t(std::distance(names.begin(), item)));
+                }
+                else if (t.type == _token::plus)
+                    program.apply(program_type::plus);
+                else if (t.type == _token::minus)
+                    program.apply(program_type::minus);
+                else if (t.type == _token::star)
+                    program.apply(program_type::star);
+                else if (t.type == _token::slash)
+                    program.apply(program_type::slash);
+                else
+                    throw jade::error("invalid operator");
+            }
+
+            program.store_output(index);
+        }
+
         ///
         /// Evaluates the expression using values from the specified table.
         /// \param args The table of variable values.
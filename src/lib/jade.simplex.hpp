@@ -7,7 +7,7 @@
 #ifndef JADE_SIMPLEX_HPP__
 #define JADE_SIMPLEX_HPP__
 
-#include "jade.assert.hpp"
+#include "jade.parallel.hpp"
 
 namespace jade
 {
@@ -335,17 +335,39 @@ namespace jade
             ///
             value_type unit;
 
+            ///
+            /// True to evaluate the objective function for several vertices
+            /// concurrently; i.e. the initial vertices, the shrunken vertices,
+            /// and, in speculative mode, the trial vertices. The objective
+            /// function must then be safe to call from multiple threads; if it
+            /// accepts a second argument, it receives the number of the thread
+            /// calling it, which it may use to select scratch space.
+            ///
+            bool parallel;
+
+            ///
+            /// True to compute and evaluate the reflection, expansion, and
+            /// both contraction vertices together at the start of every
+            /// iteration, rather than evaluating each only when it is needed.
+            /// The simplex takes the same steps either way, but speculative
+            /// mode performs more evaluations, so it applies only if the
+            /// parallel option is also true.
+            ///
+            bool speculative;
+
             ///
             /// Initializes a new instance of the class.
             ///
             explicit options(
                     const size_t n) ///< The container size.
-                : vertex ()
-                , chi    (_init_chi(n))
-                , gamma  (_init_gamma(n))
-                , rho    (1)
-                , sigma  (_init_sigma(n))
-                , unit   (1)
+                : vertex      ()
+                , chi         (_init_chi(n))
+                , gamma       (_init_gamma(n))
+                , rho         (1)
+                , sigma       (_init_sigma(n))
+                , unit        (1)
+                , parallel    (false)
+                , speculative (false)
             {
                 assert(n > 0);
                 vertex.resize(n);
@@ -356,12 +378,14 @@ namespace jade
             ///
             explicit options(
                     const container_type & vertex_) ///< The container size.
-                : vertex (vertex_)
-                , chi    (_init_chi(vertex.size()))
-                , gamma  (_init_gamma(vertex.size()))
-                , rho    (1)
-                , sigma  (_init_sigma(vertex.size()))
-                , unit   (1)
+                : vertex      (vertex_)
+                , chi         (_init_chi(vertex.size()))
+                , gamma       (_init_gamma(vertex.size()))
+                , rho         (1)
+                , sigma       (_init_sigma(vertex.size()))
+                , unit        (1)
+                , parallel    (false)
+                , speculative (false)
             {
                 assert(vertex.size() > 0);
             }
@@ -384,11 +408,13 @@ namespace jade
                 out << "}" << std::endl;
 
                 out
-                    << "chi:              " << chi    << std::endl
-                    << "gamma:            " << gamma  << std::endl
-                    << "rho:              " << rho    << std::endl
-                    << "sigma:            " << sigma  << std::endl
-                    << "unit:             " << unit   << std::endl;
+                    << "chi:              " << chi         << std::endl
+                    << "gamma:            " << gamma       << std::endl
+                    << "rho:              " << rho         << std::endl
+                    << "sigma:            " << sigma       << std::endl
+                    << "unit:             " << unit        << std::endl
+                    << "parallel:         " << parallel    << std::endl
+                    << "speculative:      " << speculative << std::endl;
 
                 return out.str();
             }
@@ -539,8 +565,11 @@ namespace jade
             //
             // Initially evaluate the objective function for the simplex.
             //
-            for (const auto & xi : _x)
-                xi->objval = _evaluate(objfunc, xi->params);
+            _evaluate_each(_n + 1, [&](const size_t i, const size_t thread)
+            {
+                auto & xi = _x[i];
+                xi->objval = _invoke(objfunc, xi->params, thread, 0);
+            });
 
             //
             // Initially sort the vertices.
@@ -777,7 +806,42 @@ namespace jade
             _scale(_xr, _opts.rho);
             _add(_xr, _xr, _xbar);
 
-            const auto fr = _evaluate(objfunc, _xr);
+            //
+            // In speculative mode, compute the expansion and both contraction
+            // vertices now, and evaluate them together with the reflection
+            // vertex; the decisions below remain the same, but they use the
+            // values computed here rather than evaluating the vertices as
+            // they are needed.
+            //
+            const auto speculative = _opts.speculative && _opts.parallel;
+
+            value_type trials[4];
+            if (speculative)
+            {
+                _init_expansion();
+                _init_contraction_out();
+                _init_contraction_in();
+
+                const container_type * const params[] =
+                    { &_xr, &_xe, &_xc, &_xcc };
+
+                _evaluate_each(4, [&](const size_t i, const size_t thread)
+                {
+                    trials[i] = _invoke(objfunc, *params[i], thread, 0);
+                });
+            }
+
+            const auto trial = [&](
+                    const size_t           index,
+                    const container_type & params)
+                -> value_type
+            {
+                return speculative
+                    ? trials[index]
+                    : _evaluate(objfunc, params);
+            };
+
+            const auto fr = trial(0, _xr);
             if (x0->objval <= fr && fr < _x[_n - 1]->objval)
                 return _accept(_xr, fr, _stats.reflections,
                     operation::reflection);
@@ -787,11 +851,9 @@ namespace jade
             //
             if (fr < x0->objval)
             {
-                _subtract(_xe, _xr, _xbar);
-                _scale(_xe, _opts.chi);
-                _add(_xe, _xe, _xbar);
+                _init_expansion();
 
-                const auto fe = _evaluate(objfunc, _xe);
+                const auto fe = trial(1, _xe);
                 return fe < fr
                     ? _accept(_xe, fe, _stats.expansions,
                         operation::expansion)
@@ -806,22 +868,18 @@ namespace jade
             {
                 if (fr < _x[_n]->objval)
                 {
-                    _subtract(_xc, _xr, _xbar);
-                    _scale(_xc, _opts.gamma);
-                    _add(_xc, _xc, _xbar);
+                    _init_contraction_out();
 
-                    const auto fc = _evaluate(objfunc, _xc);
+                    const auto fc = trial(2, _xc);
                     if (fc <= fr)
                         return _accept(_xc, fc, _stats.contractions_out,
                             operation::contraction_out);
                 }
                 else
                 {
-                    _subtract(_xcc, _xbar, _x[_n]->params);
-                    _scale(_xcc, _opts.gamma);
-                    _subtract(_xcc, _xbar, _xcc);
+                    _init_contraction_in();
 
-                    const auto fcc = _evaluate(objfunc, _xcc);
+                    const auto fcc = trial(3, _xcc);
                     if (fcc < _x[_n]->objval)
                         return _accept(_xcc, fcc, _stats.contractions_in,
                             operation::contraction_in);
@@ -837,9 +895,14 @@ namespace jade
                 _subtract(xi->params, xi->params, x0->params);
                 _scale(xi->params, _opts.sigma);
                 _add(xi->params, xi->params, x0->params);
-                xi->objval = _evaluate(objfunc, xi->params);
             }
 
+            _evaluate_each(_n, [&](const size_t i, const size_t thread)
+            {
+                auto & xi = _x[i + 1];
+                xi->objval = _invoke(objfunc, xi->params, thread, 0);
+            });
+
             std::sort(_x.begin(), _x.end(), _is_less);
             _stats.shrinkages++;
             return operation::shrinkage;
@@ -924,6 +987,78 @@ namespace jade
                 const container_type & params)
         {
             _stats.evaluations++;
+            return _invoke(objfunc, params, 0, 0);
+        }
+
+        // --------------------------------------------------------------------
+        // Invokes the function once for each index in the range [0, count),
+        // passing the index and the number of the thread; the invocations run
+        // concurrently if the options allow it. Each invocation counts as one
+        // evaluation of the objective function.
+        //
+        template <typename TFunction>
+        void _evaluate_each(
+                const size_t      count,
+                const TFunction & function)
+        {
+            _stats.evaluations += count;
+
+            if (_opts.parallel)
+                parallel::for_each(count, function);
+            else
+                for (size_t i = 0; i < count; i++)
+                    function(i, size_t(0));
+        }
+
+        // --------------------------------------------------------------------
+        void _init_contraction_in()
+        {
+            _subtract(_xcc, _xbar, _x[_n]->params);
+            _scale(_xcc, _opts.gamma);
+            _subtract(_xcc, _xbar, _xcc);
+        }
+
+        // --------------------------------------------------------------------
+        void _init_contraction_out()
+        {
+            _subtract(_xc, _xr, _xbar);
+            _scale(_xc, _opts.gamma);
+            _add(_xc, _xc, _xbar);
+        }
+
+        // --------------------------------------------------------------------
+        void _init_expansion()
+        {
+            _subtract(_xe, _xr, _xbar);
+            _scale(_xe, _opts.chi);
+            _add(_xe, _xe, _xbar);
+        }
+
+        // --------------------------------------------------------------------
+        // Calls an objective function that accepts the number of the thread
+        // as its second argument.
+        //
+        template <typename TObjfunc>
+        static auto _invoke(
+                const TObjfunc &       objfunc,
+                const container_type & params,
+                const size_t           thread,
+                int)
+            -> decltype(objfunc(params, thread))
+        {
+            return objfunc(params, thread);
+        }
+
+        // --------------------------------------------------------------------
+        // Calls an objective function that accepts only the parameters.
+        //
+        template <typename TObjfunc>
+        static value_type _invoke(
+                const TObjfunc &       objfunc,
+                const container_type & params,
+                size_t,
+                long)
+        {
             return objfunc(params);
         }
 
@@ -7,8 +7,10 @@
 #ifndef JADE_SVG_HPP__
 #define JADE_SVG_HPP__
 
+#include "jade.lbfgs.hpp"
 #include "jade.newick.hpp"
-#include "jade.simplex.hpp"
+#include "jade.parallel.hpp"
+#include "jade.stopwatch.hpp"
 #include "jade.vec2.hpp"
 
 namespace jade
@@ -29,108 +31,111 @@ namespace jade
         /// The vector type.
         typedef basic_vec2<value_type> vec2_type;
 
+        /// The maximum number of iterations used to optimize the positions.
+        static constexpr size_t max_iterations = 1000;
+
+        /// The maximum number of seconds used to optimize the positions.
+        static constexpr double max_seconds = 5.0;
+
         ///
         /// Initializes a new instance of the class based on the specified
         /// node.
         ///
         explicit basic_svg_tree(
                 const node_type & node) ///< The newick node.
-            : _root  (node.get_id())
-            , _table ()
+            : _nodes ()
+            , _order ()
+            , _cells ()
         {
-            _init_table(node);
-            _update_table(node);
+            _init_nodes(node);
+            _update_positions();
         }
 
         ///
-        /// Optimizes the positions of the vertices using the Nelder-Mead
-        /// Simplex method.
+        /// Assigns the specified angles to the nodes other than the root, and
+        /// computes the objective function minimized by optimize_positions
+        /// and its gradient with respect to the angles. The Barnes-Hut
+        /// quadtree approximates distant cells when they are smaller than
+        /// theta times their distance, so a theta of zero computes the sum and
+        /// gradient exactly; theta must be less than the inverse of the
+        /// square root of two.
         ///
-        void optimize_positions()
+        /// \return The objective value.
+        ///
+        value_type compute_objfunc(
+                const std::vector<value_type> & params,   ///< The angles.
+                std::vector<value_type> &       gradient, ///< The gradient.
+                const value_type                theta     ///< The threshold.
+                    = value_type(barnes_hut::theta))
         {
-            typedef basic_simplex<value_type>             simplex_type;
-            typedef typename simplex_type::container_type container_type;
-            typedef typename simplex_type::execute_args   execute_args_type;
-            typedef typename simplex_type::options        options_type;
+            assert(params.size() + 1 == _nodes.size());
+            assert(theta >= value_type(0) && theta * theta < value_type(0.5));
+            _import_angles(params);
+            return _compute_objfunc(gradient, theta);
+        }
 
-            //
-            // Updates the radians and positions of each node based on a
-            // specified Nelder-Mead parameter set.
-            //
-            const auto import_params = [this](
-                    const container_type & params) -> void
-            {
-                auto dst = _table.begin();
-                for (auto src = params.begin(); src != params.end(); ++src)
-                    (dst++)->second.radians = *src;
-                _update_table(*_table.find(_root)->second.node);
-            };
+        ///
+        /// Optimizes the positions of the vertices using the limited-memory
+        /// BFGS method. The parameters are the angles of the edges, and the
+        /// objective function is the sum of the inverse squared distances
+        /// between all pairs of distinct nodes; the squared distances are
+        /// softened by a small fraction of the longest edge, so nodes at the
+        /// same point do not make the sum infinite. The sum and its gradient
+        /// are approximated with a Barnes-Hut quadtree, so each evaluation
+        /// takes O(n log n) time rather than O(n^2) time.
+        ///
+        void optimize_positions()
+        {
+            typedef basic_lbfgs<value_type>              lbfgs_type;
+            typedef typename lbfgs_type::container_type container_type;
 
             //
-            // Computes the objective function for the Nelder-Mead method. The
-            // value returned is the sum of the inverses of the distances
-            // between all pairs of distinct nodes.
+            // The angle of the root rotates the whole tree, which does not
+            // change the objective function, so only the angles of the other
+            // nodes are optimized.
             //
-            const auto objfunc = [this, import_params](
-                    const container_type & params) -> value_type
-            {
-                import_params(params);
-                auto sum = value_type(0);
-                for (const auto & a0 : _table)
-                for (const auto & b0 : _table)
-                if (a0.first != b0.first)
-                {
-                    const auto a = a0.second.position;
-                    const auto b = b0.second.position;
-                    const auto d = vec2_type::distance_squared(a, b);
-                    if (d < 1e-6) // epsilon
-                        return std::numeric_limits<value_type>::max();
-                    sum += value_type(1) / d;
-                }
-                return sum;
-            };
+            const auto n = _nodes.size();
+            if (n < 3)
+                return;
 
-            //
-            // Converts a specified number of degrees to radians.
-            //
-            const auto to_radians = [](const value_type deg) -> value_type
+            const auto objfunc = [this](
+                    const container_type & params,
+                    container_type &       gradient) -> value_type
             {
-                static const auto tau = value_type(2.0 * std::acos(-1.0));
-                return deg * tau / value_type(360.0);
+                _import_angles(params);
+                return _compute_objfunc(
+                    gradient, value_type(barnes_hut::theta));
             };
 
-            const auto n = _table.size();
+            container_type params;
+            params.reserve(n - 1);
+            for (size_t i = 1; i < n; i++)
+                params.push_back(_nodes[i].radians);
 
             //
-            // Construct the simplex using a unit size of one degree and the
-            // current positions of the nodes.
+            // Iterate until the objective function no longer decreases
+            // significantly or a maximum timeout occurs.
             //
-            options_type opts (n);
-            opts.unit = to_radians(1);
-            opts.vertex.clear();
-            for (const auto & p : _table)
-                opts.vertex.push_back(p.second.radians);
-            simplex_type simplex (objfunc, opts);
+            const stopwatch sw;
+            lbfgs_type engine (objfunc, params);
+            for (size_t i = 0; i < max_iterations; i++)
+            {
+                if (sw > max_seconds)
+                    break;
 
-            //
-            // Execute the Nelder-Mead method until the simplex has collapsed
-            // or a maximum timeout occurs; execute at least a minimum number
-            // of iterations.
-            //
-            execute_args_type exe_args_1;
-            exe_args_1.max_iterations = 100;
-            exe_args_1.max_seconds    = 0.5;
-            simplex.execute(objfunc, exe_args_1);
+                const auto objval = engine.get_objval();
+                if (!engine.iterate(objfunc))
+                    break;
 
-            execute_args_type exe_args_2;
-            exe_args_2.min_length  = to_radians(0.01) * value_type(n);
-            exe_args_2.max_seconds = 0.5;
-            simplex.execute(objfunc, exe_args_2);
+                if (objval - engine.get_objval() <=
+                        value_type(1.0e-6) * engine.get_objval())
+                    break;
+            }
 
             //
-            // Import the final parameters from the simplex.
+            // Import the final parameters from the engine.
             //
-            import_params(simplex.get_vertex());
+            _import_angles(engine.get_vertex());
         }
 
         ///
@@ -152,13 +157,12 @@ namespace jade
                 std::ostream & out) ///< The output stream.
                 const
         {
-            const auto & root  = *_table.find(_root)->second.node;
             metrics_data metrics;
             _create_metrics(metrics);
 
             _write_svg_header(out, metrics);
-            _write_edges(out, metrics, root);
-            _write_nodes(out, metrics, root);
+            _write_edges(out, metrics);
+            _write_nodes(out, metrics);
             _write_svg_footer(out);
         }
 
@@ -191,20 +195,49 @@ namespace jade
         struct node_ex
         {
             const node_type * node;
+            size_t            parent;
             value_type        length;
             value_type        radians;
+            value_type        angle;
             vec2_type         position;
 
             // ----------------------------------------------------------------
             inline node_ex()
                 : node     (nullptr)
+                , parent   (0)
                 , length   ()
                 , radians  ()
+                , angle    ()
                 , position ()
             {
             }
         };
 
+        // --------------------------------------------------------------------
+        // A cell of the Barnes-Hut quadtree; the nodes of a leaf cell are in
+        // the range [first, last) of the order vector.
+        //
+        struct cell
+        {
+            vec2_type  center;
+            value_type mass;
+            value_type size;
+            size_t     first;
+            size_t     last;
+            size_t     children[4];
+
+            // ----------------------------------------------------------------
+            inline cell()
+                : center   ()
+                , mass     ()
+                , size     ()
+                , first    (0)
+                , last     (0)
+                , children ()
+            {
+            }
+        };
+
         // --------------------------------------------------------------------
         struct metrics_data
         {
@@ -232,7 +265,15 @@ namespace jade
             static constexpr char const * font_family         = "Times,serif";
         };
 
-        typedef std::map<int, node_ex> table_type;
+        // --------------------------------------------------------------------
+        struct barnes_hut
+        {
+            static constexpr double theta      = 0.5;
+            static constexpr double softening  = 0.001;
+            static constexpr size_t block_size = 256;
+            static constexpr size_t leaf_size  = 8;
+            static constexpr size_t max_depth  = 32;
+        };
 
         // --------------------------------------------------------------------
         void _create_metrics(metrics_data & metrics) const
@@ -241,8 +282,8 @@ namespace jade
 
             memset(&metrics, 0, sizeof(metrics));
 
-            auto iter = _table.begin();
-            if (iter == _table.end())
+            auto iter = _nodes.begin();
+            if (iter == _nodes.end())
                 return;
 
             metrics.scale = value_type(1);
@@ -253,25 +294,24 @@ namespace jade
             };
 
             auto shortest_edge = numeric_limits_type::quiet_NaN();
-            if (is_measured(iter->second))
-                shortest_edge = iter->second.length;
+            if (is_measured(*iter))
+                shortest_edge = iter->length;
 
-            auto min = iter->second.position;
-            auto max = iter->second.position;
+            auto min = iter->position;
+            auto max = iter->position;
 
-            if (++iter == _table.end())
+            if (++iter == _nodes.end())
             {
                 metrics.large_radius = value_type(100);
                 metrics.scale        = value_type(1);
             }
             else
             {
-                while (iter != _table.end())
+                while (iter != _nodes.end())
                 {
-                    if (is_measured(iter->second))
+                    if (is_measured(*iter))
                     {
-                        const auto shortest_edge_i =
-                            iter->second.length;
+                        const auto shortest_edge_i = iter->length;
 
                         if (shortest_edge_i > value_type(0))
                             if (std::isnan(shortest_edge)
@@ -279,8 +319,8 @@ namespace jade
                                 shortest_edge = shortest_edge_i;
                     }
 
-                    min = vec2_type::min(min, iter->second.position);
-                    max = vec2_type::max(max, iter->second.position);
+                    min = vec2_type::min(min, iter->position);
+                    max = vec2_type::max(max, iter->position);
                     ++iter;
                 }
 
@@ -333,18 +373,274 @@ namespace jade
             return;
         }
 
+        // --------------------------------------------------------------------
+        // Builds the Barnes-Hut quadtree for the current positions and
+        // returns the index of the root cell.
+        //
+        size_t _build_quadtree()
+        {
+            const auto n = _nodes.size();
+
+            _order.resize(n);
+            for (size_t i = 0; i < n; i++)
+                _order[i] = i;
+
+            auto min = _nodes.front().position;
+            auto max = min;
+            for (const auto & ex : _nodes)
+            {
+                min = vec2_type::min(min, ex.position);
+                max = vec2_type::max(max, ex.position);
+            }
+
+            const auto extent = max - min;
+            const auto size   = std::max(extent.x, extent.y);
+
+            _cells.clear();
+            return _build_quadtree(0, n, min, size, 0);
+        }
+
+        // --------------------------------------------------------------------
+        size_t _build_quadtree(
+                const size_t      first,
+                const size_t      last,
+                const vec2_type & min,
+                const value_type  size,
+                const size_t      depth)
+        {
+            static const size_t none = std::numeric_limits<size_t>::max();
+
+            const auto index = _cells.size();
+            _cells.emplace_back();
+
+            auto center = vec2_type();
+            for (auto k = first; k < last; k++)
+                center += _nodes[_order[k]].position;
+
+            auto & c = _cells.back();
+            c.center = center / value_type(last - first);
+            c.mass   = value_type(last - first);
+            c.size   = size;
+            c.first  = first;
+            c.last   = last;
+            std::fill(c.children, c.children + 4, none);
+
+            if (last - first <= size_t(barnes_hut::leaf_size) ||
+                    depth == size_t(barnes_hut::max_depth))
+                return index;
+
+            //
+            // Partition the nodes into the four quadrants of the cell: first
+            // by the vertical line through its middle, then each half by the
+            // horizontal line.
+            //
+            const auto half = size / value_type(2);
+            const auto mid  = min + vec2_type(half, half);
+
+            const auto begin = _order.begin();
+            const auto is_left = [this, &mid](const size_t i) -> bool
+            {
+                return _nodes[i].position.x < mid.x;
+            };
+            const auto is_low = [this, &mid](const size_t i) -> bool
+            {
+                return _nodes[i].position.y < mid.y;
+            };
+
+            const auto x_split = size_t(std::partition(
+                begin + std::ptrdiff_t(first),
+                begin + std::ptrdiff_t(last),
+                is_left) - begin);
+            const auto y_split_0 = size_t(std::partition(
+                begin + std::ptrdiff_t(first),
+                begin + std::ptrdiff_t(x_split),
+                is_low) - begin);
+            const auto y_split_1 = size_t(std::partition(
+                begin + std::ptrdiff_t(x_split),
+                begin + std::ptrdiff_t(last),
+                is_low) - begin);
+
+            const size_t bounds[] = {
+                first, y_split_0, x_split, y_split_1, last };
+
+            for (size_t q = 0; q < 4; q++)
+            {
+                if (bounds[q] == bounds[q + 1])
+                    continue;
+
+                const auto corner = min + vec2_type(
+                    q < 2 ? value_type(0) : half,
+                    q % 2 == 0 ? value_type(0) : half);
+
+                const auto child = _build_quadtree(
+                    bounds[q], bounds[q + 1], corner, half, depth + 1);
+
+                _cells[index].children[q] = child;
+            }
+
+            return index;
+        }
+
+        // --------------------------------------------------------------------
+        // Computes the objective function and its gradient with respect to
+        // the angles of the nodes other than the root. The force on each
+        // node, the gradient of the objective function with respect to its
+        // position, is approximated with the Barnes-Hut quadtree. Rotating
+        // the angle of a node rotates its subtree about its parent, so the
+        // gradient for the angle is the sum, over the subtree, of the cross
+        // products of the offsets from the parent and the forces.
+        //
+        value_type _compute_objfunc(
+                std::vector<value_type> & gradient,
+                const value_type          theta)
+        {
+            const auto n = _nodes.size();
+
+            auto longest = value_type(0);
+            for (const auto & ex : _nodes)
+                longest = std::max(longest, ex.length);
+            if (!(longest > value_type(0)))
+                longest = value_type(1);
+
+            const auto eps  = value_type(barnes_hut::softening) * longest;
+            const auto eps2 = eps * eps;
+
+            gradient.assign(n - 1, value_type(0));
+
+            const auto root = _build_quadtree();
+
+            //
+            // Compute the forces concurrently for blocks of nodes; each
+            // thread has its own stack and partial sum.
+            //
+            const auto block_size   = size_t(barnes_hut::block_size);
+            const auto thread_count = parallel::get_thread_count();
+
+            const auto zero = value_type(0);
+
+            std::vector<vec2_type>           forces  (n);
+            std::vector<value_type>          torques (n, zero);
+            std::vector<value_type>          sums    (thread_count, zero);
+            std::vector<std::vector<size_t>> stacks  (thread_count);
+
+            parallel::for_each((n + block_size - 1) / block_size, [&](
+                    const size_t block,
+                    const size_t thread) -> void
+            {
+                const auto last = std::min(n, (block + 1) * block_size);
+                for (auto i = block * block_size; i < last; i++)
+                {
+                    sums[thread] += _compute_force(
+                        i, root, eps2, theta, stacks[thread], forces[i]);
+                    torques[i] = vec2_type::cross(
+                        _nodes[i].position, forces[i]);
+                }
+            });
+
+            //
+            // Accumulate the forces and torques of each subtree into its
+            // parent; the nodes are stored in depth-first order, so every
+            // node follows its parent.
+            //
+            for (auto i = n - 1; i > 0; i--)
+            {
+                const auto & ex    = _nodes[i];
+                const auto   pivot = _nodes[ex.parent].position;
+
+                gradient[i - 1] = torques[i] - vec2_type::cross(
+                    pivot, forces[i]);
+
+                forces[ex.parent]  += forces[i];
+                torques[ex.parent] += torques[i];
+            }
+
+            //
+            // Each pair of nodes was counted twice.
+            //
+            const auto sum = std::accumulate(
+                sums.begin(), sums.end(), value_type(0));
+            return sum / value_type(2);
+        }
+
+        // --------------------------------------------------------------------
+        // Computes the force on the specified node, the gradient of the
+        // objective function with respect to its position, and returns the
+        // sum of the inverse squared distances from the node to the others.
+        //
+        value_type _compute_force(
+                const size_t          i,
+                const size_t          root,
+                const value_type      eps2,
+                const value_type      theta,
+                std::vector<size_t> & stack,
+                vec2_type &           force)
+                const
+        {
+            static const auto none = std::numeric_limits<size_t>::max();
+
+            const auto p = _nodes[i].position;
+
+            auto sum = value_type(0);
+            force = vec2_type();
+
+            stack.assign(1, root);
+            while (!stack.empty())
+            {
+                const auto & c = _cells[stack.back()];
+                stack.pop_back();
+
+                //
+                // Approximate the cell by its center of mass if it is small
+                // relative to its distance; this never happens for a cell
+                // containing the node since theta is less than the inverse
+                // of the square root of two. The test uses the distance
+                // without the softening, which would otherwise allow tiny
+                // cells around the node to include it with the others.
+                //
+                const auto d = p - c.center;
+                if (c.size * c.size < theta * theta * d.get_length_squared())
+                {
+                    const auto d2 = d.get_length_squared() + eps2;
+                    sum   += c.mass / d2;
+                    force -= (value_type(2) * c.mass / (d2 * d2)) * d;
+                    continue;
+                }
+
+                if (c.children[0] == none && c.children[1] == none &&
+                    c.children[2] == none && c.children[3] == none)
+                {
+                    for (auto k = c.first; k < c.last; k++)
+                    {
+                        const auto j = _order[k];
+                        if (j == i)
+                            continue;
+
+                        const auto dj  = p - _nodes[j].position;
+                        const auto dj2 = dj.get_length_squared() + eps2;
+                        sum   += value_type(1) / dj2;
+                        force -= (value_type(2) / (dj2 * dj2)) * dj;
+                    }
+
+                    continue;
+                }
+
+                for (const auto child : c.children)
+                    if (child != none)
+                        stack.push_back(child);
+            }
+
+            return sum;
+        }
+
         // --------------------------------------------------------------------
         void _find_edge_coords(
             const metrics_data & metrics,
-            const node_type &    n1,
-            const node_type &    n2,
+            const node_ex &      n1ex,
+            const node_ex &      n2ex,
             vec2_type &          p1,
             vec2_type &          p2)
             const
         {
-            const auto & n1ex = _table.find(n1.get_id())->second;
-            const auto & n2ex = _table.find(n2.get_id())->second;
-
             p1 = metrics.scale * n1ex.position;
             p2 = metrics.scale * n2ex.position;
 
@@ -360,120 +656,146 @@ namespace jade
         }
 
         // --------------------------------------------------------------------
-        void _init_table(const node_type & node)
+        // Stores the nodes in depth-first order, so every node follows its
+        // parent, and assigns the initial angles, which divide the range of
+        // each parent evenly among its children.
+        //
+        void _init_nodes(const node_type & node)
         {
-            static const auto tau = value_type(2.0 * std::acos(-1.0));
-            _init_table(node, 0, tau);
-        }
+            static const auto tau  = value_type(2.0 * std::acos(-1.0));
+            static const auto half = value_type(0.5);
 
-        // --------------------------------------------------------------------
-        void _init_table(
-                const node_type & node,
-                const value_type radians,
-                const value_type range)
-        {
-            node_ex ex;
-            ex.node    = &node;
-            ex.radians = radians;
-            ex.length  = std::max(value_type(0), node.get_length());
-
-            const auto id = node.get_id();
-            _table[id] = ex;
-
-            const auto & children = node.get_children();
-            const auto   n        = children.size();
-            const auto   nval     = value_type(n);
-            const auto   half     = value_type(0.5);
-            for (size_t i = 0; i < n; i++)
+            struct item
+            {
+                const node_type * node;
+                size_t            parent;
+                value_type        radians;
+                value_type        range;
+            };
+
+            std::vector<item> stack { item { &node, 0, 0, tau } };
+            while (!stack.empty())
             {
-                const auto ival     = value_type(i);
-                const auto percent  = (half + ival) / nval;
-                const auto radians2 = (range * percent) - (half * range);
-                const auto range2   = range / nval;
-                _init_table(*children[i], radians2, range2);
+                const auto top = stack.back();
+                stack.pop_back();
+
+                const auto index = _nodes.size();
+
+                node_ex ex;
+                ex.node    = top.node;
+                ex.parent  = top.parent;
+                ex.radians = top.radians;
+                ex.length  = std::max(value_type(0), top.node->get_length());
+                _nodes.push_back(ex);
+
+                //
+                // Push the children in reverse order so they are stored in
+                // their original order.
+                //
+                const auto & children = top.node->get_children();
+                const auto   n        = children.size();
+                const auto   nval     = value_type(n);
+                for (auto i = n; i > 0; i--)
+                {
+                    const auto ival     = value_type(i - 1);
+                    const auto percent  = (half + ival) / nval;
+                    const auto radians  = (top.range * percent)
+                                        - (half * top.range);
+                    const auto range    = top.range / nval;
+                    stack.push_back(item {
+                        children[i - 1], index, radians, range });
+                }
             }
         }
 
         // --------------------------------------------------------------------
-        void _update_table(const node_type & node)
+        // Assigns the angles of the nodes other than the root and updates
+        // their positions.
+        //
+        void _import_angles(const std::vector<value_type> & params)
         {
-            _update_table(node, 0, vec2_type());
+            for (size_t i = 1; i < _nodes.size(); i++)
+                _nodes[i].radians = params[i - 1];
+            _update_positions();
         }
 
         // --------------------------------------------------------------------
-        void _update_table(
-            const node_type & node,
-            const value_type  radians0,
-            const vec2_type & p0)
+        // Computes the absolute angle and the position of each node from the
+        // angles relative to the parents.
+        //
+        void _update_positions()
         {
-            const auto id = node.get_id();
-            auto & ex = _table[id];
-
-            const auto rad = radians0 + ex.radians;
+            for (size_t i = 0; i < _nodes.size(); i++)
+            {
+                auto & ex = _nodes[i];
 
-            ex.position = p0 + ex.length * vec2_type(
-                std::cos(rad),
-                std::sin(rad));
+                auto p0 = vec2_type();
+                ex.angle = ex.radians;
+                if (i > 0)
+                {
+                    const auto & parent = _nodes[ex.parent];
+                    p0        = parent.position;
+                    ex.angle += parent.angle;
+                }
 
-            for (const auto ptr : node.get_children())
-                _update_table(*ptr, rad, ex.position);
+                ex.position = p0 + ex.length * vec2_type(
+                    std::cos(ex.angle),
+                    std::sin(ex.angle));
+            }
         }
 
         // --------------------------------------------------------------------
         void _write_edges(
                 std::ostream &       out,
-                const metrics_data & metrics,
-                const node_type &    node)
+                const metrics_data & metrics)
                 const
         {
             const auto stroke_width = metrics.stroke_width;
 
-            for (const auto child : node.get_children())
+            for (size_t i = 1; i < _nodes.size(); i++)
             {
+                const auto & ex = _nodes[i];
+
                 vec2_type p1, p2;
-                _find_edge_coords(metrics, node, *child, p1, p2);
+                _find_edge_coords(metrics, _nodes[ex.parent], ex, p1, p2);
                 _write_svg_line(out, p1.x, p1.y, p2.x, p2.y, stroke_width);
             }
-
-            for (const auto child : node.get_children())
-                _write_edges(out, metrics, *child);
         }
 
         // --------------------------------------------------------------------
         void _write_nodes(
                 std::ostream &       out,
-                const metrics_data & metrics,
-                const node_type &    node)
+                const metrics_data & metrics)
                 const
         {
             const auto stroke_width = value_type(0.5) * metrics.stroke_width;
-            const auto parent_id = node.get_id();
-            const auto & parent_ex = _table.find(parent_id)->second;
-            const auto position = metrics.scale * parent_ex.position;
 
-            const auto radius = node.get_name().empty() ?
-                metrics.small_radius :
-                metrics.large_radius;
+            for (const auto & ex : _nodes)
+            {
+                const auto & node     = *ex.node;
+                const auto   position = metrics.scale * ex.position;
 
-            out << "  <g>\n";
+                const auto radius = node.get_name().empty() ?
+                    metrics.small_radius :
+                    metrics.large_radius;
 
-            _write_svg_circle(out, position.x, position.y,
-                radius, stroke_width);
+                out << "  <g>\n";
 
-            if (!node.get_name().empty())
-            {
-                const auto x         = position.x;
-                const auto y         = position.y + metrics.text_offset;
-                const auto font_size = metrics.font_size;
-                const auto text      = node.get_name().c_str();
-                _write_svg_text(out, x, y, font_size, text, true);
-                _write_svg_text(out, x, y, font_size, text, false);
-            }
+                _write_svg_circle(out, position.x, position.y,
+                    radius, stroke_width);
 
-            out << "  </g>\n";
+                if (!node.get_name().empty())
+                {
+                    const auto x         = position.x;
+                    const auto y         = position.y + metrics.text_offset;
+                    const auto font_size = metrics.font_size;
+                    const auto text      = node.get_name().c_str();
+                    _write_svg_text(out, x, y, font_size, text, true);
+                    _write_svg_text(out, x, y, font_size, text, false);
+                }
 
-            for (const auto child : node.get_children())
-                _write_nodes(out, metrics, *child);
+                out << "  </g>\n";
+            }
         }
 
         // --------------------------------------------------------------------
@@ -574,8 +896,9 @@ namespace jade
             out << "</text>\n";
         }
 
-        int        _root;
-        table_type _table;
+        std::vector<node_ex> _nodes; // The nodes in depth-first order.
+        std::vector<size_t>  _order; // The nodes ordered by quadtree cell.
+        std::vector<cell>    _cells; // The cells of the quadtree.
     };
 }
 
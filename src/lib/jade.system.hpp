@@ -8,8 +8,13 @@
 #define JADE_SYSTEM_HPP__
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
 #include <cctype>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <deque>
@@ -18,6 +23,7 @@
 #include <initializer_list>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <numeric>
@@ -28,6 +34,7 @@
 #include <stack>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 #if defined(JADE_USE_ACCELERATE_FRAMEWORK)
    #include <Accelerate/Accelerate.h>
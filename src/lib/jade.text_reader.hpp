@@ -0,0 +1,620 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_TEXT_READER_HPP__
+#define JADE_TEXT_READER_HPP__
+
+#include "jade.parallel.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that parses whitespace-delimited numbers from
+    /// an input stream. Values are parsed like the formatted input operators
+    /// of the standard streams in the "C" locale, but without the overhead
+    /// of the stream machinery. The remainder of a seekable stream is read
+    /// into memory, and when the reader is destroyed, the stream is
+    /// positioned after the text that was parsed, so other readers may
+    /// continue from there. Other streams are read one token at a time, so
+    /// no text beyond the last value parsed is consumed.
+    ///
+    template <typename TChar>
+    class basic_text_reader
+    {
+    public:
+        /// The character type.
+        typedef TChar char_type;
+
+        /// The input stream type.
+        typedef std::basic_istream<char_type> istream_type;
+
+        ///
+        /// Initializes a new instance of the class, reading the remainder of
+        /// the specified input stream if it is seekable.
+        ///
+        explicit basic_text_reader(
+                istream_type & in) ///< The input stream.
+            : _in    (&in)
+            , _start (in.tellg())
+            , _buf   ()
+            , _pos   (0)
+        {
+            static const size_t chunk_length = 65536;
+
+            if (!_is_seekable())
+            {
+                _buf.push_back('\0');
+                return;
+            }
+
+            for (;;)
+            {
+                const auto size = _buf.size();
+                _buf.resize(size + chunk_length);
+                in.read(_buf.data() + size, std::streamsize(chunk_length));
+                _buf.resize(size + size_t(in.gcount()));
+                if (!in)
+                    break;
+            }
+
+            //
+            // The terminator stops every scan, so the parsing functions never
+            // need to compare against the end of the buffer.
+            //
+            _buf.push_back('\0');
+        }
+
+        basic_text_reader(const basic_text_reader &) = delete;
+        basic_text_reader & operator = (const basic_text_reader &) = delete;
+
+        ///
+        /// Positions a seekable input stream after the parsed text.
+        ///
+        ~basic_text_reader()
+        {
+            if (!_is_seekable())
+                return;
+
+            _in->clear();
+            _in->seekg(_start + typename istream_type::off_type(_pos));
+        }
+
+        ///
+        /// Skips any whitespace at the current position.
+        ///
+        /// \return True if there is no more text to read.
+        ///
+        bool at_end()
+        {
+            _skip_spaces();
+            return _buf[_pos] == '\0';
+        }
+
+        ///
+        /// Reads the next value, skipping any leading whitespace. Characters
+        /// are read as the next non-whitespace character.
+        ///
+        /// \return True if successful; otherwise, false, and the position of
+        /// the reader is unchanged.
+        ///
+        template <typename TValue>
+        bool read(
+                TValue & value) ///< The value read.
+        {
+            _skip_spaces();
+
+            char_type const * ptr = _buf.data() + _pos;
+            if (!_parse(ptr, value))
+                return false;
+
+            _pos = size_t(ptr - _buf.data());
+            return true;
+        }
+
+        ///
+        /// Reads a row-major table of values. When the table is large and
+        /// each row is on its own line, the rows are parsed on multiple
+        /// threads; otherwise, the values are read one at a time.
+        ///
+        /// \return The number of values read, which is less than the size of
+        /// the table if a value could not be parsed.
+        ///
+        template <typename TValue>
+        size_t read_table(
+                TValue *     data,   ///< The destination values.
+                const size_t height, ///< The number of rows.
+                const size_t width)  ///< The number of columns.
+        {
+            static const size_t min_parallel_length = 65536;
+
+            assert(data != nullptr || height * width == 0);
+
+            const auto length = height * width;
+
+            if (length >= min_parallel_length &&
+                    parallel::get_thread_count() > 1 &&
+                    _is_seekable() &&
+                    _read_lines(data, height, width))
+                return length;
+
+            for (size_t index = 0; index < length; index++)
+                if (!read(data[index]))
+                    return index;
+
+            return length;
+        }
+
+    private:
+        typedef std::integral_constant<int, 0> _char_kind;
+        typedef std::integral_constant<int, 1> _floating_kind;
+        typedef std::integral_constant<int, 2> _signed_kind;
+        typedef std::integral_constant<int, 3> _unsigned_kind;
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        inline static bool _parse(char_type const *& ptr, TValue & value)
+        {
+            typedef std::integral_constant<int,
+                std::is_same<TValue, char>::value           ? 0 :
+                std::is_floating_point<TValue>::value       ? 1 :
+                std::is_signed<TValue>::value               ? 2 : 3> kind;
+
+            while (_is_space(*ptr))
+                ptr++;
+
+            return _parse(ptr, value, kind());
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        inline static bool _parse(
+                char_type const *& ptr,
+                TValue &           value,
+                _char_kind)
+        {
+            if (*ptr == '\0')
+                return false;
+
+            value = TValue(*ptr++);
+            return true;
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        static bool _parse(
+                char_type const *& ptr,
+                TValue &           value,
+                _signed_kind)
+        {
+            typedef unsigned long long ull;
+
+            auto       p        = ptr;
+            const auto negative = *p == '-';
+            if (*p == '-' || *p == '+')
+                p++;
+
+            const auto limit = negative
+                ? ull(std::numeric_limits<TValue>::max()) + 1
+                : ull(std::numeric_limits<TValue>::max());
+
+            ull n;
+            if (!_parse_digits(p, limit, n))
+                return false;
+
+            value = negative && n != 0
+                ? TValue(-TValue(n - 1) - 1)
+                : TValue(n);
+            ptr = p;
+            return true;
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        static bool _parse(
+                char_type const *& ptr,
+                TValue &           value,
+                _unsigned_kind)
+        {
+            auto p = ptr;
+            if (*p == '+')
+                p++;
+
+            unsigned long long n;
+            if (!_parse_digits(p, std::numeric_limits<TValue>::max(), n))
+                return false;
+
+            value = TValue(n);
+            ptr = p;
+            return true;
+        }
+
+        // --------------------------------------------------------------------
+        // Parses a decimal floating-point value. Up to 19 significant digits
+        // are accumulated into an integer; when the integer and the power of
+        // ten are both exactly representable, a single multiplication or
+        // division produces the correctly rounded result. Most other values
+        // are converted in extended precision, and the C library converts
+        // the rest.
+        //
+        template <typename TValue>
+        static bool _parse(
+                char_type const *& ptr,
+                TValue &           value,
+                _floating_kind)
+        {
+            typedef std::numeric_limits<TValue> limits;
+
+            static const int max_power = limits::digits >= 64 ? 27
+                                       : limits::digits >= 53 ? 22 : 10;
+
+            static const auto max_exact = limits::digits >= 64
+                ? std::numeric_limits<unsigned long long>::max()
+                : 1ull << (limits::digits & 63);
+
+            const auto begin    = ptr;
+            auto       p        = ptr;
+            const auto negative = *p == '-';
+            if (*p == '-' || *p == '+')
+                p++;
+
+            unsigned long long m         = 0;
+            auto               digits    = 0;
+            auto               exponent  = 0;
+            auto               any       = false;
+            auto               truncated = false;
+
+            for (; _is_digit(*p); p++)
+            {
+                any = true;
+                const auto d = *p - '0';
+                if (digits < 19)
+                {
+                    m = m * 10 + unsigned(d);
+                    digits += m != 0;
+                }
+                else
+                {
+                    exponent++;
+                    truncated |= d != 0;
+                }
+            }
+
+            if (*p == '.')
+            {
+                for (p++; _is_digit(*p); p++)
+                {
+                    any = true;
+                    const auto d = *p - '0';
+                    if (digits < 19)
+                    {
+                        m = m * 10 + unsigned(d);
+                        digits += m != 0;
+                        exponent--;
+                    }
+                    else
+                    {
+                        truncated |= d != 0;
+                    }
+                }
+            }
+
+            if (!any)
+                return false;
+
+            if (*p == 'e' || *p == 'E')
+            {
+                p++;
+                const auto exponent_negative = *p == '-';
+                if (*p == '-' || *p == '+')
+                    p++;
+
+                if (!_is_digit(*p))
+                    return false;
+
+                auto e = 0;
+                for (; _is_digit(*p); p++)
+                    if (e < 100000)
+                        e = e * 10 + (*p - '0');
+
+                exponent += exponent_negative ? -e : e;
+            }
+
+            const auto & powers = _get_powers<TValue>();
+
+            if (m == 0)
+            {
+                value = negative ? -TValue(0) : TValue(0);
+            }
+            else if (!truncated
+                    && m <= max_exact
+                    && exponent >= -max_power
+                    && exponent <= max_power)
+            {
+                const auto x = static_cast<TValue>(m);
+                value = exponent < 0
+                    ? x / powers[size_t(-exponent)]
+                    : x * powers[size_t(exponent)];
+                if (negative)
+                    value = -value;
+            }
+            else if (truncated || !_convert_extended(m, exponent, value))
+            {
+                const auto length = size_t(p - begin);
+                if (length < 64)
+                {
+                    char text[64];
+                    std::copy(begin, p, text);
+                    text[length] = '\0';
+                    value = _convert(text, value);
+                }
+                else
+                {
+                    const std::string text (begin, p);
+                    value = _convert(text.c_str(), value);
+                }
+
+                if (!std::isfinite(value))
+                    return false;
+            }
+            else if (negative)
+            {
+                value = -value;
+            }
+
+            ptr = p;
+            return true;
+        }
+
+        // --------------------------------------------------------------------
+        static bool _parse_digits(
+                char_type const *&   p,
+                unsigned long long   limit,
+                unsigned long long & n)
+        {
+            if (!_is_digit(*p))
+                return false;
+
+            n = 0;
+            for (; _is_digit(*p); p++)
+            {
+                const auto d = static_cast<unsigned long long>(*p - '0');
+                if (n > (limit - d) / 10)
+                    return false;
+                n = n * 10 + d;
+            }
+
+            return true;
+        }
+
+        // --------------------------------------------------------------------
+        // Converts m * 10^exponent using one rounding in extended precision.
+        // The result is rounded again to the value type, which is correct
+        // unless the extended result lies within one unit in the last place
+        // of a point halfway between two values; in that case, the function
+        // fails and the caller converts the text with the C library.
+        //
+        template <typename TValue>
+        static bool _convert_extended(
+                const unsigned long long m,
+                const int                exponent,
+                TValue &                 value)
+        {
+            typedef std::numeric_limits<long double> long_limits;
+            typedef std::numeric_limits<TValue>      limits;
+
+            static const int max_power = 27;
+            static const int shift     = std::max(
+                1, long_limits::digits - limits::digits);
+
+            if (long_limits::digits != 64 || limits::digits >= 64 ||
+                    exponent < -max_power || exponent > max_power)
+                return false;
+
+            const auto & powers = _get_powers<long double>();
+            const auto   x      = static_cast<long double>(m);
+            const auto   r      = exponent < 0
+                ? x / powers[size_t(-exponent)]
+                : x * powers[size_t(exponent)];
+
+            int        e;
+            const auto bits = static_cast<unsigned long long>(
+                std::ldexp(std::frexp(r, &e), long_limits::digits));
+            const auto low  = bits & ((1ull << shift) - 1);
+            const auto half = 1ull << (shift - 1);
+
+            if (low + 1 >= half && low <= half + 1)
+                return false;
+
+            value = static_cast<TValue>(r);
+            return std::isfinite(value);
+        }
+
+        // --------------------------------------------------------------------
+        inline static float _convert(char const * text, float)
+        {
+            return std::strtof(text, nullptr);
+        }
+
+        // --------------------------------------------------------------------
+        inline static double _convert(char const * text, double)
+        {
+            return std::strtod(text, nullptr);
+        }
+
+        // --------------------------------------------------------------------
+        inline static long double _convert(char const * text, long double)
+        {
+            return std::strtold(text, nullptr);
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        static const std::vector<TValue> & _get_powers()
+        {
+            static const std::vector<TValue> powers = []()
+            {
+                std::vector<TValue> out (28);
+                out[0] = TValue(1);
+                for (size_t i = 1; i < out.size(); i++)
+                    out[i] = out[i - 1] * TValue(10);
+                return out;
+            }();
+
+            return powers;
+        }
+
+        // --------------------------------------------------------------------
+        inline static bool _is_digit(const char_type ch)
+        {
+            return ch >= '0' && ch <= '9';
+        }
+
+        // --------------------------------------------------------------------
+        inline static bool _is_space(const char_type ch)
+        {
+            return ch == ' ' || (ch >= '\t' && ch <= '\r');
+        }
+
+        // --------------------------------------------------------------------
+        inline bool _is_seekable() const
+        {
+            return _start != typename istream_type::pos_type(-1);
+        }
+
+        // --------------------------------------------------------------------
+        // Skips any whitespace at the current position. When the stream is
+        // not seekable and the buffer is exhausted, the next token is read
+        // from the stream, leaving the whitespace that follows it unread.
+        //
+        void _skip_spaces()
+        {
+            typedef typename istream_type::traits_type traits_type;
+
+            while (_is_space(_buf[_pos]))
+                _pos++;
+
+            if (_buf[_pos] != '\0' || _is_seekable() || !*_in)
+                return;
+
+            _buf.clear();
+            _pos = 0;
+
+            const auto sb  = _in->rdbuf();
+            const auto eof = traits_type::eof();
+            auto       ch  = sb->sgetc();
+            while (ch != eof && _is_space(traits_type::to_char_type(ch)))
+                ch = sb->snextc();
+
+            while (ch != eof && !_is_space(traits_type::to_char_type(ch)))
+            {
+                _buf.push_back(traits_type::to_char_type(ch));
+                ch = sb->snextc();
+            }
+
+            if (ch == eof)
+                _in->setstate(std::ios_base::eofbit);
+
+            _buf.push_back('\0');
+        }
+
+        // --------------------------------------------------------------------
+        // Reads a table in which each row is on its own line. The lines are
+        // located first, and then blocks of lines are parsed on multiple
+        // threads. If the text does not have this layout or if any value
+        // cannot be parsed, the function fails without changing the position
+        // of the reader.
+        //
+        template <typename TValue>
+        bool _read_lines(
+                TValue *     data,
+                const size_t height,
+                const size_t width)
+        {
+            static const size_t block_length = 16384;
+
+            char_type const * const base = _buf.data();
+            char_type const * const end  = base + _buf.size() - 1;
+            char_type const *       ptr  = base + _pos;
+
+            while (*ptr != '\n' && _is_space(*ptr))
+                ptr++;
+            if (*ptr++ != '\n')
+                return false;
+
+            std::vector<char_type const *> lines;
+            lines.reserve(height + 1);
+            for (size_t y = 0; y < height; y++)
+            {
+                if (ptr == end)
+                    return false;
+
+                lines.push_back(ptr);
+                const auto next = static_cast<char_type const *>(
+                    std::memchr(ptr, '\n', size_t(end - ptr)));
+                ptr = next == nullptr ? end : next + 1;
+            }
+
+            lines.push_back(ptr);
+
+            const auto rows  = std::max(size_t(1), block_length / width);
+            const auto count = (height + rows - 1) / rows;
+
+            std::atomic<bool> ok (true);
+
+            parallel::for_each(count, [&](const size_t block, size_t)
+            {
+                const auto first = block * rows;
+                const auto last  = std::min(first + rows, height);
+
+                for (auto y = first; y < last && ok; y++)
+                {
+                    auto       p   = lines[y];
+                    const auto dst = data + y * width;
+
+                    for (size_t x = 0; x < width; x++)
+                    {
+                        if (!_parse(p, dst[x]))
+                        {
+                            ok = false;
+                            return;
+                        }
+                    }
+
+                    if (p > lines[y + 1])
+                    {
+                        ok = false;
+                        return;
+                    }
+
+                    for (; p != lines[y + 1]; p++)
+                    {
+                        if (!_is_space(*p))
+                        {
+                            ok = false;
+                            return;
+                        }
+                    }
+                }
+            });
+
+            if (!ok)
+                return false;
+
+            _pos = size_t(lines[height] - base);
+            return true;
+        }
+
+        istream_type *                         _in;
+        const typename istream_type::pos_type _start;
+        std::vector<char_type>                 _buf;
+        size_t                                 _pos;
+    };
+
+    /// A class that parses numbers from text read into memory.
+    typedef basic_text_reader<char> text_reader;
+}
+
+#endif // JADE_TEXT_READER_HPP__
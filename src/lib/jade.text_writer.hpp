@@ -0,0 +1,495 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_TEXT_WRITER_HPP__
+#define JADE_TEXT_WRITER_HPP__
+
+#include "jade.parallel.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that formats numbers as text into a large buffer
+    /// and writes the buffer to an output stream in chunks. Floating-point
+    /// values are written in scientific notation using the fewest digits that
+    /// read back to the same value, so the output is compatible with the
+    /// formatted input operators of the standard streams.
+    ///
+    template <typename TChar>
+    class basic_text_writer
+    {
+    public:
+        /// The character type.
+        typedef TChar char_type;
+
+        /// The output stream type.
+        typedef std::basic_ostream<char_type> ostream_type;
+
+        /// The maximum number of characters formatted for one value.
+        static const size_t max_value_length = 32;
+
+        ///
+        /// Initializes a new instance of the class.
+        ///
+        explicit basic_text_writer(
+                ostream_type & out,              ///< The output stream.
+                const size_t   capacity = 65536) ///< The buffer capacity.
+            : _out (out)
+            , _buf (capacity + max_value_length)
+            , _len (0)
+        {
+            assert(capacity > 0);
+        }
+
+        ///
+        /// Writes any buffered text to the output stream.
+        ///
+        ~basic_text_writer()
+        {
+            flush();
+        }
+
+        ///
+        /// Writes any buffered text to the output stream.
+        ///
+        void flush()
+        {
+            if (_len == 0)
+                return;
+
+            _out.write(_buf.data(), std::streamsize(_len));
+            _len = 0;
+        }
+
+        ///
+        /// Formats the specified value into the specified buffer, which must
+        /// have room for at least max_value_length characters.
+        ///
+        /// \return A pointer to the character following the formatted value.
+        ///
+        template <typename TValue>
+        inline static char_type * format(
+                char_type *  dst,   ///< The destination buffer.
+                const TValue value) ///< The value to format.
+        {
+            typedef std::integral_constant<int,
+                std::is_same<TValue, char>::value           ? 0 :
+                std::is_floating_point<TValue>::value       ? 1 :
+                std::is_signed<TValue>::value               ? 2 : 3> kind;
+
+            return _format(dst, value, kind());
+        }
+
+        ///
+        /// Writes the specified character.
+        ///
+        inline void put(
+                const char_type ch) ///< The character to write.
+        {
+            _buf[_len++] = ch;
+            _reserve();
+        }
+
+        ///
+        /// Writes the specified value.
+        ///
+        template <typename TValue>
+        inline void write(
+                const TValue value) ///< The value to write.
+        {
+            const auto ptr = _buf.data() + _len;
+            _len += size_t(format(ptr, value) - ptr);
+            _reserve();
+        }
+
+        ///
+        /// Writes the specified row-major table of values. Values on each
+        /// row are separated by tabs, and each row ends with a new line. Large
+        /// tables are formatted in blocks on multiple threads, and the blocks
+        /// are written to the stream in order.
+        ///
+        template <typename TValue>
+        void write_table(
+                const TValue * data,   ///< The values.
+                const size_t   height, ///< The number of rows.
+                const size_t   width)  ///< The number of columns.
+        {
+            static const size_t block_length = 16384;
+
+            assert(data != nullptr || height * width == 0);
+
+            const auto length       = height * width;
+            const auto block_count  = (length + block_length - 1)
+                                    / block_length;
+            const auto thread_count = parallel::get_thread_count();
+
+            if (block_count <= 1 || thread_count <= 1)
+            {
+                for (size_t index = 0; index < length; index++)
+                {
+                    write(data[index]);
+                    put((index + 1) % width == 0 ? '\n' : '\t');
+                }
+
+                return;
+            }
+
+            std::vector< std::vector<char_type> > blocks (thread_count);
+
+            for (size_t first = 0; first < block_count; first += thread_count)
+            {
+                const auto n = std::min(thread_count, block_count - first);
+
+                parallel::for_each(n, [&](const size_t b, size_t)
+                {
+                    const auto begin = (first + b) * block_length;
+                    const auto end   = std::min(begin + block_length, length);
+
+                    auto & block = blocks[b];
+                    block.resize((end - begin) * (max_value_length + 1));
+
+                    auto ptr = block.data();
+                    for (auto index = begin; index < end; index++)
+                    {
+                        ptr = format(ptr, data[index]);
+                        *ptr++ = (index + 1) % width == 0 ? '\n' : '\t';
+                    }
+
+                    block.resize(size_t(ptr - block.data()));
+                });
+
+                flush();
+                for (size_t b = 0; b < n; b++)
+                    _out.write(blocks[b].data(),
+                               std::streamsize(blocks[b].size()));
+            }
+        }
+
+    private:
+        typedef std::integral_constant<int, 0> _char_kind;
+        typedef std::integral_constant<int, 1> _floating_kind;
+        typedef std::integral_constant<int, 2> _signed_kind;
+        typedef std::integral_constant<int, 3> _unsigned_kind;
+
+        // --------------------------------------------------------------------
+        inline void _reserve()
+        {
+            if (_len + max_value_length >= _buf.size())
+                flush();
+        }
+
+        // --------------------------------------------------------------------
+        static char_type * _copy(char_type * dst, char const * src)
+        {
+            while (*src != '\0')
+                *dst++ = char_type(*src++);
+            return dst;
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        inline static char_type * _format(
+                char_type *  dst,
+                const TValue value,
+                _char_kind)
+        {
+            *dst++ = char_type(value);
+            return dst;
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        static char_type * _format(
+                char_type *  dst,
+                const TValue value,
+                _signed_kind)
+        {
+            if (value >= 0)
+                return _format_digits(dst, static_cast<unsigned long long>(
+                    value));
+
+            *dst++ = '-';
+            return _format_digits(dst, 0ull - static_cast<unsigned long long>(
+                value));
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        inline static char_type * _format(
+                char_type *  dst,
+                const TValue value,
+                _unsigned_kind)
+        {
+            return _format_digits(dst, static_cast<unsigned long long>(value));
+        }
+
+        // --------------------------------------------------------------------
+        static char_type * _format_digits(
+                char_type *        dst,
+                unsigned long long value)
+        {
+            char_type  tmp[24];
+            char_type* ptr = tmp;
+
+            do
+            {
+                *ptr++ = char_type('0' + int(value % 10));
+                value /= 10;
+            }
+            while (value != 0);
+
+            while (ptr != tmp)
+                *dst++ = *--ptr;
+
+            return dst;
+        }
+
+        // --------------------------------------------------------------------
+        // Formats a floating-point value. The value is scaled by an exact
+        // power of ten using extended precision so that it becomes an integer
+        // with max_digits10 digits; then the shortest rounding of that integer
+        // that still lies within half a unit in the last place of the original
+        // value is selected. Values outside the range of exact powers of ten,
+        // subnormal values, and platforms without extended precision use the
+        // C library instead.
+        //
+        template <typename TValue>
+        static char_type * _format(
+                char_type *  dst,
+                const TValue value,
+                _floating_kind)
+        {
+            typedef std::numeric_limits<TValue>      limits;
+            typedef std::numeric_limits<long double> long_limits;
+
+            static const int max_digits = limits::max_digits10;
+            static const int min_digits = limits::digits10;
+            static const int max_scale  = 27;
+
+            if (std::isnan(value))
+                return _copy(dst, "nan");
+
+            auto x = value;
+            if (std::signbit(x))
+            {
+                *dst++ = '-';
+                x = -x;
+            }
+
+            if (std::isinf(x))
+                return _copy(dst, "inf");
+
+            if (!(x > TValue(0)))
+                return _copy(dst, "0e+00");
+
+            if (long_limits::digits < 64 || limits::digits >= 64 ||
+                    x < limits::min())
+                return _format_fallback(dst, x);
+
+            int        e2;
+            const auto m = std::frexp(x, &e2);
+
+            auto e10 = int(std::floor(double(e2 - 1) * 0.30102999566398120));
+            auto s   = max_digits - 1 - e10;
+            if (s > max_scale || s < 1 - max_scale)
+                return _format_fallback(dst, x);
+
+            const auto & powers = _get_powers();
+
+            auto scaled = _scale(x, s);
+            if (scaled >= powers[max_digits])
+            {
+                e10++;
+                s--;
+                scaled = _scale(x, s);
+            }
+
+            //
+            // Determine the distance to the neighboring values, in units of
+            // the scaled value; the distance below a power of two is half the
+            // distance above it. The margin accounts for the rounding errors
+            // introduced by the extended precision arithmetic.
+            //
+            const auto half_up = std::ldexp(
+                _scale(TValue(1), s), e2 - limits::digits - 1);
+            const auto half_down = m > TValue(0.5)
+                ? half_up : half_up / 2;
+            const auto margin = std::ldexp(scaled, 4 - long_limits::digits);
+
+            auto digits = static_cast<unsigned long long>(
+                std::floor(scaled + 0.5L));
+            auto n = max_digits;
+
+            for (auto k = min_digits; k < max_digits; k++)
+            {
+                const auto unit  = powers[max_digits - k];
+                const auto q     = std::floor(scaled / unit + 0.5L);
+                const auto delta = q * unit - scaled;
+                const auto limit = (delta < 0 ? half_down : half_up) - margin;
+
+                //
+                // Within the margin of the limit, the arithmetic cannot
+                // decide whether the rounding reads back to the value, so
+                // the candidate is parsed instead.
+                //
+                if (std::fabs(delta) < limit || (
+                        std::fabs(delta) < limit + margin + margin &&
+                        _is_exact(q, e10 + 1 - k, x)))
+                {
+                    digits = static_cast<unsigned long long>(q);
+                    n      = k;
+                    break;
+                }
+            }
+
+            //
+            // Rounding may carry into an additional digit.
+            //
+            if (digits >= static_cast<unsigned long long>(powers[n]))
+            {
+                digits /= 10;
+                e10++;
+            }
+
+            while (n > 1 && digits % 10 == 0)
+            {
+                digits /= 10;
+                n--;
+            }
+
+            char_type tmp[24];
+            for (auto i = n; i > 0; i--)
+            {
+                tmp[i - 1] = char_type('0' + int(digits % 10));
+                digits /= 10;
+            }
+
+            *dst++ = tmp[0];
+            if (n > 1)
+            {
+                *dst++ = '.';
+                for (auto i = 1; i < n; i++)
+                    *dst++ = tmp[i];
+            }
+
+            *dst++ = 'e';
+            *dst++ = e10 < 0 ? '-' : '+';
+            const auto e = e10 < 0 ? -e10 : e10;
+            if (e < 10)
+                *dst++ = '0';
+            return _format_digits(dst, static_cast<unsigned long long>(e));
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        static char_type * _format_fallback(
+                char_type *  dst,
+                const TValue value)
+        {
+            typedef std::numeric_limits<TValue> limits;
+
+            //
+            // Increase the precision until the text reads back to the value.
+            //
+            char tmp[max_value_length];
+            for (auto precision = 0; ; precision++)
+            {
+                std::snprintf(tmp, sizeof(tmp), "%.*Le",
+                    precision, static_cast<long double>(value));
+
+                if (precision >= limits::max_digits10 - 1)
+                    break;
+
+                const auto parsed = _parse(tmp, value);
+                if (!(parsed < value || value < parsed))
+                    break;
+            }
+
+            //
+            // Remove trailing zeros from the significand.
+            //
+            auto exp = std::strchr(tmp, 'e');
+            auto end = exp;
+            while (end[-1] == '0')
+                end--;
+            if (end[-1] == '.')
+                end--;
+            std::memmove(end, exp, std::strlen(exp) + 1);
+
+            return _copy(dst, tmp);
+        }
+
+        // --------------------------------------------------------------------
+        // Returns true if the text of the digits times the power of ten reads
+        // back to the specified value.
+        //
+        template <typename TValue>
+        static bool _is_exact(
+                const long double digits,
+                const int         exponent,
+                const TValue      value)
+        {
+            char tmp[max_value_length];
+            std::snprintf(tmp, sizeof(tmp), "%llue%d",
+                static_cast<unsigned long long>(digits), exponent);
+
+            const auto parsed = _parse(tmp, value);
+            return !(parsed < value || value < parsed);
+        }
+
+        // --------------------------------------------------------------------
+        static const std::vector<long double> & _get_powers()
+        {
+            static const std::vector<long double> powers = []()
+            {
+                std::vector<long double> out (28);
+                out[0] = 1.0L;
+                for (size_t i = 1; i < out.size(); i++)
+                    out[i] = out[i - 1] * 10.0L;
+                return out;
+            }();
+
+            return powers;
+        }
+
+        // --------------------------------------------------------------------
+        inline static float _parse(char const * text, float)
+        {
+            return std::strtof(text, nullptr);
+        }
+
+        // --------------------------------------------------------------------
+        inline static double _parse(char const * text, double)
+        {
+            return std::strtod(text, nullptr);
+        }
+
+        // --------------------------------------------------------------------
+        inline static long double _parse(char const * text, long double)
+        {
+            return std::strtold(text, nullptr);
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TValue>
+        inline static long double _scale(const TValue x, const int s)
+        {
+            const auto & powers = _get_powers();
+            return s >= 0
+                ? static_cast<long double>(x) * powers[size_t(s)]
+                : static_cast<long double>(x) / powers[size_t(-s)];
+        }
+
+        ostream_type &         _out;
+        std::vector<char_type> _buf;
+        size_t                 _len;
+    };
+
+    /// A class that formats numbers as text and writes them to a stream.
+    typedef basic_text_writer<char> text_writer;
+}
+
+#endif // JADE_TEXT_WRITER_HPP__
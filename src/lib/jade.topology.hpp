@@ -0,0 +1,492 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_TOPOLOGY_HPP__
+#define JADE_TOPOLOGY_HPP__
+
+#include "jade.matrix.hpp"
+#include "jade.rerooted_tree.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that represents the topology and branch
+    /// lengths of a binary tree with K leaves named "0" through "K-1". The
+    /// tree is rooted at leaf "0", and the remaining RK = K-1 leaves and the
+    /// RK-1 internal nodes are stored in flat arrays; each of these 2*RK-1
+    /// nodes has one length, for the edge to its parent, and the length of
+    /// the root node is the edge to leaf "0".
+    ///
+    /// The covariance matrix of the tree is the sum, over all edges, of the
+    /// length of the edge times the 0/1 matrix of the pairs of leaves below
+    /// the edge. The leaves below each node are contiguous in a depth-first
+    /// order, so the covariance matrix and its gradient are computed without
+    /// traversing the tree.
+    ///
+    /// The class also generates the trees one nearest-neighbor interchange
+    /// (NNI) or one subtree pruning and regrafting (SPR) away, which keep the
+    /// lengths of the edges they do not change.
+    ///
+    template <typename TValue>
+    class basic_topology
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The matrix type.
+        typedef basic_matrix<value_type> matrix_type;
+
+        /// The container type for the lengths.
+        typedef std::vector<value_type> container_type;
+
+        /// The Newick node type.
+        typedef basic_newick_node<value_type> node_type;
+
+        /// The rerooted tree type.
+        typedef basic_rerooted_tree<value_type> rerooted_tree_type;
+
+        /// The value indicating no node.
+        static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+        ///
+        /// Initializes a new instance of the class based on the specified
+        /// Newick tree. Nodes with one child are merged into their children,
+        /// and nodes with more than two children are resolved arbitrarily
+        /// using edges with zero length.
+        ///
+        explicit basic_topology(
+                const node_type & tree) ///< The Newick tree.
+            : _rk       (0)
+            , _root     (none)
+            , _parents  ()
+            , _children ()
+            , _lengths  ()
+            , _order    ()
+            , _begin    ()
+            , _end      ()
+        {
+            const rerooted_tree_type rerooted (tree);
+            _rk = rerooted.get_rk();
+
+            if (_rk == 0)
+                throw error("invalid tree: there must be at least two leaves");
+
+            _parents .reserve(2 * _rk - 1);
+            _children.reserve(2 * _rk - 1);
+            _lengths .reserve(2 * _rk - 1);
+            _parents .resize(_rk, size_t(none));
+            _children.resize(_rk, _pair_type { { none, none } });
+            _lengths .resize(_rk, value_type(0));
+
+            //
+            // The rerooted tree is rooted at leaf "0", which has one child.
+            //
+            const auto & leaf_0 = rerooted.get_tree();
+            assert(leaf_0.get_children().size() == 1);
+            _root = _add_tree(*leaf_0.get_children().front());
+            assert(_parents.size() == 2 * _rk - 1);
+
+            _update();
+        }
+
+        ///
+        /// Computes the gradient of a function of the covariance matrix with
+        /// respect to the lengths, given the gradient of the function with
+        /// respect to the covariance matrix.
+        ///
+        void compute_gradient(
+                const matrix_type & g,        ///< The [RK x RK] gradient.
+                container_type &    gradient) ///< The gradient.
+                const
+        {
+            assert(g.is_size(_rk, _rk));
+
+            gradient.resize(_lengths.size());
+            for (size_t node = 0; node < _lengths.size(); node++)
+            {
+                auto sum = value_type(0);
+                for (auto i = _begin[node]; i < _end[node]; i++)
+                    for (auto j = _begin[node]; j < _end[node]; j++)
+                        sum += g(_order[i], _order[j]);
+                gradient[node] = sum;
+            }
+        }
+
+        ///
+        /// Computes the covariance matrix for the specified lengths.
+        ///
+        void compute_covariance(
+                const container_type & lengths, ///< The lengths.
+                matrix_type &          c)       ///< The [RK x RK] matrix.
+                const
+        {
+            assert(lengths.size() == _lengths.size());
+            assert(c.is_size(_rk, _rk));
+
+            c.set_values(value_type(0));
+            for (size_t node = 0; node < lengths.size(); node++)
+            {
+                const auto length = lengths[node];
+                for (auto i = _begin[node]; i < _end[node]; i++)
+                    for (auto j = _begin[node]; j < _end[node]; j++)
+                        c(_order[i], _order[j]) += length;
+            }
+        }
+
+        ///
+        /// \return A string that is identical for two instances if and only
+        /// if they have the same topology; the lengths are ignored.
+        ///
+        std::string get_key() const
+        {
+            std::string key;
+            _write_key(key, _root);
+            return key;
+        }
+
+        ///
+        /// \return The lengths of the edges.
+        ///
+        inline const container_type & get_lengths() const
+        {
+            return _lengths;
+        }
+
+        ///
+        /// \return The trees one nearest-neighbor interchange away from this
+        /// instance. Each internal edge produces two trees by exchanging
+        /// either child of its lower node with the sibling of that node.
+        ///
+        std::vector<basic_topology> get_nni_neighbors() const
+        {
+            std::vector<basic_topology> neighbors;
+
+            for (auto node = _rk; node < _parents.size(); node++)
+            {
+                const auto parent = _parents[node];
+                if (parent == none)
+                    continue;
+
+                const auto sibling = _get_sibling(node);
+                for (size_t i = 0; i < 2; i++)
+                {
+                    basic_topology t (*this);
+                    const auto child = _children[node][i];
+                    t._replace_child(node, child, sibling);
+                    t._replace_child(parent, sibling, child);
+                    t._update();
+                    neighbors.push_back(std::move(t));
+                }
+            }
+
+            return neighbors;
+        }
+
+        ///
+        /// \return The trees one subtree pruning and regrafting away from
+        /// this instance. Each subtree not containing the root is pruned,
+        /// along with its parent, and regrafted onto every edge outside of
+        /// the subtree, including the edge to leaf "0". The regrafted subtree
+        /// splits the length of the edge.
+        ///
+        std::vector<basic_topology> get_spr_neighbors() const
+        {
+            std::vector<basic_topology> neighbors;
+
+            for (size_t node = 0; node < _parents.size(); node++)
+            {
+                const auto parent = _parents[node];
+                if (parent == none)
+                    continue;
+
+                const auto sibling = _get_sibling(node);
+                for (size_t target = 0; target < _parents.size(); target++)
+                {
+                    if (target == parent || target == sibling ||
+                            _is_descendant(target, node))
+                        continue;
+
+                    basic_topology t (*this);
+                    t._prune(node);
+                    t._regraft(node, target);
+                    t._update();
+                    neighbors.push_back(std::move(t));
+                }
+            }
+
+            return neighbors;
+        }
+
+        ///
+        /// \return The rooted K value.
+        ///
+        inline size_t get_rk() const
+        {
+            return _rk;
+        }
+
+        ///
+        /// Assigns the lengths of the edges.
+        ///
+        inline void set_lengths(
+                const container_type & lengths) ///< The lengths.
+        {
+            assert(lengths.size() == _lengths.size());
+            _lengths = lengths;
+        }
+
+        ///
+        /// Encodes this instance in Newick format and returns the output as a
+        /// string.
+        ///
+        /// \return The encoded string.
+        ///
+        inline std::string str() const
+        {
+            std::ostringstream out;
+            write(out);
+            return out.str();
+        }
+
+        ///
+        /// Writes this instance in Newick format into the specified output
+        /// stream. The tree is written as an unrooted tree with leaf "0" as a
+        /// child of the root. As with the write_exact method of the matrix,
+        /// lengths are written with the fewest digits that read back to
+        /// exactly the same value, and the formatting flags of the stream are
+        /// ignored.
+        ///
+        void write(
+                std::ostream & out) ///< The output stream.
+                const
+        {
+            text_writer writer (out);
+            writer.put('(');
+            writer.put('0');
+            writer.put(':');
+            writer.write(_lengths[_root]);
+
+            if (_root < _rk)
+            {
+                writer.put(',');
+                writer.write(_root + 1);
+            }
+            else
+            {
+                for (const auto child : _children[_root])
+                {
+                    writer.put(',');
+                    _write(writer, child);
+                }
+            }
+
+            writer.put(')');
+            writer.put(';');
+        }
+
+    private:
+        typedef std::array<size_t, 2> _pair_type;
+
+        // --------------------------------------------------------------------
+        size_t _add_node(const size_t lhs, const size_t rhs)
+        {
+            const auto node = _parents.size();
+            _parents.push_back(size_t(none));
+            _children.push_back(_pair_type { { lhs, rhs } });
+            _lengths.push_back(value_type(0));
+            _parents[lhs] = node;
+            _parents[rhs] = node;
+            return node;
+        }
+
+        // --------------------------------------------------------------------
+        size_t _add_tree(const node_type & tree)
+        {
+            size_t node;
+
+            if (tree.is_leaf())
+            {
+                std::istringstream in (tree.get_name());
+                in >> node;
+                node--;
+                assert(node < _rk);
+            }
+            else
+            {
+                std::vector<size_t> nodes;
+                for (const auto child : tree.get_children())
+                    nodes.push_back(_add_tree(*child));
+
+                node = nodes.front();
+                for (size_t i = 1; i < nodes.size(); i++)
+                    node = _add_node(node, nodes[i]);
+            }
+
+            _lengths[node] += tree.get_length();
+            return node;
+        }
+
+        // --------------------------------------------------------------------
+        size_t _get_sibling(const size_t node) const
+        {
+            const auto & pair = _children[_parents[node]];
+            return pair[0] == node ? pair[1] : pair[0];
+        }
+
+        // --------------------------------------------------------------------
+        bool _is_descendant(size_t node, const size_t ancestor) const
+        {
+            for (; node != none; node = _parents[node])
+                if (node == ancestor)
+                    return true;
+            return false;
+        }
+
+        // --------------------------------------------------------------------
+        // Removes the specified node and its parent from the tree; the
+        // sibling of the node takes the place of the parent, and its length
+        // absorbs the length of the parent.
+        //
+        void _prune(const size_t node)
+        {
+            const auto parent      = _parents[node];
+            const auto sibling     = _get_sibling(node);
+            const auto grandparent = _parents[parent];
+
+            _lengths[sibling] += _lengths[parent];
+            _parents[sibling]  = grandparent;
+
+            if (grandparent == none)
+                _root = sibling;
+            else
+                _replace_child(grandparent, parent, sibling);
+
+            _parents[parent] = none;
+        }
+
+        // --------------------------------------------------------------------
+        // Inserts the parent of the specified node, removed by _prune, into
+        // the edge above the target node.
+        //
+        void _regraft(const size_t node, const size_t target)
+        {
+            const auto parent = _parents[node];
+            const auto above  = _parents[target];
+
+            _children[parent] = _pair_type { { target, node } };
+            _parents[parent]   = above;
+            _parents[target]   = parent;
+            _lengths[target]  /= value_type(2);
+            _lengths[parent]   = _lengths[target];
+
+            if (above == none)
+                _root = parent;
+            else
+                _replace_child(above, target, parent);
+        }
+
+        // --------------------------------------------------------------------
+        void _replace_child(
+                const size_t node,
+                const size_t old_child,
+                const size_t new_child)
+        {
+            auto & pair = _children[node];
+            pair[pair[0] == old_child ? 0 : 1] = new_child;
+            _parents[new_child] = node;
+        }
+
+        // --------------------------------------------------------------------
+        // Computes the depth-first order of the leaves and the range of the
+        // order spanned by each node.
+        //
+        void _update()
+        {
+            _order.clear();
+            _begin.resize(_parents.size());
+            _end  .resize(_parents.size());
+            _update(_root);
+        }
+
+        // --------------------------------------------------------------------
+        void _update(const size_t node)
+        {
+            _begin[node] = _order.size();
+
+            if (node < _rk)
+                _order.push_back(node);
+            else
+                for (const auto child : _children[node])
+                    _update(child);
+
+            _end[node] = _order.size();
+        }
+
+        // --------------------------------------------------------------------
+        // Writes a key for the subtree of the specified node, ordering the
+        // children by their smallest leaves, and returns the smallest leaf.
+        //
+        size_t _write_key(std::string & key, const size_t node) const
+        {
+            if (node < _rk)
+            {
+                key += std::to_string(node + 1);
+                return node;
+            }
+
+            std::string lhs, rhs;
+            auto min_lhs = _write_key(lhs, _children[node][0]);
+            auto min_rhs = _write_key(rhs, _children[node][1]);
+            if (min_rhs < min_lhs)
+            {
+                lhs.swap(rhs);
+                std::swap(min_lhs, min_rhs);
+            }
+
+            key += '(';
+            key += lhs;
+            key += ',';
+            key += rhs;
+            key += ')';
+            return min_lhs;
+        }
+
+        // --------------------------------------------------------------------
+        void _write(text_writer & writer, const size_t node) const
+        {
+            if (node < _rk)
+            {
+                writer.write(node + 1);
+            }
+            else
+            {
+                writer.put('(');
+                _write(writer, _children[node][0]);
+                writer.put(',');
+                _write(writer, _children[node][1]);
+                writer.put(')');
+            }
+
+            writer.put(':');
+            writer.write(_lengths[node]);
+        }
+
+        size_t                  _rk;       // The rooted K value.
+        size_t                  _root;     // The root node.
+        std::vector<size_t>     _parents;  // The parent of each node.
+        std::vector<_pair_type> _children; // The children of each node.
+        container_type          _lengths;  // The length of each node.
+        std::vector<size_t>     _order;    // The leaves in depth-first order.
+        std::vector<size_t>     _begin;    // The first leaf of each node.
+        std::vector<size_t>     _end;      // The end of the leaves of a node.
+    };
+
+    /// A class that represents the topology and lengths of a binary tree.
+    typedef basic_topology<double> topology;
+}
+
+#endif // JADE_TOPOLOGY_HPP__
@@ -53,6 +53,19 @@ namespace jade
                 _map[n->get_id()] = n;
         }
 
+        ///
+        /// Executes the specified action for each node of this instance, in
+        /// the order of the node identifiers.
+        ///
+        template <typename TAction>
+        void for_each(
+                const TAction action) ///< The action to perform.
+                const
+        {
+            for (const auto & pair : _map)
+                action(pair.second);
+        }
+
         ///
         /// \return The sum of the lengths for all nodes of this instance.
         ///
@@ -0,0 +1,363 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_VCF_READER_HPP__
+#define JADE_VCF_READER_HPP__
+
+#include "jade.likelihood_genotype_matrix.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that reads genotype likelihoods from VCF data
+    /// and is capable of writing them to a stream as a likelihood genotype
+    /// matrix. The likelihoods are taken from the GL field, or from the PL
+    /// field if GL is not available. Only biallelic sites are kept; all other
+    /// sites are skipped while the data is streamed. The alternate allele is
+    /// considered the minor allele, so the likelihoods for the genotypes
+    /// ALT/ALT, REF/ALT, and REF/REF map to the minor-minor, major-minor, and
+    /// major-major matrices, respectively.
+    ///
+    template <typename TValue>
+    class basic_vcf_reader
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The matrix type.
+        typedef basic_matrix<value_type> matrix_type;
+
+        /// The likelihood genotype matrix type.
+        typedef basic_likelihood_genotype_matrix<value_type> lgm_type;
+
+        ///
+        /// Initializes a new instance of the class.
+        ///
+        explicit basic_vcf_reader(
+                std::istream & in) ///< The input stream.
+            : _buf     ()
+            , _rows    (0)
+            , _cols    (0)
+            , _skipped (0)
+        {
+            std::string line;
+            size_t      line_number = 0;
+
+            //
+            // Skip the meta-information lines and read the header line, which
+            // determines the number of samples (individuals).
+            //
+            for (;;)
+            {
+                if (!std::getline(in, line))
+                    throw error() << "failed to read header of vcf data.";
+
+                line_number++;
+                if (line.compare(0, 2, "##") != 0)
+                    break;
+            }
+
+            if (line.compare(0, 6, "#CHROM") != 0)
+                throw error()
+                    << "expected header beginning with '#CHROM' on line "
+                    << line_number << " of vcf data";
+
+            std::vector<std::string> fields;
+            _split(_trim(line), '\t', fields);
+            if (fields.size() < 10)
+                throw error() << "invalid number of columns "
+                              << "in vcf header: " << fields.size();
+
+            _rows = fields.size() - 9;
+
+            std::vector<std::string> keys;
+            std::vector<std::string> values;
+            std::vector<std::string> likelihoods;
+
+            while (std::getline(in, line))
+            {
+                line_number++;
+
+                if (_trim(line).empty())
+                    continue;
+
+                _split(line, '\t', fields);
+                if (fields.size() != _rows + 9)
+                    throw error()
+                        << "expected " << _rows + 9 << " columns but "
+                        << "encountered " << fields.size() << " on line "
+                        << line_number << " of vcf data";
+
+                //
+                // Filter out sites that are not biallelic.
+                //
+                if (!_is_biallelic(fields[4]))
+                {
+                    _skipped++;
+                    continue;
+                }
+
+                //
+                // Determine which field of the sample columns provides the
+                // likelihoods; GL is preferred to PL since it is not rounded.
+                //
+                _split(fields[8], ':', keys);
+                const auto gl = std::find(keys.begin(), keys.end(), "GL");
+                const auto pl = std::find(keys.begin(), keys.end(), "PL");
+                const auto is_pl = gl == keys.end();
+                if (is_pl && pl == keys.end())
+                    throw error()
+                        << "missing GL or PL field for marker '" << fields[2]
+                        << "' on line " << line_number << " of vcf data";
+
+                const auto index = size_t(
+                    (is_pl ? pl : gl) - keys.begin());
+
+                for (size_t i = 0; i < _rows; i++)
+                {
+                    _split(fields[9 + i], ':', values);
+
+                    //
+                    // Missing values carry no information, so each genotype is
+                    // considered equally likely.
+                    //
+                    if (index >= values.size() || values[index] == ".")
+                    {
+                        for (size_t g = 0; g < 3; g++)
+                            _buf.push_back(value_type(1) / value_type(3));
+                        continue;
+                    }
+
+                    _split(values[index], ',', likelihoods);
+                    if (likelihoods.size() != 3)
+                        throw error()
+                            << "expected 3 genotype likelihoods but "
+                            << "encountered " << likelihoods.size()
+                            << " in column " << 10 + i << " on line "
+                            << line_number << " of vcf data";
+
+                    //
+                    // Convert the values to log10 likelihoods; a missing
+                    // value in the list leaves the genotypes equally likely.
+                    //
+                    double p[3] = { 0.0, 0.0, 0.0 };
+                    auto   is_missing = false;
+                    for (size_t g = 0; g < 3; g++)
+                    {
+                        const auto & text = likelihoods[g];
+                        if (text == ".")
+                        {
+                            is_missing = true;
+                            continue;
+                        }
+
+                        char *     end = nullptr;
+                        const auto x   = std::strtod(text.c_str(), &end);
+                        if (text.empty() || *end != '\0' || !std::isfinite(x)
+                                || (is_pl && x < 0.0))
+                            throw error()
+                                << "encountered invalid "
+                                << (is_pl ? "PL" : "GL") << " value '"
+                                << text << "' in column " << 10 + i
+                                << " on line " << line_number
+                                << " of vcf data";
+
+                        p[g] = is_pl ? -0.1 * x : x;
+                    }
+
+                    if (is_missing)
+                    {
+                        for (size_t g = 0; g < 3; g++)
+                            _buf.push_back(value_type(1) / value_type(3));
+                        continue;
+                    }
+
+                    //
+                    // Subtract the largest log likelihood before taking the
+                    // powers, so the largest likelihood is one and the sum
+                    // cannot underflow, even for values like PL=3000,0,3000.
+                    //
+                    const auto p_max = std::max(p[0], std::max(p[1], p[2]));
+                    auto       sum   = 0.0;
+                    for (size_t g = 0; g < 3; g++)
+                    {
+                        p[g] = std::pow(10.0, p[g] - p_max);
+                        sum += p[g];
+                    }
+
+                    //
+                    // Normalize the likelihoods like the percentages in
+                    // BEAGLE data, storing them in the order of the likelihood
+                    // genotype matrices (minor-minor first).
+                    //
+                    for (size_t g = 3; g > 0; g--)
+                        _buf.push_back(value_type(p[g - 1] / sum));
+                }
+
+                _cols++;
+            }
+
+            if (_cols == 0)
+                _rows = 0;
+        }
+
+        ///
+        /// \return A new likelihood genotype matrix based on the VCF data.
+        ///
+        lgm_type create_lgm() const
+        {
+            matrix_type g[3] = {
+                matrix_type(_rows, _cols),
+                matrix_type(_rows, _cols),
+                matrix_type(_rows, _cols) };
+
+            auto src_ptr = _buf.data();
+            for (size_t j = 0; j < _cols; j++)
+                for (size_t i = 0; i < _rows; i++)
+                    for (size_t k = 0; k < 3; k++)
+                        g[k](i, j) = *src_ptr++;
+
+            return lgm_type(g[0], g[1], g[2]);
+        }
+
+        ///
+        /// \return The number of markers read from the VCF data.
+        ///
+        inline size_t get_marker_count() const
+        {
+            return _cols;
+        }
+
+        ///
+        /// \return The number of sites skipped because they are not biallelic.
+        ///
+        inline size_t get_skipped_count() const
+        {
+            return _skipped;
+        }
+
+        ///
+        /// \return A string representation of this instance.
+        ///
+        std::string str() const
+        {
+            std::ostringstream out;
+            write(out);
+            return out.str();
+        }
+
+        ///
+        /// Writes the VCF data to the specified output stream as a likelihood
+        /// genotype matrix.
+        ///
+        void write(
+            std::ostream & out) ///< The output stream.
+            const
+        {
+            const auto r3 = _rows * 3;
+
+            text_writer writer (out);
+
+            for (size_t k = 0; k < 3; k++)
+            {
+                if (k > 0)
+                    writer.put('\n');
+
+                writer.write(_rows);
+                writer.put(' ');
+                writer.write(_cols);
+                writer.put('\n');
+
+                for (size_t i = 0; i < _rows; i++)
+                {
+                    const auto * const row_ptr = _buf.data() + i * 3 + k;
+                    for (size_t j = 0; j < _cols; j++)
+                    {
+                        if (j > 0)
+                            writer.put('\t');
+                        writer.write(row_ptr[j * r3]);
+                    }
+
+                    writer.put('\n');
+                }
+            }
+
+            writer.flush();
+            out.flush();
+        }
+
+        ///
+        /// Writes the VCF data to the specified output file.
+        ///
+        inline void write(
+            char const * const path) ///< The output path.
+        {
+            assert(path != nullptr);
+            std::ofstream out (path);
+            if (!out.good())
+                throw error() << "error opening '" << path << "' for writing";
+            write(out);
+        }
+
+        ///
+        /// Writes the VCF data to the specified output file.
+        ///
+        inline void write(
+            const std::string & path) ///< The output path.
+        {
+            write(path.c_str());
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        static bool _is_biallelic(const std::string & alt)
+        {
+            return !alt.empty()
+                && alt != "."
+                && alt[0] != '<'
+                && alt.find(',') == std::string::npos;
+        }
+
+        // --------------------------------------------------------------------
+        static void _split(
+                const std::string &        text,
+                const char                 delimiter,
+                std::vector<std::string> & out)
+        {
+            out.clear();
+
+            size_t first = 0;
+            for (;;)
+            {
+                const auto last = text.find(delimiter, first);
+                if (last == std::string::npos)
+                {
+                    out.push_back(text.substr(first));
+                    return;
+                }
+
+                out.push_back(text.substr(first, last - first));
+                first = last + 1;
+            }
+        }
+
+        // --------------------------------------------------------------------
+        static std::string & _trim(std::string & line)
+        {
+            if (!line.empty() && line[line.size() - 1] == '\r')
+                line.resize(line.size() - 1);
+            return line;
+        }
+
+        std::vector<value_type> _buf;
+        size_t                  _rows;
+        size_t                  _cols;
+        size_t                  _skipped;
+    };
+}
+
+#endif // JADE_VCF_READER_HPP__
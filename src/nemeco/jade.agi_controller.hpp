@@ -15,6 +15,14 @@ namespace jade
     /// A template for a class that encodes and decodes parameters for the
     /// Nelder-Mead algorithm. This class uses an admixture graph input file.
     ///
+    /// The class also supports the limited-memory BFGS method. Since the
+    /// matrix entries are arithmetic expressions of the variables, their
+    /// derivatives are computed by forward-mode differentiation of the
+    /// compiled expressions and combined with the gradient of the
+    /// likelihood. The variables are bounded, so the method optimizes the
+    /// logarithms of the branch variables and the logits of the proportion
+    /// variables instead.
+    ///
     template <typename TValue>
     class basic_agi_controller
         : public basic_controller<TValue>
@@ -29,8 +37,11 @@ namespace jade
         /// The shunting-yard algorithm type.
         typedef basic_shunting_yard<value_type> shunting_yard_type;
 
-        /// The arguments passed to the shunting-yard algorithm.
-        typedef typename shunting_yard_type::args_type args_type;
+        /// The compiled expression program type.
+        typedef typename shunting_yard_type::program_type program_type;
+
+        /// The likelihood type.
+        typedef basic_likelihood<value_type> likelihood_type;
 
         /// The matrix type.
         typedef basic_matrix<value_type> matrix_type;
@@ -47,45 +58,177 @@ namespace jade
         /// The container type for the simplex.
         typedef typename simplex_type::container_type container_type;
 
-        /// The exit condition type for the simplex.
-        typedef typename simplex_type::exit_condition_type exit_condition_type;
-
         ///
         /// Initializes a new instance of the class based on the specified
-        /// program settings.
+        /// program settings and likelihood.
         ///
-        explicit basic_agi_controller(
-                const settings_type & settings) ///< The program settings.
-            : basic_controller<TValue> (settings)
+        basic_agi_controller(
+                const settings_type &   settings,   ///< The program settings.
+                const likelihood_type & likelihood) ///< The likelihood.
+            : basic_controller<TValue> (settings, likelihood)
             , _agi                     (settings.get_agi())
-            , _args                    (_agi.get_args())
+            , _names                   ()
+            , _program                 ()
+            , _thread_stacks           ()
+            , _dstack                  ()
+            , _x                       ()
+            , _dc                      ()
+            , _cc                      (this->get_rk(), this->get_rk())
+            , _gradient                (this->get_rk(), this->get_rk())
         {
+            //
+            // The parameters store the proportion variables first, followed
+            // by the branch variables, so the compiled expressions refer to
+            // the parameters by their indices in this list of names.
+            //
+            const auto & proportions = _agi.get_proportion_names();
+            const auto & branches    = _agi.get_branch_names();
+            _names.insert(_names.end(), proportions.begin(), proportions.end());
+            _names.insert(_names.end(), branches.begin(), branches.end());
+
+            //
+            // Compile the expressions once so each one stores its output
+            // directly into its cell of the lower triangle of the covariance
+            // matrix:
+            //
+            //  | 0 - - |
+            //  | 1 2 - |
+            //  | 3 4 5 |
+            //
+            const auto & entries = _agi.get_entries();
+            const auto   rk      = _agi.get_k() - 1;
+            size_t       i       = 0;
+            for (size_t row = 0; row < rk; row++)
+                for (size_t col = 0; col <= row; col++)
+                    entries[i++].compile(_names, row * rk + col, _program);
+
+            _thread_stacks.assign(
+                parallel::get_thread_count(),
+                container_type(_program.get_stack_size()));
+            _dstack.resize(_program.get_stack_size() * _names.size());
+            _x.resize(_names.size());
+            _dc.resize(rk * rk * _names.size());
         }
 
         ///
-        /// Writes results to standard output and files.
+        /// Computes the objective function for parameters that hold the
+        /// logits of the proportion variables followed by the logarithms of
+        /// the branch variables, so every set of parameters encodes variables
+        /// within their bounds.
         ///
-        void emit_results(
-                const options_type &        opts,      ///< The options.
-                const simplex_type &        simplex,   ///< The simplex.
-                const exit_condition_type & condition) ///< The context.
+        /// \return The negation of the log likelihood.
+        ///
+        value_type compute_lbfgs_objfunc(
+                const container_type & params,   ///< The parameters.
+                container_type &       gradient) ///< The gradient.
                 override
         {
+            static const auto inf = std::numeric_limits<value_type>::max();
+
+            const auto n  = _names.size();
+            const auto np = _agi.get_proportion_names().size();
+            const auto rk = this->get_rk();
+
+            assert(params.size() == n);
+            _decode_lbfgs(params, _x);
+
             //
-            // The base class emits the C matrix; this also has the effect of
-            // updating the arguments used to evaluate the expressions.
+            // Evaluate the matrix entries and their derivatives with respect
+            // to the variables. As with the Nelder-Mead algorithm, reject the
+            // parameters if any entry is not positive.
             //
-            basic_controller<TValue>::emit_results(opts, simplex, condition);
+            _program.evaluate_gradient(
+                _x.data(),
+                n,
+                _thread_stacks[0].data(),
+                _dstack.data(),
+                _cc.get_data(),
+                _dc.data());
+
+            for (size_t row = 0; row < rk; row++)
+            {
+                for (size_t col = 0; col <= row; col++)
+                {
+                    if (_cc(row, col) <= value_type(0))
+                        return inf;
+                    _cc(col, row) = _cc(row, col);
+                }
+            }
+
+            const auto lle = this->_compute_gradient(_cc, _gradient);
+            if (!(lle > -inf))
+                return inf;
+
+            //
+            // Each entry of the lower triangle also appears in the upper
+            // triangle, so apply the chain rule with the gradient with
+            // respect to C doubled off the diagonal.
+            //
+            gradient.assign(n, value_type(0));
+            for (size_t row = 0; row < rk; row++)
+            {
+                for (size_t col = 0; col <= row; col++)
+                {
+                    const auto g = _gradient(row, col) *
+                        (row == col ? value_type(1) : value_type(2));
+                    const auto dc = _dc.data() + (row * rk + col) * n;
+                    for (size_t k = 0; k < n; k++)
+                        gradient[k] += g * dc[k];
+                }
+            }
+
+            //
+            // Scale by the derivatives of the variables with respect to the
+            // parameters, and negate the gradient because the objective
+            // function is the negation of the log-likelihood.
+            //
+            for (size_t k = 0; k < n; k++)
+            {
+                const auto x = _x[k];
+                gradient[k] *= -(k < np ? x * (value_type(1) - x) : x);
+            }
+
+            return -lle;
+        }
+
+        ///
+        /// \return The Nelder-Mead container for the variables encoded by the
+        /// specified parameters.
+        ///
+        container_type decode_lbfgs_parameters(
+                const container_type & params) ///< The parameters.
+                override
+        {
+            container_type out (params.size());
+            _decode_lbfgs(params, out);
+            return out;
+        }
+
+        ///
+        /// Writes results to standard output and files.
+        ///
+        void emit_results(
+                const options_type &   opts,   ///< The options.
+                const container_type & params, ///< The optimized parameters.
+                const value_type       objval) ///< The objective value.
+                override
+        {
+            basic_controller<TValue>::emit_results(opts, params, objval);
 
             //
-            // Loop over each argument and display its value.
+            // Display the value of each branch variable and then each
+            // proportion variable; note the parameters store the proportion
+            // variables first.
             //
+            const auto np = _agi.get_proportion_names().size();
+            const auto nb = _agi.get_branch_names().size();
+
             std::cout << "\n[Admixture Graph Output]\n";
             matrix_type::set_high_precision(std::cout);
-            for (const auto & name : _agi.get_branch_names())
-                std::cout << name << "\t" << _args[name] << "\n";
-            for (const auto & name : _agi.get_proportion_names())
-                std::cout << name << "\t" << _args[name] << "\n";
+            for (size_t i = 0; i < nb; i++)
+                std::cout << _names[np + i] << "\t" << params[np + i] << "\n";
+            for (size_t i = 0; i < np; i++)
+                std::cout << _names[i] << "\t" << params[i] << "\n";
             std::cout.flush();
         }
 
@@ -102,7 +245,24 @@ namespace jade
             // proportion variables.
             //
             container_type out;
-            out.resize(_args.size(), value_type(0.5));
+            out.resize(_names.size(), value_type(0.5));
+            return out;
+        }
+
+        ///
+        /// Creates and returns the initial set of parameters for the limited-
+        /// memory BFGS method, which encode 0.5 for both branch and proportion
+        /// variables.
+        ///
+        /// \return The initial parameters for the limited-memory BFGS method.
+        ///
+        container_type init_lbfgs_parameters() override
+        {
+            const auto np = _agi.get_proportion_names().size();
+
+            container_type out (_names.size(), std::log(value_type(0.5)));
+            for (size_t k = 0; k < np; k++)
+                out[k] = value_type(0);
             return out;
         }
 
@@ -114,8 +274,9 @@ namespace jade
         /// \return True if successful; otherwise, false.
         ///
         bool _decode_lower(
-                matrix_type &          dst, ///< The covariance matrix.
-                const container_type & src) ///< The Nelder-Mead container.
+                matrix_type &          dst,    ///< The covariance matrix.
+                const container_type & src,    ///< The Nelder-Mead container.
+                const size_t           thread) ///< The thread number.
                 override
         {
             //
@@ -140,38 +301,17 @@ namespace jade
             }
 
             //
-            // Copy the values from the Nelder-Mead container into the table
-            // of arguments used to evaluate the expression. Since these values
-            // are the same for all expressions, the same container is used for
-            // each expression evaluated.
-            //
-            {
-                size_t i = 0;
-                for (const auto & name : _agi.get_proportion_names())
-                    _args[name] = src[i++];
-                for (const auto & name : _agi.get_branch_names())
-                    _args[name] = src[i++];
-            }
-
-            //
-            // Copy the expression output to the lower-triangle of the
-            // covariance matrix:
-            //
-            //  | 0 - - |
-            //  | 1 2 - |
-            //  | 3 4 5 |
-            //
-            // Each value in the matrix is determined by evaluating a
-            // corresponding expression.
+            // Evaluate the compiled expressions, which read their arguments
+            // directly from the Nelder-Mead container and store their outputs
+            // into the lower triangle of the covariance matrix. Each thread
+            // uses its own stack.
             //
-            {
-                const auto & entries = _agi.get_entries();
-                const auto   rk      = _agi.get_k() - 1;
-                size_t       i       = 0;
-                for (size_t row = 0; row < rk; row++)
-                    for (size_t col = 0; col <= row; col++)
-                        dst(row, col) = entries[i++].evaluate(_args);
-            }
+            assert(dst.get_length() >= _program.get_output_count());
+            assert(thread < _thread_stacks.size());
+            _program.evaluate(
+                src.data(),
+                _thread_stacks[thread].data(),
+                dst.get_data());
 
             //
             // Return true to indicate the values are acceptable.
@@ -180,8 +320,33 @@ namespace jade
         }
 
     private:
-        const agi_reader_type & _agi;  // The admixture graph input.
-        args_type               _args; // Arguments used to evaluate entries.
+        // --------------------------------------------------------------------
+        // Decodes the logits of the proportion variables and the logarithms
+        // of the branch variables.
+        //
+        void _decode_lbfgs(
+                const container_type & params,
+                container_type &       x)
+                const
+        {
+            const auto np = _agi.get_proportion_names().size();
+
+            assert(x.size() == params.size());
+            for (size_t k = 0; k < params.size(); k++)
+                x[k] = k < np
+                    ? value_type(1) / (value_type(1) + std::exp(-params[k]))
+                    : std::exp(params[k]);
+        }
+
+        const agi_reader_type &     _agi;           // The admixture graph.
+        std::vector<std::string>    _names;         // The parameter names.
+        program_type                _program;       // The expressions.
+        std::vector<container_type> _thread_stacks; // The stack per thread.
+        container_type              _dstack;        // The derivative stack.
+        container_type              _x;             // The decoded variables.
+        container_type              _dc;            // The derivatives of C.
+        matrix_type                 _cc;            // The covariance matrix.
+        matrix_type                 _gradient;      // The gradient of C.
     };
 }
 
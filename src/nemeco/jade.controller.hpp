@@ -44,12 +44,6 @@ namespace jade
         /// The container type for the simplex.
         typedef typename simplex_type::container_type container_type;
 
-        /// The exit condition for the simplex.
-        typedef typename simplex_type::exit_condition_type exit_condition_type;
-
-        /// The loc arguments for the simplex.
-        typedef typename simplex_type::log_args log_args_type;
-
         ///
         /// Reclaims resources, if any, used by the instance.
         ///
@@ -63,20 +57,27 @@ namespace jade
         /// Cholskey square root, calculating the determinant, computing the
         /// inverse, and calling the likelihood function.
         ///
+        /// Each thread uses its own covariance matrix, so threads may call
+        /// this method concurrently if the controller is thread-safe.
+        ///
         /// \return The negation of the log likelihood.
         ///
         value_type compute_objfunc(
-                const container_type & params) ///< The parameters.
+                const container_type & params,     ///< The parameters.
+                const size_t           thread = 0) ///< The thread number.
         {
             static const auto inf = std::numeric_limits<value_type>::max();
 
+            assert(thread < _thread_c.size());
+            auto & c = _thread_c[thread];
+
             //
             // The LAPACK routines need only the lower triangle stored in
             // the matrix. If these routines are successful, the lower
             // triangle is copied to the upper triangle before calculating
             // the likelihood.
             //
-            if (!_decode_lower(_c, params))
+            if (!_decode_lower(c, params, thread))
                 return inf;
 
             //
@@ -85,7 +86,7 @@ namespace jade
             //
             for (size_t row = 0; row < _rk; row++)
                 for (size_t col = 0; col <= row; col++)
-                    if (_c(row, col) <= value_type(0))
+                    if (c(row, col) <= value_type(0))
                         return inf;
 
             //
@@ -94,28 +95,28 @@ namespace jade
             // to indicate these are unacceptable parameters.
             //
             value_type log_c_det;
-            if (!_c.invert(log_c_det))
+            if (!c.invert(log_c_det))
                 return inf;
 
             //
             // The Nelder-Mead algorithm minimizes the objective function, so
             // return the negation of the log-likelihood function.
             //
-            return -_likelihood(_c, log_c_det);
+            return -_likelihood(c, log_c_det);
         }
 
         ///
         /// Writes results to standard output and files.
         ///
         virtual void emit_results(
-                const options_type &        opts,    ///< The options.
-                const simplex_type &        simplex, ///< The simplex.
-                const exit_condition_type &)         ///< The context.
+                const options_type &   opts,   ///< The options.
+                const container_type & params, ///< The optimized parameters.
+                const value_type       objval) ///< The objective value.
         {
             //
             // Decode the final set of parameters (the optimized matrix).
             //
-            _decode_lower(_c, simplex.get_vertex());
+            _decode_lower(_c, params, 0);
             _c.copy_lower_to_upper();
 
             //
@@ -124,7 +125,7 @@ namespace jade
             //
             std::cout
                 << "\nlog likelihood = "
-                << -simplex.get_objval()
+                << -objval
                 << std::endl;
 
             //
@@ -139,17 +140,58 @@ namespace jade
                 if (!out.good())
                     throw error() << "failed to create matrix '" << cout << "'";
 
-                matrix_type::set_high_precision(out);
-                out << _c;
+                _c.write_exact(out);
             }
             else
             {
                 std::cout << "[C Matrix]\n";
-                matrix_type::set_high_precision(std::cout);
-                std::cout << _c << std::endl;
+                _c.write_exact(std::cout);
+                std::cout << std::endl;
             }
         }
 
+        ///
+        /// \return The covariance matrix encoded by the specified Nelder-Mead
+        /// parameters.
+        ///
+        matrix_type create_c(
+                const container_type & params) ///< The parameters.
+        {
+            matrix_type c (_rk, _rk);
+            _decode_lower(c, params, 0);
+            c.copy_lower_to_upper();
+            return c;
+        }
+
+        ///
+        /// Computes the objective function and its gradient for parameters of
+        /// the limited-memory BFGS method. Controllers supporting the method
+        /// override this function; the default implementation throws an
+        /// exception.
+        ///
+        /// \return The negation of the log likelihood.
+        ///
+        virtual value_type compute_lbfgs_objfunc(
+                const container_type &, ///< The parameters.
+                container_type &)       ///< The gradient.
+        {
+            throw error("the lbfgs method is not supported by this model");
+        }
+
+        ///
+        /// Converts parameters of the limited-memory BFGS method to the
+        /// corresponding parameters of the Nelder-Mead algorithm, which are
+        /// passed to emit_results. Controllers supporting the method override
+        /// this function; the default implementation throws an exception.
+        ///
+        /// \return The Nelder-Mead container.
+        ///
+        virtual container_type decode_lbfgs_parameters(
+                const container_type &) ///< The parameters.
+        {
+            throw error("the lbfgs method is not supported by this model");
+        }
+
         ///
         /// \return A reference to the covariance matrix.
         ///
@@ -175,20 +217,39 @@ namespace jade
         virtual container_type init_parameters() = 0;
 
         ///
-        /// Logs information about the specified context for one iteration of
-        /// the Nelder-Mead algorithm.
+        /// Creates and returns the initial set of parameters for the limited-
+        /// memory BFGS method. Controllers supporting the method override this
+        /// function; the default implementation throws an exception.
         ///
-        void log_iteration(
-                const log_args_type & log_args) ///< The Nelder-Mead arguments.
+        /// \return The initial parameters for the limited-memory BFGS method.
+        ///
+        virtual container_type init_lbfgs_parameters()
         {
-            const auto lle = -log_args.simplex->get_objval();
+            throw error("the lbfgs method is not supported by this model");
+        }
 
-            const auto dlle = log_args.iteration == 1
+        ///
+        /// \return True if compute_objfunc may be called from several threads
+        /// concurrently; otherwise, false.
+        ///
+        virtual bool is_thread_safe() const
+        {
+            return true;
+        }
+
+        ///
+        /// Logs information about one iteration of the optimization.
+        ///
+        void log_iteration(
+                const size_t     iteration, ///< The completed iteration.
+                const value_type lle)       ///< The log-likelihood.
+        {
+            const auto dlle = iteration == 1
                 ? value_type(0)
                 : lle - _lle;
 
             std::ostringstream line;
-            line << log_args.iteration
+            line << iteration
                  << std::fixed << std::setprecision(6)
                  << '\t' << _iteration_time;
             matrix_type::set_high_precision(line);
@@ -202,37 +263,63 @@ namespace jade
     protected:
         ///
         /// Initializes a new instance of the class based on the specified
-        /// settings.
+        /// settings and likelihood.
         ///
-        explicit basic_controller(
-                const settings_type & settings) ///< The algorithm settings.
+        basic_controller(
+                const settings_type &   settings,   ///< The algorithm settings.
+                const likelihood_type & likelihood) ///< The likelihood.
             : _rk             (settings.get_rf().get_height())
             , _c              (settings.get_c())
             , _lle            (0)
-            , _likelihood     (settings.get_rf(), settings.get_mu())
+            , _likelihood     (likelihood)
             , _iteration_time ()
+            , _thread_c       (parallel::get_thread_count(), _c)
         {
             assert(_rk > 0);
             assert(_c.is_size(_rk, _rk));
         }
 
+        ///
+        /// Computes the log-likelihood of the specified covariance matrix and
+        /// its gradient with respect to the covariance matrix.
+        ///
+        /// \return The log-likelihood, or negative infinity if the matrix is
+        /// not positive definite.
+        ///
+        value_type _compute_gradient(
+                const matrix_type & c,        ///< The covariance matrix.
+                matrix_type &       gradient) ///< The gradient.
+        {
+            auto & c_inv = _thread_c[0];
+
+            c_inv = c;
+            value_type log_c_det;
+            if (!c_inv.invert(log_c_det))
+                return -std::numeric_limits<value_type>::infinity();
+
+            return _likelihood.compute_gradient(c_inv, log_c_det, gradient);
+        }
+
         ///
         /// Decodes the specified Nelder-Mead container and stores the result
         /// into the lower triangle, including the diagonal, of the covariance
-        /// matrix.
+        /// matrix. Threads evaluating the objective function concurrently
+        /// pass their numbers, which select any scratch space they need.
         /// \return True if successful; otherwise, false.
         ///
         virtual bool _decode_lower(
-                matrix_type &          dst, ///< The covariance matrix.
-                const container_type & src) ///< The Nelder-Mead container.
+                matrix_type &          dst,    ///< The covariance matrix.
+                const container_type & src,    ///< The Nelder-Mead container.
+                const size_t           thread) ///< The thread number.
                 = 0;
 
     private:
-        size_t          _rk;             // The rooted K value; i.e. K - 1.
-        matrix_type     _c;              // The covariance matrix.
-        value_type      _lle;            // The log-likelihood value.
-        likelihood_type _likelihood;     // The likelihood functor.
-        stopwatch       _iteration_time; // The time elapsed per iteration.
+        size_t                   _rk;             // The rooted K value.
+        matrix_type              _c;              // The covariance matrix.
+        value_type               _lle;            // The log-likelihood value.
+        likelihood_type          _likelihood;     // The likelihood functor.
+        stopwatch                _iteration_time; // The time per iteration.
+        std::vector<matrix_type> _thread_c;       // The matrix per thread.
     };
 }
 
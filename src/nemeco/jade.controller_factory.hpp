@@ -30,6 +30,9 @@ namespace jade
         /// The controller type.
         typedef basic_controller<value_type> controller_type;
 
+        /// The likelihood type.
+        typedef basic_likelihood<value_type> likelihood_type;
+
         /// The options type.
         typedef basic_options<value_type> options_type;
 
@@ -42,19 +45,42 @@ namespace jade
         /// The treeless controller type.
         typedef basic_treeless_controller<value_type> treeless_controller_type;
 
+        /// The Newick tree type.
+        typedef basic_newick_node<value_type> tree_type;
+
         ///
-        /// \return A new controller.
+        /// \return A new controller for the markers of the settings.
         ///
         static controller_type * create(
                 const settings_type & settings) ///< The program settings.
+        {
+            const likelihood_type likelihood (
+                settings.get_rf(),
+                settings.get_mu());
+
+            return create(settings, likelihood);
+        }
+
+        ///
+        /// \return A new controller for the specified likelihood, e.g. one
+        /// for a resampled set of markers. If the tree is not null, it is the
+        /// tree of the --tin option, which is then not read again.
+        ///
+        static controller_type * create(
+                const settings_type &   settings,   ///< The program settings.
+                const likelihood_type & likelihood, ///< The likelihood.
+                const tree_type *       tree        ///< The parsed tree.
+                    = nullptr)
         {
             const auto & opts = settings.get_options();
             if (opts.is_tin_specified())
-                return new tree_controller_type(settings);
+                return nullptr == tree
+                    ? new tree_controller_type(settings, likelihood)
+                    : new tree_controller_type(settings, likelihood, *tree);
             if (opts.is_ain_specified())
-                return new agi_controller_type(settings);
+                return new agi_controller_type(settings, likelihood);
             else
-                return new treeless_controller_type(settings);
+                return new treeless_controller_type(settings, likelihood);
         }
     };
 }
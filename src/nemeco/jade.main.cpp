@@ -20,6 +20,10 @@ OPTIONS
   --ain,-ai                     indicates the next argument is the path to the
                                 admixture graph input file; this option cannot
                                 be specified with the --cin or --tin options
+  --blocks,-bl                  indicates the next argument is the number of
+                                contiguous blocks of markers used by the
+                                --resample option; if unspecified, this value
+                                defaults to 100; the value must be at least 2
   --cin,-ci                     indicates the next argument is the path to the
                                 initial covariance matrix; this option cannot
                                 be specified with the --ain or --tin options
@@ -41,6 +45,60 @@ OPTIONS
   --max-time,-mt                indicates the next argument is the maximum time
                                 in seconds to execute the algorithm; this value
                                 must be greater than or equal to zero
+  --method,-me                  indicates the next argument is the method used
+                                to optimize the covariance matrix, either
+                                'nelder-mead' (the default) or 'lbfgs'; the
+                                lbfgs method optimizes the Cholesky factor of
+                                the matrix using the gradient of the
+                                likelihood, which keeps the matrix positive
+                                definite but does not require its values to be
+                                positive; with the --ain option, it optimizes
+                                the admixture graph variables using the
+                                derivatives of the matrix entries; this method
+                                cannot be specified with the --speculative or
+                                --tin options
+  --replicates,-rp              indicates the next argument is the number of
+                                bootstrap replicates; if unspecified, this
+                                value defaults to 100
+  --resample,-rs                indicates the next argument is the method used
+                                to estimate the standard errors of the
+                                covariance matrix, either 'jackknife' (one
+                                replicate omitting each block of markers) or
+                                'bootstrap' (replicates drawing the blocks
+                                with replacement); after the optimization, the
+                                model is fitted again for every replicate,
+                                concurrently, with the same method and
+                                options, starting from the optimized
+                                parameters; this option cannot be specified
+                                with the --search option
+  --rout,-ro                    indicates the next argument is the path to the
+                                output file containing the covariance matrix
+                                of every replicate; this option cannot be
+                                specified without the --resample option
+  --search,-se                  indicates the next argument is the method used
+                                to search for the tree topology, either 'nni'
+                                (nearest-neighbor interchanges) or 'spr'
+                                (subtree pruning and regrafting); the search
+                                starts from the --tin tree or, if unspecified,
+                                the neighbor-joining tree of the initial
+                                covariance matrix; each round fits the branch
+                                lengths of every rearrangement of the current
+                                tree with the lbfgs method, concurrently, and
+                                moves to the best one until none improves the
+                                likelihood; the --max-iterations and --max-time
+                                options limit the rounds; this option cannot
+                                be specified with the --ain or --speculative
+                                options
+  --seed,-s                     indicates the next argument is the seed for the
+                                random number generator used by the bootstrap
+  --speculative,-sp             evaluates the reflection, expansion, and
+                                contraction vertices of every Nelder-Mead
+                                iteration together on multiple threads; this
+                                takes the same steps using more evaluations of
+                                the likelihood, which run concurrently; the
+                                option has no effect on the replicates of the
+                                --resample option, which are fitted
+                                concurrently instead
   --tin, -ti                    indicates the next argument is the path to the
                                 file that defines the input tree structure; the
                                 file is in Newick format; this option cannot
@@ -48,12 +106,12 @@ OPTIONS
   --tout, -to                   indicates the next argument is the path to the
                                 output file containing the tree structure; the
                                 file is in Newick format; this option cannot be
-                                specified without the --tin option
+                                specified without the --tin or --search options
 
 DESCRIPTION
   Models the joint distribution of the allele frequencies as a variant of a
   multivariate Gaussian and infers its covariance matrix using the Nelder-Mead
-  optimization method.
+  optimization method or, optionally, the limited-memory BFGS method.
 
   [Notation]
 
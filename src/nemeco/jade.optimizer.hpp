@@ -8,6 +8,9 @@
 #define JADE_OPTIMIZER_HPP__
 
 #include "jade.controller_factory.hpp"
+#include "jade.lbfgs.hpp"
+#include "jade.resampler.hpp"
+#include "jade.tree_search.hpp"
 
 namespace jade
 {
@@ -27,6 +30,12 @@ namespace jade
         /// The controller factory type.
         typedef basic_controller_factory<value_type> controller_factory_type;
 
+        /// The matrix type.
+        typedef basic_matrix<value_type> matrix_type;
+
+        /// The resampler type.
+        typedef basic_resampler<value_type> resampler_type;
+
         /// The settings type.
         typedef basic_settings<value_type> settings_type;
 
@@ -39,6 +48,12 @@ namespace jade
         /// The log arguments type for the simplex.
         typedef typename simplex_type::log_args log_args_type;
 
+        /// The limited-memory BFGS type.
+        typedef basic_lbfgs<value_type> lbfgs_type;
+
+        /// The tree search type.
+        typedef basic_tree_search<value_type> tree_search_type;
+
         ///
         /// Executes the optimizer based on the specified settings.
         ///
@@ -49,21 +64,138 @@ namespace jade
 
             const auto & opts = settings.get_options();
 
+            container_type vertex;
+            if (opts.is_search_specified())
+            {
+                tree_search_type(settings).execute();
+            }
+            else
+            {
+                std::unique_ptr< controller_type > ctrl (
+                    controller_factory_type::create(settings));
+
+                value_type objval;
+                const auto params = _fit(
+                    settings, *ctrl, true, vertex, objval);
+                ctrl->emit_results(opts, params, objval);
+            }
+
+            if (opts.is_resample_specified())
+                _execute_resampling(settings, vertex);
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        // Fits the parameters of the controller using the method specified by
+        // the options and returns the Nelder-Mead parameters; iterations are
+        // logged only if requested. The vertex holds the parameters of the
+        // method from which the fit starts, or it is empty to start from the
+        // initial parameters of the controller; it receives the optimized
+        // parameters of the method.
+        //
+        static container_type _fit(
+                const settings_type & settings,
+                controller_type &     ctrl,
+                const bool            is_logged,
+                container_type &      vertex,
+                value_type &          objval)
+        {
+            return settings.get_options().is_lbfgs()
+                ? _fit_lbfgs(settings, ctrl, is_logged, vertex, objval)
+                : _fit_nelder_mead(settings, ctrl, is_logged, vertex, objval);
+        }
+
+        // --------------------------------------------------------------------
+        static container_type _fit_lbfgs(
+                const settings_type & settings,
+                controller_type &     ctrl,
+                const bool            is_logged,
+                container_type &      vertex,
+                value_type &          objval)
+        {
+            typedef std::chrono::high_resolution_clock clock_type;
+            typedef std::chrono::duration<double>      duration_type;
+
+            const auto & opts = settings.get_options();
+
+            //
+            // Optimize the parameters of the controller, e.g. the Cholesky
+            // factor of the covariance matrix or the admixture graph
+            // variables, using the gradient of the log-likelihood.
             //
-            // Depending upon whether or not the user specified a Newick tree,
-            // construct the appropriate controller for the Nelder-Mead
-            // algorithm, and use it to compute the objective function.
+            const auto objfunc = [&](
+                    const container_type & params,
+                    container_type &       gradient)
+                -> value_type
+            {
+                return ctrl.compute_lbfgs_objfunc(params, gradient);
+            };
+
+            lbfgs_type engine (objfunc, vertex.empty()
+                ? ctrl.init_lbfgs_parameters()
+                : vertex);
+
+            //
+            // Iterate until the objective function no longer decreases or an
+            // exit condition from the program options is reached.
             //
-            std::unique_ptr< controller_type > ctrl (
-                controller_factory_type::create(settings));
-            const auto objfunc = [&](const container_type & params)
-                -> value_type { return ctrl->compute_objfunc(params); };
+            const auto t0 = clock_type::now();
+            for (size_t iteration = 0; ; )
+            {
+                if (opts.is_max_iterations_specified())
+                    if (iteration >= opts.get_max_iterations())
+                        break;
+
+                if (opts.is_max_time_specified())
+                    if (duration_type(clock_type::now() - t0).count() >=
+                            opts.get_max_time())
+                        break;
+
+                const auto previous = engine.get_objval();
+                if (!engine.iterate(objfunc))
+                    break;
+
+                ++iteration;
+                if (is_logged)
+                    ctrl.log_iteration(iteration, -engine.get_objval());
+
+                if (opts.is_epsilon_specified())
+                    if (previous - engine.get_objval() <= opts.get_epsilon())
+                        break;
+            }
+
+            objval = engine.get_objval();
+            vertex = engine.get_vertex();
+            return ctrl.decode_lbfgs_parameters(vertex);
+        }
+
+        // --------------------------------------------------------------------
+        static container_type _fit_nelder_mead(
+                const settings_type & settings,
+                controller_type &     ctrl,
+                const bool            is_logged,
+                container_type &      vertex,
+                value_type &          objval)
+        {
+            const auto & opts = settings.get_options();
+
+            const auto objfunc = [&](
+                    const container_type & params,
+                    const size_t           thread)
+                -> value_type { return ctrl.compute_objfunc(params, thread); };
 
             //
-            // Initialize the Nelder-Mead algorithm.
+            // Initialize the Nelder-Mead algorithm; the objective function is
+            // evaluated for several vertices concurrently if the controller
+            // allows it. Replicates of the resampling are fitted
+            // concurrently, so their evaluations are not.
             //
             typedef typename simplex_type::options options_type;
-            options_type options (ctrl->init_parameters());
+            options_type options (vertex.empty()
+                ? ctrl.init_parameters()
+                : vertex);
+            options.parallel    = is_logged && ctrl.is_thread_safe();
+            options.speculative = options.parallel && opts.is_speculative();
             simplex_type simplex (objfunc, options);
 
             //
@@ -72,8 +204,9 @@ namespace jade
             //
             typedef typename simplex_type::execute_args execute_args_type;
             execute_args_type execute_args;
-            execute_args.user    = ctrl.get();
-            execute_args.logfunc = _logfunc;
+            execute_args.user = &ctrl;
+            if (is_logged)
+                execute_args.logfunc = _logfunc;
             if (opts.is_max_iterations_specified())
                 execute_args.max_iterations = opts.get_max_iterations();
             if (opts.is_max_time_specified())
@@ -84,21 +217,87 @@ namespace jade
             //
             // Perform the minimization.
             //
-            const auto condition = simplex.execute(objfunc, execute_args);
+            simplex.execute(objfunc, execute_args);
 
-            //
-            // Emit results.
-            //
-            ctrl->emit_results(opts, simplex, condition);
+            objval = simplex.get_objval();
+            vertex = simplex.get_vertex();
+            return vertex;
+        }
+
+        // --------------------------------------------------------------------
+        // Fits the covariance matrix for every replicate of the resampling
+        // concurrently, and writes the standard errors and, optionally, the
+        // matrices of the replicates. Each replicate starts from the vertex
+        // fitted to all markers, if any, and the tree of the --tin option is
+        // read only once for all of them.
+        //
+        static void _execute_resampling(
+                const settings_type &  settings,
+                const container_type & vertex)
+        {
+            const auto & opts = settings.get_options();
+
+            const resampler_type resampler (settings);
+            const auto n = resampler.get_replicate_count();
+
+            std::cout
+                << "\nresampling " << n << ' ' << opts.get_resample()
+                << " replicates of " << resampler.get_block_count()
+                << " blocks";
+            if (!opts.is_jackknife())
+                std::cout << " (seed: " << opts.get_seed() << ')';
+            std::cout << std::endl;
+
+            typedef typename controller_factory_type::tree_type tree_type;
+            std::unique_ptr<tree_type> tree;
+            if (opts.is_tin_specified())
+                tree.reset(tree_type::from_file(opts.get_tin()));
+
+            std::vector<matrix_type> replicates (n);
+            parallel::for_each(n, [&](const size_t index, const size_t)
+            {
+                std::unique_ptr< controller_type > ctrl (
+                    controller_factory_type::create(
+                        settings,
+                        resampler.create_likelihood(index),
+                        tree.get()));
+
+                auto       start = vertex;
+                value_type objval;
+                const auto params = _fit(
+                    settings, *ctrl, false, start, objval);
+                replicates[index] = ctrl->create_c(params);
+            });
+
+            std::cout << "[C Standard Errors]\n";
+            resampler.compute_standard_errors(replicates).write_exact(
+                std::cout);
+            std::cout << std::endl;
+
+            if (opts.is_rout_specified())
+            {
+                const auto & rout = opts.get_rout();
+                std::cout << "Writing replicate C matrices to " << rout
+                          << std::endl;
+
+                std::ofstream out (rout);
+                if (!out.good())
+                    throw error() << "failed to create matrices '" << rout
+                                  << "'";
+
+                for (const auto & replicate : replicates)
+                    replicate.write_exact(out);
+            }
         }
 
-    private:
         // --------------------------------------------------------------------
         static void _logfunc(const log_args_type & log_args)
         {
             const auto ctrl = (controller_type *)(log_args.user);
             assert(ctrl != nullptr);
-            ctrl->log_iteration(log_args);
+            ctrl->log_iteration(
+                log_args.iteration,
+                -log_args.simplex->get_objval());
         }
     };
 }
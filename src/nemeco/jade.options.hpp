@@ -21,6 +21,9 @@ namespace jade
         /// The value type.
         typedef TValue value_type;
 
+        /// The random number generator seed type.
+        typedef std::random_device::result_type seed_type;
+
         /// The value assigned with no --epsilon option.
         static constexpr auto no_epsilon =
             std::numeric_limits<value_type>::quiet_NaN();
@@ -33,20 +36,47 @@ namespace jade
         static constexpr auto no_time =
             std::numeric_limits<double>::quiet_NaN();
 
+        /// The name of the Nelder-Mead method.
+        static constexpr const char * nelder_mead = "nelder-mead";
+
+        /// The name of the limited-memory BFGS method.
+        static constexpr const char * lbfgs = "lbfgs";
+
+        /// The name of the nearest-neighbor interchange tree search.
+        static constexpr const char * nni = "nni";
+
+        /// The name of the subtree pruning and regrafting tree search.
+        static constexpr const char * spr = "spr";
+
+        /// The name of the block bootstrap resampling method.
+        static constexpr const char * bootstrap = "bootstrap";
+
+        /// The name of the delete-one-block jackknife resampling method.
+        static constexpr const char * jackknife = "jackknife";
+
         ///
         /// Initializes a new instance of the class.
         ///
         explicit basic_options(
                 args & a) ///< The command-line arguments.
             : _ain            (a.read<std::string>("--ain", "-ai"))
+            , _blocks         (a.read("--blocks", "-bl", size_t(100)))
             , _cin            (a.read<std::string>("--cin", "-ci"))
             , _cout           (a.read<std::string>("--cout", "-co"))
             , _epsilon        (a.read("--epsilon", "-e", no_epsilon))
             , _f_epsilon      (a.read("--f-epsilon", "-fe", value_type(1.0e-6)))
             , _max_iterations (a.read("--max-iterations", "-mi", no_iterations))
             , _max_time       (a.read("--max-time", "-mt", no_time))
+            , _method         (a.read<std::string>(
+                                   "--method", "-me", nelder_mead))
+            , _replicates     (a.read("--replicates", "-rp", size_t(100)))
+            , _resample       (a.read<std::string>("--resample", "-rs"))
+            , _rout           (a.read<std::string>("--rout", "-ro"))
+            , _search         (a.read<std::string>("--search", "-se"))
+            , _seed           (a.read("--seed", "-s", std::random_device()()))
             , _tin            (a.read<std::string>("--tin", "-ti"))
             , _tout           (a.read<std::string>("--tout", "-to"))
+            , _speculative    (a.read_flag("--speculative", "-sp"))
         {
             if (is_epsilon_specified() && _epsilon < value_type(0))
                 throw error()
@@ -69,9 +99,56 @@ namespace jade
                       << "invalid number of iterations for --max-iterations "
                       << "option: " << _max_iterations;
 
-            if (!is_tin_specified() && is_tout_specified())
+            if (_method != nelder_mead && _method != lbfgs)
+                throw error()
+                      << "invalid value for --method option: " << _method;
+
+            if (is_lbfgs() && is_tin_specified())
+                throw error("the lbfgs method cannot be specified with the "
+                            "--tin option");
+
+            if (is_lbfgs() && _speculative)
+                throw error("the lbfgs method cannot be specified with the "
+                            "--speculative option");
+
+            if (is_search_specified() && _search != nni && _search != spr)
+                throw error()
+                      << "invalid value for --search option: " << _search;
+
+            if (is_search_specified() && is_ain_specified())
+                throw error("the --search option cannot be specified with "
+                            "the --ain option");
+
+            if (is_search_specified() && _speculative)
+                throw error("the --search option cannot be specified with "
+                            "the --speculative option");
+
+            if (is_resample_specified() &&
+                    _resample != bootstrap && _resample != jackknife)
+                throw error()
+                      << "invalid value for --resample option: " << _resample;
+
+            if (is_resample_specified() && is_search_specified())
+                throw error("the --resample option cannot be specified with "
+                            "the --search option");
+
+            if (_blocks < 2)
+                throw error()
+                      << "invalid value for --blocks option: " << _blocks;
+
+            if (_replicates == 0)
+                throw error()
+                      << "invalid value for --replicates option: "
+                      << _replicates;
+
+            if (!is_resample_specified() && is_rout_specified())
+                throw error("invalid specification of --rout option "
+                            "without --resample option");
+
+            if (!is_tin_specified() && !is_search_specified() &&
+                    is_tout_specified())
                 throw error("invalid specification of --tout option "
-                            "without --tin option");
+                            "without --tin or --search options");
 
             if ((is_ain_specified() ? 1 : 0) +
                 (is_cin_specified() ? 1 : 0) +
@@ -89,6 +166,14 @@ namespace jade
             return _ain;
         }
 
+        ///
+        /// \return The number of blocks of markers for resampling.
+        ///
+        inline size_t get_blocks() const
+        {
+            return _blocks;
+        }
+
         ///
         /// \return The C input matrix path, if specified.
         ///
@@ -142,6 +227,40 @@ namespace jade
             return _max_time;
         }
 
+        ///
+        /// \return The number of bootstrap replicates.
+        ///
+        inline size_t get_replicates() const
+        {
+            return _replicates;
+        }
+
+        ///
+        /// \return The resampling method.
+        ///
+        inline const std::string & get_resample() const
+        {
+            assert(is_resample_specified());
+            return _resample;
+        }
+
+        ///
+        /// \return The replicate output matrices path, if specified.
+        ///
+        inline const std::string & get_rout() const
+        {
+            assert(is_rout_specified());
+            return _rout;
+        }
+
+        ///
+        /// \return The seed value.
+        ///
+        inline seed_type get_seed() const
+        {
+            return _seed;
+        }
+
         ///
         /// \return The T input tree path, if specified.
         ///
@@ -160,6 +279,23 @@ namespace jade
             return _tout;
         }
 
+        ///
+        /// \return The optimization method.
+        ///
+        inline const std::string & get_method() const
+        {
+            return _method;
+        }
+
+        ///
+        /// \return The tree search method.
+        ///
+        inline const std::string & get_search() const
+        {
+            assert(is_search_specified());
+            return _search;
+        }
+
         ///
         /// \return True if the admixture graph input file was specified.
         ///
@@ -192,6 +328,23 @@ namespace jade
             return !std::isnan(_epsilon);
         }
 
+        ///
+        /// \return True if the resampling method is the delete-one-block
+        /// jackknife.
+        ///
+        inline bool is_jackknife() const
+        {
+            return _resample == jackknife;
+        }
+
+        ///
+        /// \return True if the limited-memory BFGS method was specified.
+        ///
+        inline bool is_lbfgs() const
+        {
+            return _method == lbfgs;
+        }
+
         ///
         /// \return True if the maximum iterations option was specified.
         ///
@@ -208,6 +361,48 @@ namespace jade
             return !std::isnan(_max_time);
         }
 
+        ///
+        /// \return True if the resampling option was specified.
+        ///
+        inline bool is_resample_specified() const
+        {
+            return !_resample.empty();
+        }
+
+        ///
+        /// \return True if the replicate output matrices were specified.
+        ///
+        inline bool is_rout_specified() const
+        {
+            return !_rout.empty();
+        }
+
+        ///
+        /// \return True if the tree search option was specified.
+        ///
+        inline bool is_search_specified() const
+        {
+            return !_search.empty();
+        }
+
+        ///
+        /// \return True if the tree search uses subtree pruning and
+        /// regrafting.
+        ///
+        inline bool is_spr_search() const
+        {
+            return _search == spr;
+        }
+
+        ///
+        /// \return True if the Nelder-Mead trial vertices are evaluated
+        /// speculatively.
+        ///
+        inline bool is_speculative() const
+        {
+            return _speculative;
+        }
+
         ///
         /// \return True if the T input tree was specified.
         ///
@@ -226,14 +421,22 @@ namespace jade
 
     private:
         std::string _ain;
+        size_t      _blocks;
         std::string _cin;
         std::string _cout;
         value_type  _epsilon;
         value_type  _f_epsilon;
         size_t      _max_iterations;
         double      _max_time;
+        std::string _method;
+        size_t      _replicates;
+        std::string _resample;
+        std::string _rout;
+        std::string _search;
+        seed_type   _seed;
         std::string _tin;
         std::string _tout;
+        bool        _speculative;
     };
 }
 
@@ -0,0 +1,172 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_RESAMPLER_HPP__
+#define JADE_RESAMPLER_HPP__
+
+#include "jade.likelihood.hpp"
+#include "jade.settings.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that resamples blocks of markers for the
+    /// delete-one-block jackknife or the block bootstrap. The markers are
+    /// divided into contiguous blocks whose sizes differ by at most one, and
+    /// the sufficient statistics of the likelihood are computed once for each
+    /// block. The likelihood of a replicate is the sum of the statistics of
+    /// its blocks, so creating it takes time independent of the number of
+    /// markers.
+    ///
+    template <typename TValue>
+    class basic_resampler
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The likelihood type.
+        typedef basic_likelihood<value_type> likelihood_type;
+
+        /// The matrix type.
+        typedef basic_matrix<value_type> matrix_type;
+
+        /// The settings type.
+        typedef basic_settings<value_type> settings_type;
+
+        ///
+        /// Initializes a new instance of the class based on the specified
+        /// program settings. For the bootstrap, the blocks of every replicate
+        /// are drawn here, so the replicates do not depend on the order in
+        /// which they are fitted.
+        ///
+        explicit basic_resampler(
+                const settings_type & settings) ///< The program settings.
+            : _is_jackknife (settings.get_options().is_jackknife())
+            , _blocks       ()
+            , _counts       ()
+        {
+            const auto & opts = settings.get_options();
+            const auto & rf   = settings.get_rf();
+            const auto & mu   = settings.get_mu();
+            const auto   J    = rf.get_width();
+            const auto   B    = std::min(opts.get_blocks(), J);
+
+            _blocks.reserve(B);
+            for (size_t b = 0; b < B; b++)
+                _blocks.emplace_back(rf, mu, b * J / B, (b + 1) * J / B);
+
+            //
+            // The jackknife has one replicate for each block, which omits
+            // that block; the bootstrap draws B blocks with replacement for
+            // each replicate.
+            //
+            if (_is_jackknife)
+            {
+                _counts.resize(B * B, 1);
+                for (size_t b = 0; b < B; b++)
+                    _counts[b * B + b] = 0;
+            }
+            else
+            {
+                const auto R = opts.get_replicates();
+                _counts.resize(R * B, 0);
+
+                std::default_random_engine engine (opts.get_seed());
+                std::uniform_int_distribution<size_t> dist (0, B - 1);
+                for (size_t r = 0; r < R; r++)
+                    for (size_t b = 0; b < B; b++)
+                        _counts[r * B + dist(engine)]++;
+            }
+        }
+
+        ///
+        /// Computes the standard error of each cell of the matrices fitted
+        /// for the replicates. For the jackknife, the variance is (n - 1) / n
+        /// times the sum of the squared deviations; for the bootstrap, it is
+        /// the sample variance of the replicates.
+        ///
+        /// \return The matrix of standard errors.
+        ///
+        matrix_type compute_standard_errors(
+                const std::vector<matrix_type> & replicates) ///< The fits.
+                const
+        {
+            assert(replicates.size() == get_replicate_count());
+            assert(!replicates.empty());
+
+            const auto & front = replicates.front();
+            const auto   n     = value_type(replicates.size());
+
+            matrix_type mean (front.get_height(), front.get_width());
+            for (const auto & replicate : replicates)
+                mean += replicate;
+            mean /= n;
+
+            matrix_type se (front.get_height(), front.get_width());
+            for (const auto & replicate : replicates)
+            {
+                for (size_t i = 0; i < se.get_length(); i++)
+                {
+                    const auto delta = replicate[i] - mean[i];
+                    se[i] += delta * delta;
+                }
+            }
+
+            const auto scale = _is_jackknife
+                ? (n - value_type(1)) / n
+                : value_type(1) / std::max(n - value_type(1), value_type(1));
+
+            for (size_t i = 0; i < se.get_length(); i++)
+                se[i] = std::sqrt(se[i] * scale);
+
+            return se;
+        }
+
+        ///
+        /// \return The likelihood of the markers of the specified replicate.
+        ///
+        likelihood_type create_likelihood(
+                const size_t replicate) ///< The replicate index.
+                const
+        {
+            assert(replicate < get_replicate_count());
+
+            const auto B = _blocks.size();
+            const auto counts = _counts.data() + replicate * B;
+
+            likelihood_type likelihood (_blocks.front().get_rk());
+            for (size_t b = 0; b < B; b++)
+                if (counts[b] > 0)
+                    likelihood.add(_blocks[b], counts[b]);
+
+            return likelihood;
+        }
+
+        ///
+        /// \return The number of blocks of markers.
+        ///
+        inline size_t get_block_count() const
+        {
+            return _blocks.size();
+        }
+
+        ///
+        /// \return The number of replicates.
+        ///
+        inline size_t get_replicate_count() const
+        {
+            return _counts.size() / _blocks.size();
+        }
+
+    private:
+        bool                         _is_jackknife; // The method.
+        std::vector<likelihood_type> _blocks;       // The block statistics.
+        std::vector<size_t>          _counts;       // The draws per replicate.
+    };
+}
+
+#endif // JADE_RESAMPLER_HPP__
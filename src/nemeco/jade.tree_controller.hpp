@@ -24,6 +24,9 @@ namespace jade
         /// The value type.
         typedef TValue value_type;
 
+        /// The likelihood type.
+        typedef basic_likelihood<value_type> likelihood_type;
+
         /// The matrix type.
         typedef basic_matrix<value_type> matrix_type;
 
@@ -51,59 +54,54 @@ namespace jade
         /// The container type for the simplex.
         typedef typename simplex_type::container_type container_type;
 
-        /// The exit condition type for the simplex.
-        typedef typename simplex_type::exit_condition_type exit_condition_type;
-
         ///
         /// Initializes a new instance of the class based on the specified
-        /// program settings.
+        /// program settings and likelihood; the tree is read from the file
+        /// specified by the --tin option.
         ///
-        explicit basic_tree_controller(
-                const settings_type & settings) ///< The program settings.
-            : basic_controller<TValue> (settings)
-            , _settings          (settings)
-            , _table             ()
-            , _unrooted_tree_ptr ()
-            , _rerooted_tree     ()
+        basic_tree_controller(
+                const settings_type &   settings,   ///< The program settings.
+                const likelihood_type & likelihood) ///< The likelihood.
+            : basic_tree_controller(
+                settings,
+                likelihood,
+                unrooted_tree_ptr_type(unrooted_tree_type::from_file(
+                    settings.get_options().get_tin())))
         {
-            const auto rk = this->get_rk();
-
-            //
-            // Parse the Newick-formatted file into a tree structure.
-            //
-            _unrooted_tree_ptr.reset(
-                unrooted_tree_type::from_file(
-                    settings.get_options().get_tin()));
-
-            //
-            // Initialize the rerooted tree.
-            //
-            _rerooted_tree.reset(*_unrooted_tree_ptr);
+        }
 
-            //
-            // Loop over the rows and columns of the lower triangle, and for
-            // each cell in the covariance matrix, create a corresponding
-            // table entry.
-            //
-            for (size_t r = 0; r < rk; r++)
-                for (size_t c = 0; c <= r; c++)
-                    _table.emplace_back(_rerooted_tree, r, c);
+        ///
+        /// Initializes a new instance of the class based on the specified
+        /// program settings, likelihood, and tree, which is copied; several
+        /// controllers may share one tree parsed from the file.
+        ///
+        basic_tree_controller(
+                const settings_type &      settings,   ///< The settings.
+                const likelihood_type &    likelihood, ///< The likelihood.
+                const unrooted_tree_type & tree)       ///< The tree.
+            : basic_tree_controller(
+                settings,
+                likelihood,
+                unrooted_tree_ptr_type(tree.reroot()))
+        {
         }
 
         ///
         /// Writes results to standard output and files.
         ///
         virtual void emit_results(
-                const options_type &        opts,      ///< The options.
-                const simplex_type &        simplex,   ///< The simplex.
-                const exit_condition_type & condition) ///< The context.
+                const options_type &   opts,   ///< The options.
+                const container_type & params, ///< The optimized parameters.
+                const value_type       objval) ///< The objective value.
                 override
         {
+            basic_controller<TValue>::emit_results(opts, params, objval);
+
             //
-            // The base class emits the C matrix; this also has the effect of
-            // updating the tree with the optimized lengths.
+            // Copy the optimized lengths into the rerooted tree.
             //
-            basic_controller<TValue>::emit_results(opts, simplex, condition);
+            auto iterator = params.begin();
+            _copy_container_to_tree(_rerooted_tree.get_tree(), iterator);
 
             //
             // Copy values back to the original tree. First reroot the tree to
@@ -152,23 +150,23 @@ namespace jade
         ///
         virtual bool _decode_lower(
                 matrix_type &          dst, ///< The covariance matrix.
-                const container_type & src) ///< The Nelder-Mead container.
+                const container_type & src, ///< The Nelder-Mead container.
+                const size_t)               ///< The thread number.
                 override
         {
             //
-            // Copy the container values into the tree, which will be used to
-            // build the covariance matrix.
-            //
-            auto iterator = src.begin();
-            _copy_container_to_tree(_rerooted_tree.get_tree(), iterator);
-
-            //
-            // Loop over every table entry, which corresponds to the lower
-            // triangle of the covariance matrix; compute and store the sum
+            // Multiply the incidence matrix by the container of lengths; each
+            // cell of the lower triangle of the covariance matrix is the sum
             // of the lengths from the nodes that contribute to its value.
             //
-            for (const auto & entry : _table)
-                dst[entry.i] = entry.p.get_length();
+            const auto lengths = src.data();
+            for (size_t i = 0; i < _cells.size(); i++)
+            {
+                auto sum = value_type(0);
+                for (auto j = _offsets[i]; j < _offsets[i + 1]; j++)
+                    sum += lengths[_columns[j]];
+                dst[_cells[i]] = sum;
+            }
 
             //
             // This method is always successful.
@@ -177,31 +175,61 @@ namespace jade
         }
 
     private:
+        typedef basic_newick_node<value_type> node_type;
+
+        // --------------------------------------------------------------------
+        // Initializes a new instance of the class that owns the specified
+        // tree.
         //
-        // An entry in the table holding the index in the covariance matrix
-        // and the set of nodes that contributes to the cell's value.
-        //
-        struct table_entry
+        basic_tree_controller(
+                const settings_type &   settings,
+                const likelihood_type & likelihood,
+                unrooted_tree_ptr_type  tree)
+            : basic_controller<TValue> (settings, likelihood)
+            , _settings          (settings)
+            , _offsets           ()
+            , _columns           ()
+            , _cells             ()
+            , _unrooted_tree_ptr (std::move(tree))
+            , _rerooted_tree     ()
         {
-            size_t    i; // The index in the matrix.
-            path_type p; // The overlapping tree path.
-
-            inline table_entry(
-                    const rerooted_tree_type & rerooted_tree,
-                    const size_t               row,
-                    const size_t               column)
-                : i (row * rerooted_tree.get_rk() + column)
-                , p (rerooted_tree.get_overlap(row, column))
+            const auto rk = this->get_rk();
+
+            //
+            // Initialize the rerooted tree.
+            //
+            _rerooted_tree.reset(*_unrooted_tree_ptr);
+
+            //
+            // Map the identifier of each node to the index of its length in
+            // the Nelder-Mead container.
+            //
+            std::map<int, size_t> indices;
+            _index_tree(indices, _rerooted_tree.get_tree());
+
+            //
+            // Loop over the rows and columns of the lower triangle, and for
+            // each cell in the covariance matrix, store the indices of the
+            // lengths of the nodes that contribute to its value. Together,
+            // these form a sparse 0/1 incidence matrix in compressed sparse
+            // row format, with one row per cell.
+            //
+            _offsets.push_back(0);
+            for (size_t r = 0; r < rk; r++)
             {
-            }
-        };
+                for (size_t c = 0; c <= r; c++)
+                {
+                    _rerooted_tree.get_overlap(r, c).for_each(
+                        [&](const node_type * const node) -> void
+                    {
+                        _columns.push_back(indices.at(node->get_id()));
+                    });
 
-        //
-        // The type for the vector of table entries used to populate the values
-        // of the covariance matrix based on the lengths in the tree.
-        //
-        typedef std::vector<table_entry>      table_type;
-        typedef basic_newick_node<value_type> node_type;
+                    _offsets.push_back(_columns.size());
+                    _cells.push_back(r * rk + c);
+                }
+            }
+        }
 
         //
         // Recursively copies the values from the specified Nelder-Mead
@@ -243,8 +271,30 @@ namespace jade
             }
         }
 
+        //
+        // Recursively maps the identifiers of the children of the specified
+        // node to the indices of their lengths in the Nelder-Mead container,
+        // which follow the order of _copy_tree_to_container.
+        //
+        // \param indices The map receiving the indices.
+        // \param parent  The parent of the nodes to index.
+        //
+        static void _index_tree(
+                std::map<int, size_t> & indices,
+                const node_type &       parent)
+        {
+            for (auto child : parent.get_children())
+            {
+                const auto index = indices.size();
+                indices[child->get_id()] = index;
+                _index_tree(indices, *child);
+            }
+        }
+
         const settings_type &  _settings;
-        table_type             _table;
+        std::vector<size_t>    _offsets; // The first column of each row.
+        std::vector<size_t>    _columns; // The container index of each entry.
+        std::vector<size_t>    _cells;   // The matrix index of each row.
         unrooted_tree_ptr_type _unrooted_tree_ptr;
         rerooted_tree_type     _rerooted_tree;
     };
@@ -0,0 +1,426 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_TREE_SEARCH_HPP__
+#define JADE_TREE_SEARCH_HPP__
+
+#include "jade.lbfgs.hpp"
+#include "jade.likelihood.hpp"
+#include "jade.neighbor_joining.hpp"
+#include "jade.settings.hpp"
+#include "jade.stopwatch.hpp"
+#include "jade.topology.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that searches for the tree topology and branch
+    /// lengths that maximize the likelihood. The search starts from the tree
+    /// specified by the user or, if none is specified, from the neighbor-
+    /// joining tree of the initial covariance matrix. Each round generates
+    /// the nearest-neighbor interchange (NNI) or subtree pruning and
+    /// regrafting (SPR) rearrangements of the current tree and fits the
+    /// branch lengths of the candidates concurrently using the limited-memory
+    /// BFGS method, starting from the lengths of the current tree. The search
+    /// moves to the best candidate until no candidate improves the
+    /// likelihood. The likelihood of every topology fitted is cached, so no
+    /// topology is fitted twice.
+    ///
+    template <typename TValue>
+    class basic_tree_search
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The limited-memory BFGS type.
+        typedef basic_lbfgs<value_type> lbfgs_type;
+
+        /// The likelihood type.
+        typedef basic_likelihood<value_type> likelihood_type;
+
+        /// The matrix type.
+        typedef basic_matrix<value_type> matrix_type;
+
+        /// The neighbor joining type.
+        typedef basic_neighbor_joining<value_type> neighbor_joining_type;
+
+        /// The Newick node type.
+        typedef basic_newick_node<value_type> node_type;
+
+        /// The options type.
+        typedef basic_options<value_type> options_type;
+
+        /// The settings type.
+        typedef basic_settings<value_type> settings_type;
+
+        /// The topology type.
+        typedef basic_topology<value_type> topology_type;
+
+        /// The container type for the branch lengths.
+        typedef typename topology_type::container_type container_type;
+
+        /// The maximum number of iterations used to fit one topology.
+        static constexpr size_t max_fit_iterations = 1000;
+
+        ///
+        /// Initializes a new instance of the class based on the specified
+        /// program settings.
+        ///
+        explicit basic_tree_search(
+                const settings_type & settings) ///< The program settings.
+            : _settings       (settings)
+            , _likelihood     (settings.get_rf(), settings.get_mu())
+            , _cache          ()
+            , _iteration_time ()
+            , _lle            (0)
+            , _workspaces     (parallel::get_thread_count(),
+                               _workspace(settings.get_rf().get_height()))
+        {
+        }
+
+        ///
+        /// Executes the search and writes the results to standard output and
+        /// files.
+        ///
+        void execute()
+        {
+            typedef std::chrono::high_resolution_clock clock_type;
+            typedef std::chrono::duration<double>      duration_type;
+
+            static const auto inf = std::numeric_limits<value_type>::max();
+
+            const auto & opts = _settings.get_options();
+            const auto   t0   = clock_type::now();
+            const auto   is_expired = [&]() -> bool
+            {
+                return opts.is_max_time_specified() &&
+                    duration_type(clock_type::now() - t0).count() >=
+                        opts.get_max_time();
+            };
+
+            const auto epsilon = opts.is_epsilon_specified()
+                ? opts.get_epsilon()
+                : value_type(0);
+
+            topology_type current (_init_topology());
+            auto objval = _fit(current, 0);
+            _cache[current.get_key()] = objval;
+            _lle = -objval;
+
+            for (size_t iteration = 0; ; )
+            {
+                if (opts.is_max_iterations_specified())
+                    if (iteration >= opts.get_max_iterations())
+                        break;
+
+                if (is_expired())
+                    break;
+
+                //
+                // Gather the rearrangements of the current tree that have
+                // not been fitted in this or a previous round.
+                //
+                auto neighbors = opts.is_spr_search()
+                    ? current.get_spr_neighbors()
+                    : current.get_nni_neighbors();
+
+                std::vector<topology_type> candidates;
+                for (auto & neighbor : neighbors)
+                    if (_cache.emplace(neighbor.get_key(), inf).second)
+                        candidates.push_back(std::move(neighbor));
+
+                if (candidates.empty())
+                    break;
+
+                //
+                // Fit the candidates concurrently; candidates not started
+                // before the time expires are not fitted or cached.
+                //
+                std::vector<value_type> objvals (candidates.size(), inf);
+                std::vector<char>       fitted  (candidates.size(), 0);
+                parallel::for_each(candidates.size(), [&](
+                        const size_t index,
+                        const size_t thread) -> void
+                {
+                    if (is_expired())
+                        return;
+
+                    objvals[index] = _fit(candidates[index], thread);
+                    fitted[index]  = 1;
+                });
+
+                size_t best = 0;
+                for (size_t i = 0; i < candidates.size(); i++)
+                {
+                    const auto key = candidates[i].get_key();
+                    if (fitted[i] == 0)
+                        _cache.erase(key);
+                    else
+                        _cache[key] = objvals[i];
+
+                    if (objvals[i] < objvals[best])
+                        best = i;
+                }
+
+                if (!(objvals[best] < objval - epsilon))
+                    break;
+
+                current = std::move(candidates[best]);
+                objval  = objvals[best];
+                _log_iteration(++iteration, -objval);
+            }
+
+            _emit_results(current, objval);
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        // Scratch space used by one thread to evaluate the likelihood.
+        //
+        struct _workspace
+        {
+            matrix_type c;     // The covariance matrix.
+            matrix_type c_inv; // The inverted covariance matrix.
+            matrix_type g;     // The gradient with respect to C.
+
+            explicit _workspace(const size_t rk)
+                : c     (rk, rk)
+                , c_inv (rk, rk)
+                , g     (rk, rk)
+            {
+            }
+        };
+
+        // --------------------------------------------------------------------
+        // Computes the negation of the log-likelihood for the specified
+        // branch lengths and its gradient.
+        //
+        value_type _compute_objfunc(
+                const topology_type &  tree,
+                _workspace &           w,
+                const container_type & lengths,
+                container_type &       gradient)
+                const
+        {
+            static const auto inf = std::numeric_limits<value_type>::max();
+
+            //
+            // As with the tree controller, variance and covariance values
+            // must be positive, and the matrix must be positive definite.
+            //
+            tree.compute_covariance(lengths, w.c);
+            for (size_t row = 0; row < w.c.get_height(); row++)
+                for (size_t col = 0; col <= row; col++)
+                    if (w.c(row, col) <= value_type(0))
+                        return inf;
+
+            w.c_inv = w.c;
+            value_type log_c_det;
+            if (!w.c_inv.invert(log_c_det))
+                return inf;
+
+            const auto lle = _likelihood.compute_gradient(
+                w.c_inv, log_c_det, w.g);
+
+            tree.compute_gradient(w.g, gradient);
+            for (auto & value : gradient)
+                value = -value;
+
+            return -lle;
+        }
+
+        // --------------------------------------------------------------------
+        // Writes the log-likelihood, the covariance matrix, the tree, and the
+        // number of topologies fitted.
+        //
+        void _emit_results(
+                const topology_type & tree,
+                const value_type      objval)
+                const
+        {
+            const auto & opts = _settings.get_options();
+            const auto   rk   = tree.get_rk();
+
+            std::cout
+                << "\nlog likelihood = "
+                << -objval
+                << "\ntopologies fitted = "
+                << _cache.size()
+                << std::endl;
+
+            matrix_type c (rk, rk);
+            tree.compute_covariance(tree.get_lengths(), c);
+
+            if (opts.is_cout_specified())
+            {
+                const auto & cout = opts.get_cout();
+                std::cout << "Writing C matrix to " << cout << std::endl;
+
+                std::ofstream out (cout);
+                if (!out.good())
+                    throw error() << "failed to create matrix '" << cout << "'";
+
+                c.write_exact(out);
+            }
+            else
+            {
+                std::cout << "[C Matrix]\n";
+                c.write_exact(std::cout);
+                std::cout << std::endl;
+            }
+
+            if (opts.is_tout_specified())
+            {
+                const auto & tout = opts.get_tout();
+                std::cout << "Writing tree to " << tout << std::endl;
+
+                std::ofstream out (tout);
+                if (!out.good())
+                    throw error() << "failed to create tree '" << tout << "'";
+
+                tree.write(out);
+                out << std::endl;
+            }
+            else
+            {
+                std::cout << "\n[Tree]\n" << tree.str() << std::endl;
+            }
+        }
+
+        // --------------------------------------------------------------------
+        // Fits the branch lengths of the specified tree, starting from its
+        // current lengths, and returns the negation of the log-likelihood.
+        //
+        value_type _fit(
+                topology_type & tree,
+                const size_t    thread)
+                const
+        {
+            static const auto inf = std::numeric_limits<value_type>::max();
+
+            assert(thread < _workspaces.size());
+            auto & w = _workspaces[thread];
+
+            const auto objfunc = [&](
+                    const container_type & lengths,
+                    container_type &       gradient)
+                -> value_type
+            {
+                return _compute_objfunc(tree, w, lengths, gradient);
+            };
+
+            //
+            // If the current lengths are unacceptable, start from equal
+            // lengths instead, which always produce a positive-definite
+            // matrix.
+            //
+            lbfgs_type engine (objfunc, tree.get_lengths());
+            if (!(engine.get_objval() < inf))
+                engine = lbfgs_type(objfunc, _init_lengths(tree));
+
+            const auto & opts = _settings.get_options();
+            for (size_t i = 0; i < max_fit_iterations; i++)
+            {
+                const auto objval = engine.get_objval();
+                if (!engine.iterate(objfunc))
+                    break;
+
+                if (opts.is_epsilon_specified())
+                    if (objval - engine.get_objval() <= opts.get_epsilon())
+                        break;
+            }
+
+            tree.set_lengths(engine.get_vertex());
+            return engine.get_objval();
+        }
+
+        // --------------------------------------------------------------------
+        // Returns equal lengths for every edge that produce the same sum of
+        // variances as the initial covariance matrix or, if that matrix is
+        // unspecified, an average variance of one.
+        //
+        container_type _init_lengths(const topology_type & tree) const
+        {
+            const auto & c  = _settings.get_c();
+            const auto   rk = tree.get_rk();
+
+            auto trace = value_type(0);
+            for (size_t i = 0; i < rk; i++)
+                trace += c(i, i);
+            if (!(trace > value_type(0)))
+                trace = value_type(rk);
+
+            //
+            // With unit lengths, each variance is the depth of its leaf in
+            // edges; scale the lengths so the sum of the variances matches.
+            //
+            container_type lengths (tree.get_lengths().size(), value_type(1));
+            matrix_type    depths  (rk, rk);
+            tree.compute_covariance(lengths, depths);
+
+            auto total = value_type(0);
+            for (size_t i = 0; i < rk; i++)
+                total += depths(i, i);
+
+            std::fill(lengths.begin(), lengths.end(), trace / total);
+            return lengths;
+        }
+
+        // --------------------------------------------------------------------
+        // Returns the tree specified by the user or, if none is specified, the
+        // neighbor-joining tree of the initial covariance matrix.
+        //
+        topology_type _init_topology() const
+        {
+            const auto & opts = _settings.get_options();
+
+            if (opts.is_tin_specified())
+            {
+                const std::unique_ptr<node_type> tree (
+                    node_type::from_file(opts.get_tin()));
+                return topology_type(*tree);
+            }
+
+            const neighbor_joining_type nj (
+                neighbor_joining_type::create_distances(_settings.get_c()));
+            std::istringstream in (nj.str());
+            const node_type tree (in);
+            return topology_type(tree);
+        }
+
+        // --------------------------------------------------------------------
+        // Logs one round of the search; the change in the log-likelihood of
+        // the first round is relative to the initial tree.
+        //
+        void _log_iteration(const size_t iteration, const value_type lle)
+        {
+            const auto dlle = lle - _lle;
+
+            std::ostringstream line;
+            line << iteration
+                 << std::fixed << std::setprecision(6)
+                 << '\t' << _iteration_time;
+            matrix_type::set_high_precision(line);
+            line << '\t' << dlle << '\t' << lle;
+            std::cout << line.str() << std::endl;
+
+            _lle = lle;
+            _iteration_time = stopwatch();
+        }
+
+        typedef std::map<std::string, value_type> _cache_type;
+
+        const settings_type &           _settings;       // The settings.
+        likelihood_type                 _likelihood;     // The likelihood.
+        _cache_type                     _cache;          // Fitted topologies.
+        stopwatch                       _iteration_time; // Time per round.
+        value_type                      _lle;            // Log-likelihood.
+        mutable std::vector<_workspace> _workspaces;     // Thread scratch.
+    };
+}
+
+#endif // JADE_TREE_SEARCH_HPP__
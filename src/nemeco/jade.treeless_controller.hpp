@@ -24,6 +24,9 @@ namespace jade
         /// The value type.
         typedef TValue value_type;
 
+        /// The likelihood type.
+        typedef basic_likelihood<value_type> likelihood_type;
+
         /// The matrix type.
         typedef basic_matrix<value_type> matrix_type;
 
@@ -37,63 +40,109 @@ namespace jade
 
         ///
         /// Initializes a new instance of the class based on the specified
-        /// program settings.
+        /// program settings and likelihood.
         ///
-        explicit basic_treeless_controller(
-                const settings_type & settings) ///< The program settings.
-            : basic_controller<TValue> (settings)
+        basic_treeless_controller(
+                const settings_type &   settings,   ///< The program settings.
+                const likelihood_type & likelihood) ///< The likelihood.
+            : basic_controller<TValue> (settings, likelihood)
+            , _l                       (this->get_rk(), this->get_rk())
+            , _cc                      (this->get_rk(), this->get_rk())
+            , _gradient                (this->get_rk(), this->get_rk())
         {
         }
 
-        // --------------------------------------------------------------------
-        virtual container_type init_parameters() override
+        ///
+        /// Computes the objective function for parameters that encode the
+        /// lower Cholesky factor L of the covariance matrix, C = L * L'. The
+        /// parameters hold the lower triangle of L column by column, with the
+        /// logarithms of the diagonal values, so every set of parameters
+        /// encodes a positive-definite matrix.
+        ///
+        /// \return The negation of the log likelihood.
+        ///
+        value_type compute_lbfgs_objfunc(
+                const container_type & params,   ///< The parameters.
+                container_type &       gradient) ///< The gradient.
+                override
         {
-            const auto & c  = this->get_c();
-            const auto   rk = this->get_rk();
-            assert(c.get_height() == rk);
+            const auto rk = this->get_rk();
 
-            //
-            // The container contains the lower-right triangle of data,
-            // including the diagonal. This comes to RK * RK (the total number
-            // of items in the matrix), subtract RK (the number of items in the
-            // diagonal), divide by two (only half of these elements), plus RK
-            // (the number of items in the diagonal).
-            //
-            container_type params;
-            params.reserve(rk + ((rk * rk) - rk) / 2);
+            _decode_cholesky(params, _l);
+            _multiply_cholesky(_l, _cc);
 
-            //
-            // Pointers to the start and end of the first row. Note the
-            // covariance matrix is symmetric.
-            //
-            auto src_ptr = c.get_data();
-            auto src_end = c.get_data() + rk;
+            const auto lle = this->_compute_gradient(_cc, _gradient);
+            if (!(lle > -std::numeric_limits<value_type>::max()))
+                return std::numeric_limits<value_type>::max();
 
             //
-            // Loop over every row/column.
+            // The gradient with respect to L is 2 * G * L, where G is the
+            // gradient with respect to C; the chain rule scales the diagonal
+            // values by L because they are stored as logarithms. Negate the
+            // gradient because the objective function is the negation of
+            // the log-likelihood.
             //
-            for (size_t i = 0; i < rk; i++)
+            gradient.resize(params.size());
+            size_t k = 0;
+            for (size_t col = 0; col < rk; col++)
             {
-                //
-                // Skip the columns before the diagonal.
-                //
-                src_ptr += i;
+                for (size_t row = col; row < rk; row++)
+                {
+                    auto sum = value_type(0);
+                    for (size_t i = col; i < rk; i++)
+                        sum += _gradient(row, i) * _l(i, col);
 
-                //
-                // Copy all columns from the diagonal to the end of the row.
-                //
-                while (src_ptr != src_end)
-                    params.push_back(*src_ptr++);
+                    gradient[k++] = value_type(-2) * sum *
+                        (row == col ? _l(row, col) : value_type(1));
+                }
+            }
 
-                //
-                // Advance the next end-of-row RK elements ahead.
-                //
-                src_end += rk;
+            return -lle;
+        }
+
+        ///
+        /// \return The Nelder-Mead container for the covariance matrix
+        /// encoded by the specified Cholesky parameters.
+        ///
+        container_type decode_lbfgs_parameters(
+                const container_type & params) ///< The parameters.
+                override
+        {
+            _decode_cholesky(params, _l);
+            _multiply_cholesky(_l, _cc);
+            return _encode(_cc, this->get_rk());
+        }
+
+        ///
+        /// \return The Cholesky parameters for the initial covariance matrix.
+        ///
+        container_type init_lbfgs_parameters() override
+        {
+            const auto rk = this->get_rk();
+
+            matrix_type l (this->get_c());
+            if (!l.potrf_lower())
+                throw error("the initial covariance matrix is not positive "
+                            "definite");
+
+            container_type params;
+            params.reserve(rk + ((rk * rk) - rk) / 2);
+            for (size_t col = 0; col < rk; col++)
+            {
+                params.push_back(std::log(l(col, col)));
+                for (size_t row = col + 1; row < rk; row++)
+                    params.push_back(l(row, col));
             }
 
             return params;
         }
 
+        // --------------------------------------------------------------------
+        virtual container_type init_parameters() override
+        {
+            return _encode(this->get_c(), this->get_rk());
+        }
+
     protected:
         ///
         /// Decodes the specified Nelder-Mead container and stores the result
@@ -103,7 +152,8 @@ namespace jade
         ///
         virtual bool _decode_lower(
                 matrix_type &          dst, ///< The covariance matrix.
-                const container_type & src) ///< The Nelder-Mead container.
+                const container_type & src, ///< The Nelder-Mead container.
+                const size_t)               ///< The thread number.
                 override
         {
             const auto rk = this->get_rk();
@@ -154,6 +204,103 @@ namespace jade
             //
             return true;
         }
+
+    private:
+        // --------------------------------------------------------------------
+        // Decodes the Cholesky parameters into the lower triangle of L; the
+        // upper triangle is zero.
+        //
+        void _decode_cholesky(
+                const container_type & params,
+                matrix_type &          l)
+                const
+        {
+            const auto rk = this->get_rk();
+            assert(params.size() == rk + ((rk * rk) - rk) / 2);
+
+            l.set_values(value_type(0));
+            size_t k = 0;
+            for (size_t col = 0; col < rk; col++)
+            {
+                l(col, col) = std::exp(params[k++]);
+                for (size_t row = col + 1; row < rk; row++)
+                    l(row, col) = params[k++];
+            }
+        }
+
+        // --------------------------------------------------------------------
+        static container_type _encode(
+                const matrix_type & c,
+                const size_t        rk)
+        {
+            assert(c.get_height() == rk);
+
+            //
+            // The container contains the lower-right triangle of data,
+            // including the diagonal. This comes to RK * RK (the total number
+            // of items in the matrix), subtract RK (the number of items in the
+            // diagonal), divide by two (only half of these elements), plus RK
+            // (the number of items in the diagonal).
+            //
+            container_type params;
+            params.reserve(rk + ((rk * rk) - rk) / 2);
+
+            //
+            // Pointers to the start and end of the first row. Note the
+            // covariance matrix is symmetric.
+            //
+            auto src_ptr = c.get_data();
+            auto src_end = c.get_data() + rk;
+
+            //
+            // Loop over every row/column.
+            //
+            for (size_t i = 0; i < rk; i++)
+            {
+                //
+                // Skip the columns before the diagonal.
+                //
+                src_ptr += i;
+
+                //
+                // Copy all columns from the diagonal to the end of the row.
+                //
+                while (src_ptr != src_end)
+                    params.push_back(*src_ptr++);
+
+                //
+                // Advance the next end-of-row RK elements ahead.
+                //
+                src_end += rk;
+            }
+
+            return params;
+        }
+
+        // --------------------------------------------------------------------
+        // Computes C = L * L' for the lower triangular matrix L.
+        //
+        static void _multiply_cholesky(
+                const matrix_type & l,
+                matrix_type &       c)
+        {
+            const auto rk = l.get_height();
+            for (size_t row = 0; row < rk; row++)
+            {
+                for (size_t col = 0; col <= row; col++)
+                {
+                    auto sum = value_type(0);
+                    for (size_t i = 0; i <= col; i++)
+                        sum += l(row, i) * l(col, i);
+                    c(row, col) = sum;
+                    c(col, row) = sum;
+                }
+            }
+        }
+
+        matrix_type _l;        // The Cholesky factor.
+        matrix_type _cc;       // The covariance matrix for the factor.
+        matrix_type _gradient; // The gradient with respect to C.
     };
 }
 
@@ -95,14 +95,35 @@ namespace jade
             , _q     (q)
             , _f     (f)
             , _y     (_init_y(years, q))
-            , _f_j   (f.get_height(), 1)
+            , _qt    (q.create_transpose())
+            , _yq    (_init_yq(_y, _qt))
         {
             verification_type::validate_gqf_sizes(g, q, f);
         }
 
+        ///
+        /// Computes the log likelihood of the specified column for a delta
+        /// and its first and second derivatives with respect to the delta.
+        ///
+        /// \return The log likelihood.
+        ///
+        value_type compute_lle(
+                const size_t     j,  ///< The column index.
+                const value_type d,  ///< The delta.
+                value_type &     d1, ///< The first derivative.
+                value_type &     d2) ///< The second derivative.
+                const
+        {
+            scratch s (_y.get_length());
+            _load_j(j, s);
+            _init_terms_j(j, s);
+            return _compute_lle_j(j, d, true, s, d1, d2);
+        }
+
         ///
         /// Executes the algorithm using the specified action for the output
-        /// of each column.
+        /// of each column. The columns are processed in blocks on multiple
+        /// threads, and the action is invoked in column order.
         ///
         /// \param output_action The action to perform for the output; this
         ///                      function or lambda must take one argument of
@@ -113,51 +134,36 @@ namespace jade
         {
             const auto J = _g.get_width();
 
-            for (size_t j = 0; j < J; j++)
-            {
-                value_type col_min = 0;
-                value_type col_max = 0;
-                _f.get_min_max_column(j, col_min, col_max);
-
-                const auto range_low  = -col_max;
-                const auto range_high = value_type(1.0) - col_min;
-
-                output out;
-                out.delta      = value_type(0.0);
-                out.global_lle = _compute_lle_j(j, out.delta);
-                out.local_lle  = out.global_lle;
+            const auto thread_count = parallel::get_thread_count();
+            const auto wave_length  = block_length *
+                std::max(size_t(1), 4 * thread_count);
 
-                static const auto tol = value_type(0.000001);
-                static const auto phi = value_type(0.5 * (sqrt(5.0) + 1.0));
+            const scratch        prototype (_y.get_length());
+            std::vector<scratch> scratches (thread_count, prototype);
+            std::vector<output>  outputs;
 
-                const auto dr_phi = (range_high - range_low) / phi;
+            for (size_t first = 0; first < J; first += wave_length)
+            {
+                const auto last  = std::min(J, first + wave_length);
+                const auto count = (last - first + block_length - 1)
+                                 / block_length;
 
-                auto a = range_low;
-                auto b = range_high;
-                auto c = range_high - dr_phi;
-                auto d = range_low  + dr_phi;
+                outputs.resize(last - first);
 
-                while (std::abs(c - d) > tol)
+                parallel::for_each(count, [&](
+                        const size_t block,
+                        const size_t thread)
                 {
-                    if (_compute_lle_j(j, c) > _compute_lle_j(j, d))
-                        b = d;
-                    else
-                        a = c;
-
-                    c = b - (b - a) / phi;
-                    d = a + (b - a) / phi;
-                }
+                    const auto block_first = first + block * block_length;
+                    const auto block_last  = std::min(
+                        last, block_first + block_length);
 
-                const auto gss_delta = value_type(0.5) * (a + b);
-                const auto gss_lle   = _compute_lle_j(j, gss_delta);
-
-                if (gss_lle > out.local_lle)
-                {
-                    out.delta     = gss_delta;
-                    out.local_lle = gss_lle;
-                }
+                    for (auto j = block_first; j < block_last; j++)
+                        outputs[j - first] = _scan_j(j, scratches[thread]);
+                });
 
-                output_action(out);
+                for (const auto & out : outputs)
+                    output_action(out);
             }
         }
 
@@ -181,104 +187,321 @@ namespace jade
 
             neoscan.execute([](const output & out)
             {
-                std::cout << out.to_string() << std::endl;
+                std::cout << out.to_string() << '\n';
             });
+
+            std::cout.flush();
         }
 
     private:
         typedef basic_discrete_genotype_matrix<value_type>   dgm_type;
         typedef basic_likelihood_genotype_matrix<value_type> lgm_type;
 
+        /// The number of columns in each block processed by one thread.
+        static const size_t block_length = 256;
+
         // --------------------------------------------------------------------
-        void _compute_ab_ij(
-                const size_t   i,
-                value_type   & a_ij,
-                value_type   & b_ij)
+        // Scratch space for one thread; the genotypes of the current column
+        // are copied into contiguous memory, and the likelihood terms are
+        // accumulated for all individuals at once. For deltas inside the
+        // open interval (lower, upper), no frequency of the column is
+        // clamped, and the terms are linear in the delta.
+        //
+        struct scratch
+        {
+            std::vector<value_type> a;    // [I] q_i . f_ij
+            std::vector<value_type> b;    // [I] q_i . (1 - f_ij)
+            std::vector<value_type> da;   // [I] derivative of a_ij
+            std::vector<value_type> qf;   // [I] q_i . f_j
+            std::vector<value_type> qb;   // [I] q_i . (1 - f_j)
+            std::vector<value_type> g0;   // [I] g_ij, or AA likelihood
+            std::vector<value_type> g1;   // [I] Aa likelihood
+            std::vector<value_type> g2;   // [I] aa likelihood
+            value_type              lower;
+            value_type              upper;
+
+            explicit scratch(const size_t I)
+                : a     (I)
+                , b     (I)
+                , da    (I)
+                , qf    (I)
+                , qb    (I)
+                , g0    (I)
+                , g1    (I)
+                , g2    (I)
+                , lower (0)
+                , upper (0)
+            {
+            }
+        };
+
+        // --------------------------------------------------------------------
+        // Computes the terms a_ij and b_ij for all individuals, where the
+        // frequencies of column j are shifted by d times the scaled year of
+        // each individual, and optionally the derivative of a_ij with respect
+        // to d; the derivative of b_ij is its negation, and frequencies that
+        // are clamped do not contribute to it. If no frequency is clamped,
+        // the terms are computed from the precomputed dot products in one
+        // pass over the individuals; otherwise, the loops over individuals
+        // are innermost so the compiler can vectorize them.
+        //
+        void _compute_ab_j(
+                const size_t     j,
+                const value_type d,
+                const bool       derivative,
+                scratch &        s)
                 const
         {
-            assert(i < _y.get_length());
+            static const auto epsilon       = value_type(1.0e-6);
+            static const auto lower_epsilon = value_type(0.0) + epsilon;
+            static const auto upper_epsilon = value_type(1.0) - epsilon;
+
+            const auto I = _qt.get_width();
+            const auto K = _qt.get_height();
+
+            assert(j < _f.get_width());
 
-            const auto K = _f_j.get_length();
+            const auto y  = _y.get_data();
+            const auto a  = s.a.data();
+            const auto b  = s.b.data();
+            const auto da = s.da.data();
+
+            if (d > s.lower && d < s.upper)
+            {
+                const auto yq = _yq.get_data();
+                const auto qf = s.qf.data();
+                const auto qb = s.qb.data();
+
+                for (size_t i = 0; i < I; i++)
+                {
+                    const auto t = d * yq[i];
+                    a[i] = qf[i] + t;
+                    b[i] = qb[i] - t;
+                }
+
+                if (derivative)
+                    std::copy(yq, yq + I, da);
+
+                return;
+            }
 
-            auto       q_src   = _q.get_data(i, 0);
-            auto       f_j_src = _f_j.get_data();
-            const auto f_j_end = _f_j.get_data() + K;
+            std::fill(s.a.begin(), s.a.end(), value_type(0.0));
+            std::fill(s.b.begin(), s.b.end(), value_type(0.0));
 
-            a_ij = value_type(0.0);
-            b_ij = value_type(0.0);
+            if (derivative)
+                std::fill(s.da.begin(), s.da.end(), value_type(0.0));
 
-            while (f_j_src != f_j_end)
+            for (size_t k = 0; k < K; k++)
             {
-                const auto q_ik = *q_src++;
-                const auto f_kj = *f_j_src++;
+                const auto f_kj = _f(k, j);
+                const auto q_k  = _qt.get_data(k, 0);
 
-                a_ij += q_ik * f_kj;
-                b_ij += q_ik * (value_type(1.0) - f_kj);
+                for (size_t i = 0; i < I; i++)
+                {
+                    const auto f_ij = std::min(std::max(
+                          lower_epsilon,
+                          f_kj + d * y[i]),
+                          upper_epsilon);
+
+                    a[i] += q_k[i] * f_ij;
+                    b[i] += q_k[i] * (value_type(1.0) - f_ij);
+                }
+
+                if (!derivative)
+                    continue;
+
+                for (size_t i = 0; i < I; i++)
+                {
+                    const auto x_ij = f_kj + d * y[i];
+                    da[i] += x_ij > lower_epsilon && x_ij < upper_epsilon
+                        ? q_k[i] * y[i]
+                        : value_type(0.0);
+                }
             }
         }
 
         // --------------------------------------------------------------------
-        void _compute_f_j(
+        // Computes the log likelihood of column j for the specified delta;
+        // the genotypes must have been loaded into the scratch space.
+        //
+        value_type _compute_lle_j(
                 const size_t     j,
-                const size_t     i,
-                const value_type d)
+                const value_type d,
+                scratch &        s)
                 const
         {
-            static const auto epsilon       = value_type(1.0e-6);
-            static const auto lower_epsilon = value_type(0.0) + epsilon;
-            static const auto upper_epsilon = value_type(1.0) - epsilon;
+            value_type d1, d2;
+            return _compute_lle_j(j, d, false, s, d1, d2);
+        }
+
+        // --------------------------------------------------------------------
+        // Computes the log likelihood of column j for the specified delta
+        // and, optionally, its first and second derivatives with respect to
+        // the delta. Because a_ij is piecewise linear in the delta, the second
+        // derivative includes only the curvature of the logarithms.
+        //
+        value_type _compute_lle_j(
+                const size_t     j,
+                const value_type d,
+                const bool       derivative,
+                scratch &        s,
+                value_type &     d1,
+                value_type &     d2)
+                const
+        {
+            const auto I = _qt.get_width();
+
+            assert(d >= value_type(-1.0) && d <= value_type(+1.0));
 
-            const auto J = _f.get_width();
-            const auto K = _f.get_height();
+            _compute_ab_j(j, d, derivative, s);
 
-            assert(j < J);
-            assert(i < _y.get_height());
+            const auto a  = s.a.data();
+            const auto b  = s.b.data();
+            const auto da = s.da.data();
 
-            auto       src_ptr = _f.get_data(0, j);
-            auto       dst_ptr = _f_j.get_data();
-            const auto dst_end = _f_j.get_data() + K;
-            const auto dy      = d * _y[i];
+            auto lle_all = value_type(0.0);
 
-            while (dst_ptr != dst_end)
+            d1 = value_type(0.0);
+            d2 = value_type(0.0);
+
+            if (_g.is_dgm())
             {
-                *dst_ptr++ = std::min(std::max(
-                      lower_epsilon,
-                      *src_ptr + dy),
-                      upper_epsilon);
-                src_ptr += J;
+                const auto g = s.g0.data();
+
+                for (size_t i = 0; i < I; i++)
+                {
+                    const auto g_ij = g[i];
+                    if (g_ij < value_type(0.0))
+                        continue;
+
+                    lle_all += std::log(a[i]) * g_ij;
+                    lle_all += std::log(b[i]) * (value_type(2.0) - g_ij);
+
+                    if (!derivative)
+                        continue;
+
+                    const auto u = da[i] / a[i];
+                    const auto v = da[i] / b[i];
+                    d1 += g_ij * u - (value_type(2.0) - g_ij) * v;
+                    d2 -= g_ij * u * u + (value_type(2.0) - g_ij) * v * v;
+                }
+
+                return lle_all;
             }
+
+            const auto g_AA = s.g0.data();
+            const auto g_Aa = s.g1.data();
+            const auto g_aa = s.g2.data();
+
+            for (size_t i = 0; i < I; i++)
+            {
+                if (_y[i] < value_type(0.0))
+                    continue;
+
+                const auto h = (g_AA[i] * a[i] * a[i]) +
+                               (g_aa[i] * b[i] * b[i]) +
+                               (g_Aa[i] * a[i] * b[i] * value_type(2.0));
+
+                lle_all += std::log(h);
+
+                if (!derivative)
+                    continue;
+
+                const auto dh = value_type(2.0) * da[i] * (
+                    g_AA[i] * a[i] - g_aa[i] * b[i] +
+                    g_Aa[i] * (b[i] - a[i]));
+
+                const auto d2h = value_type(2.0) * da[i] * da[i] *
+                    (g_AA[i] + g_aa[i] - value_type(2.0) * g_Aa[i]);
+
+                d1 += dh / h;
+                d2 += (d2h * h - dh * dh) / (h * h);
+            }
+
+            return lle_all;
         }
 
         // --------------------------------------------------------------------
-        value_type _compute_lle_j(const size_t j, const value_type d) const
+        // Computes the dot products of the Q matrix with the frequencies of
+        // column j and their complements, and the interval of deltas for
+        // which no frequency of the column is clamped; the interval is empty
+        // if a frequency is clamped even when the delta is zero.
+        //
+        void _init_terms_j(const size_t j, scratch & s) const
         {
-            const auto I = _q.get_height();
+            static const auto epsilon       = value_type(1.0e-6);
+            static const auto lower_epsilon = value_type(0.0) + epsilon;
+            static const auto upper_epsilon = value_type(1.0) - epsilon;
 
-            assert(d >= value_type(-1.0) && d <= value_type(+1.0));
-            assert(j < _g.get_width());
+            const auto I = _qt.get_width();
+            const auto K = _qt.get_height();
 
-            if (_g.is_dgm())
+            std::fill(s.qf.begin(), s.qf.end(), value_type(0.0));
+            std::fill(s.qb.begin(), s.qb.end(), value_type(0.0));
+
+            auto f_min = value_type(1.0);
+            auto f_max = value_type(0.0);
+
+            for (size_t k = 0; k < K; k++)
             {
-                const auto & g = _g.to_dgm().get_matrix();
+                const auto f_kj = _f(k, j);
+                const auto q_k  = _qt.get_data(k, 0);
 
-                auto lle_all = value_type(0.0);
+                f_min = std::min(f_min, f_kj);
+                f_max = std::max(f_max, f_kj);
 
                 for (size_t i = 0; i < I; i++)
                 {
-                    value_type g_ij;
-                    if (!_try_convert(g(i, j), g_ij))
-                        continue;
+                    s.qf[i] += q_k[i] * f_kj;
+                    s.qb[i] += q_k[i] * (value_type(1.0) - f_kj);
+                }
+            }
 
-                    _compute_f_j(j, i, d);
+            s.lower = value_type(-1.0);
+            s.upper = value_type(+1.0);
 
-                    value_type a_ij, b_ij;
-                    _compute_ab_ij(i, a_ij, b_ij);
+            if (!(f_min > lower_epsilon && f_max < upper_epsilon))
+            {
+                s.lower = s.upper = value_type(0.0);
+                return;
+            }
 
-                    lle_all += std::log(a_ij) * g_ij;
-                    lle_all += std::log(b_ij) * (value_type(2.0) - g_ij);
+            for (size_t i = 0; i < I; i++)
+            {
+                const auto y = _y[i];
+
+                if (y > value_type(0.0))
+                {
+                    s.lower = std::max(s.lower, (lower_epsilon - f_min) / y);
+                    s.upper = std::min(s.upper, (upper_epsilon - f_max) / y);
                 }
+                else if (y < value_type(0.0))
+                {
+                    s.lower = std::max(s.lower, (upper_epsilon - f_max) / y);
+                    s.upper = std::min(s.upper, (lower_epsilon - f_min) / y);
+                }
+            }
+        }
 
-                return lle_all;
+        // --------------------------------------------------------------------
+        // Copies the genotypes of column j into the scratch space; missing
+        // discrete genotypes are stored as negative values.
+        //
+        void _load_j(const size_t j, scratch & s) const
+        {
+            const auto I = _qt.get_width();
+
+            assert(j < _g.get_width());
+
+            if (_g.is_dgm())
+            {
+                const auto & g = _g.to_dgm().get_matrix();
+
+                for (size_t i = 0; i < I; i++)
+                    if (!_try_convert(g(i, j), s.g0[i]))
+                        s.g0[i] = value_type(-1.0);
+
+                return;
             }
 
             if (_g.is_lgm())
@@ -288,32 +511,153 @@ namespace jade
                 const auto & g_Aa = g.get_major_minor_matrix();
                 const auto & g_aa = g.get_minor_minor_matrix();
 
-                auto lle_all = value_type(0.0);
-
                 for (size_t i = 0; i < I; i++)
                 {
-                    if (_y[i] < value_type(0.0))
-                        continue;
+                    s.g0[i] = g_AA(i, j);
+                    s.g1[i] = g_Aa(i, j);
+                    s.g2[i] = g_aa(i, j);
+                }
+
+                return;
+            }
+
+            throw jade::error("unsupported genotype matrix");
+        }
+
+        // --------------------------------------------------------------------
+        // Finds the delta of column j that maximizes the likelihood. Clamped
+        // frequencies introduce kinks that can create several local maxima,
+        // so a golden-section search first narrows the range to a small
+        // bracket, and Newton's method then locates the maximum inside it.
+        //
+        output _scan_j(const size_t j, scratch & s) const
+        {
+            static const size_t max_iterations = 100;
+            static const auto   switch_width   = value_type(0.01);
+            static const auto   tol            = value_type(0.000001);
+            static const auto   phi            = value_type(0.5 * (
+                sqrt(5.0) + 1.0));
+
+            _load_j(j, s);
+            _init_terms_j(j, s);
+
+            value_type col_min = 0;
+            value_type col_max = 0;
+            _f.get_min_max_column(j, col_min, col_max);
+
+            const auto range_low  = -col_max;
+            const auto range_high = value_type(1.0) - col_min;
+
+            output out;
+            out.delta      = value_type(0.0);
+            out.global_lle = _compute_lle_j(j, out.delta, s);
+            out.local_lle  = out.global_lle;
+
+            const auto update = [&out](
+                    const value_type x,
+                    const value_type lle)
+            {
+                if (lle > out.local_lle)
+                {
+                    out.delta     = x;
+                    out.local_lle = lle;
+                }
+            };
+
+            //
+            // Narrow the range with a golden-section search, which reuses one
+            // of its two interior points at each step, until the bracket is
+            // small enough for Newton's method.
+            //
+            auto a  = range_low;
+            auto b  = range_high;
+            auto c  = b - (b - a) / phi;
+            auto d  = a + (b - a) / phi;
+            auto fc = _compute_lle_j(j, c, s);
+            auto fd = _compute_lle_j(j, d, s);
+
+            while (b - a > switch_width && std::abs(c - d) > tol)
+            {
+                if (fc > fd)
+                {
+                    b  = d;
+                    d  = c;
+                    fd = fc;
+                    c  = b - (b - a) / phi;
+                    fc = _compute_lle_j(j, c, s);
+                }
+                else
+                {
+                    a  = c;
+                    c  = d;
+                    fc = fd;
+                    d  = a + (b - a) / phi;
+                    fd = _compute_lle_j(j, d, s);
+                }
+            }
 
-                    const auto g_AA_ij = g_AA(i, j);
-                    const auto g_Aa_ij = g_Aa(i, j);
-                    const auto g_aa_ij = g_aa(i, j);
+            update(c, fc);
+            update(d, fd);
 
-                    _compute_f_j(j, i, d);
+            //
+            // Refine the best point with Newton's method using the analytic
+            // derivatives. The sign of the first derivative at each point
+            // narrows the bracket, and a Newton step is taken when the
+            // likelihood is concave and the step stays inside the bracket;
+            // otherwise, the bracket is bisected, which handles the kinks
+            // where frequencies become clamped.
+            //
+            auto x = fc > fd ? c : d;
 
-                    value_type a_ij, b_ij;
-                    _compute_ab_ij(i, a_ij, b_ij);
+            for (size_t iteration = 0; iteration < max_iterations; iteration++)
+            {
+                value_type d1, d2;
+                update(x, _compute_lle_j(j, x, true, s, d1, d2));
+
+                if (d1 > value_type(0.0))
+                    a = x;
+                else if (d1 < value_type(0.0))
+                    b = x;
+                else
+                    break;
+
+                auto next = x - d1 / d2;
+                if (!(d2 < value_type(0.0) && next > a && next < b))
+                    next = value_type(0.5) * (a + b);
 
-                    lle_all += std::log(
-                                (g_AA_ij * a_ij * a_ij) +
-                                (g_aa_ij * b_ij * b_ij) +
-                                (g_Aa_ij * a_ij * b_ij * value_type(2.0)));
+                if (std::abs(next - x) <= tol || b - a <= tol)
+                {
+                    update(next, _compute_lle_j(j, next, s));
+                    break;
                 }
 
-                return lle_all;
+                x = next;
             }
 
-            throw jade::error("unsupported genotype matrix");
+            return out;
+        }
+
+        // --------------------------------------------------------------------
+        // Returns the derivatives of the terms a_ij with respect to the delta
+        // when no frequency is clamped, i.e. y_i times the sum of row i of Q.
+        //
+        static matrix_type _init_yq(
+                const matrix_type & y,  ///< The scaled years.
+                const matrix_type & qt) ///< The transposed Q matrix.
+        {
+            const auto I = qt.get_width();
+            const auto K = qt.get_height();
+
+            matrix_type out (I, 1);
+
+            for (size_t k = 0; k < K; k++)
+                for (size_t i = 0; i < I; i++)
+                    out[i] += qt(k, i);
+
+            for (size_t i = 0; i < I; i++)
+                out[i] *= y[i];
+
+            return out;
         }
 
         // --------------------------------------------------------------------
@@ -382,9 +726,8 @@ namespace jade
         const matrix_type          & _q;     // [I x K]
         const matrix_type          & _f;     // [K x J]
         const matrix_type            _y;     // [I x 1]
-
-        // scratch space
-        mutable matrix_type _f_j; // [K x 1]
+        const matrix_type            _qt;    // [K x I]
+        const matrix_type            _yq;    // [I x 1]
     };
 }
 
@@ -0,0 +1,118 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_ACTIVE_SET_SOLVER_HPP__
+#define JADE_ACTIVE_SET_SOLVER_HPP__
+
+#include "jade.qp_solver.hpp"
+#include "jade.qpas.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that solves quadratic subproblems using the
+    /// active set algorithm. The bounds are the rows -delta_k <= -lower_k and
+    /// delta_k <= upper_k of the coefficients matrix, and the sum is a row of
+    /// ones in the fixed active set.
+    ///
+    template <typename TValue>
+    class basic_active_set_solver
+        : public basic_qp_solver<TValue>
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The matrix type.
+        typedef basic_matrix<value_type> matrix_type;
+
+        /// The QPAS type.
+        typedef basic_qpas<value_type> qpas_type;
+
+        /// The subproblem type.
+        typedef typename basic_qp_solver<value_type>::subproblem
+            subproblem_type;
+
+        ///
+        /// Initializes a new instance of the class.
+        ///
+        basic_active_set_solver()
+            : _b_vec            ()
+            , _coefficients_mat ()
+            , _fixed_active_set ()
+        {
+        }
+
+        ///
+        /// Solves the specified subproblem and stores the change into the
+        /// [K x 1] delta vector.
+        ///
+        virtual void solve(
+                const subproblem_type & problem,   ///< The subproblem.
+                matrix_type &           delta_vec) ///< The change.
+                override
+        {
+            const auto K = problem.hessian_mat.get_height();
+            assert(delta_vec.is_size(K, 1));
+
+            _init_constraints(K, problem.is_sum_fixed);
+
+            for (size_t k = 0; k < K; k++)
+            {
+                _b_vec[k]     = -problem.lower_vec[k];
+                _b_vec[K + k] = problem.upper_vec[k];
+            }
+
+            std::vector<size_t> active_set { 0 };
+            delta_vec.set_values(value_type(0));
+            delta_vec[0] = -_b_vec[0];
+
+            qpas_type::loop_over_active_set(
+                    _b_vec,
+                    _coefficients_mat,
+                    problem.hessian_mat,
+                    problem.derivative_vec,
+                    _fixed_active_set,
+                    active_set,
+                    delta_vec);
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        // Creates the coefficients matrix and the fixed active set for the
+        // specified number of components, unless they already exist.
+        //
+        void _init_constraints(const size_t K, const bool is_sum_fixed)
+        {
+            const auto height = K + K + (is_sum_fixed ? 1 : 0);
+            if (_coefficients_mat.is_size(height, K))
+                return;
+
+            _b_vec = matrix_type(height, 1);
+            _coefficients_mat = matrix_type(height, K);
+            _fixed_active_set.clear();
+
+            for (size_t k = 0; k < K; k++)
+            {
+                _coefficients_mat(k,     k) = value_type(-1.0);
+                _coefficients_mat(K + k, k) = value_type(+1.0);
+            }
+
+            if (is_sum_fixed)
+            {
+                for (size_t k = 0; k < K; k++)
+                    _coefficients_mat(K + K, k) = value_type(1.0);
+                _fixed_active_set.push_back(K + K);
+            }
+        }
+
+        matrix_type         _b_vec;
+        matrix_type         _coefficients_mat;
+        std::vector<size_t> _fixed_active_set;
+    };
+}
+
+#endif // JADE_ACTIVE_SET_SOLVER_HPP__
@@ -78,19 +78,27 @@ namespace jade
 
                 const auto P = 1 + *std::max_element(_a.begin(), _a.end());
 
-                _b.reserve(P);
+                _b.resize(P);
 
-                for (size_t p = 0; p < P; p++)
+                //
+                // One reader parses all of the vectors, so the remainder of
+                // the text is not read again for each of them.
+                //
                 {
-                    try
-                    {
-                        _b.emplace_back(in);
-                    }
-                    catch (const std::exception & e)
+                    text_reader reader (in);
+
+                    for (size_t p = 0; p < P; p++)
                     {
-                        throw error()
-                            << "error reading B vector for population index "
-                            << p << ": " << e.what();
+                        try
+                        {
+                            _b[p].read(reader);
+                        }
+                        catch (const std::exception & e)
+                        {
+                            throw error()
+                                << "error reading B vector for population "
+                                << "index " << p << ": " << e.what();
+                        }
                     }
                 }
 
@@ -0,0 +1,300 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_INTERIOR_POINT_SOLVER_HPP__
+#define JADE_INTERIOR_POINT_SOLVER_HPP__
+
+#include "jade.qp_solver.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that solves quadratic subproblems using a
+    /// primal-dual interior point method. The subproblem is the minimization
+    /// of delta' * G * delta / 2 + g' * delta, where G = -H and g = -d, and
+    /// each iteration takes a Newton step toward a point on the central path
+    /// of the barrier problem. The dual variables of the bounds are
+    /// eliminated from the Newton equations, so each iteration solves one
+    /// dense system with one row for every component that is not fixed by
+    /// its bounds, plus one row for the sum.
+    ///
+    template <typename TValue>
+    class basic_interior_point_solver
+        : public basic_qp_solver<TValue>
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The matrix type.
+        typedef basic_matrix<value_type> matrix_type;
+
+        /// The subproblem type.
+        typedef typename basic_qp_solver<value_type>::subproblem
+            subproblem_type;
+
+        ///
+        /// Initializes a new instance of the class.
+        ///
+        basic_interior_point_solver()
+            : _free ()
+            , _g    ()
+            , _x    ()
+            , _zl   ()
+            , _zu   ()
+            , _dx   ()
+            , _dzl  ()
+            , _dzu  ()
+            , _rd   ()
+            , _kkt  ()
+        {
+        }
+
+        ///
+        /// Solves the specified subproblem and stores the change into the
+        /// [K x 1] delta vector.
+        ///
+        virtual void solve(
+                const subproblem_type & problem,   ///< The subproblem.
+                matrix_type &           delta_vec) ///< The change.
+                override
+        {
+            static const auto epsilon = value_type(1.0e-12);
+
+            const auto & h = problem.hessian_mat;
+            const auto & l = problem.lower_vec;
+            const auto & u = problem.upper_vec;
+
+            const auto K = h.get_height();
+            assert(delta_vec.is_size(K, 1));
+
+            //
+            // Components with equal bounds are fixed and removed from the
+            // problem; the sum of the free components must cancel them.
+            //
+            _free.clear();
+            auto sum_rhs = value_type(0);
+            for (size_t k = 0; k < K; k++)
+            {
+                if (u[k] - l[k] > epsilon)
+                {
+                    _free.push_back(k);
+                    delta_vec[k] = value_type(0);
+                    continue;
+                }
+
+                delta_vec[k] = (l[k] + u[k]) / value_type(2);
+                sum_rhs -= delta_vec[k];
+            }
+
+            const auto n = _free.size();
+            if (n == 0)
+                return;
+
+            if (!_iterate(problem, delta_vec, sum_rhs))
+            {
+                delta_vec.set_values(value_type(0));
+                return;
+            }
+
+            for (size_t i = 0; i < n; i++)
+                delta_vec[_free[i]] = _x[i];
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        // Performs the Newton iterations for the free components, assuming
+        // the delta vector contains the values of the fixed components and
+        // zeros for the free components. Returns false if a Newton system is
+        // singular, the iterations diverge, or the iterations run out before
+        // the residuals and the duality gap are small enough.
+        //
+        bool _iterate(
+                const subproblem_type & problem,
+                const matrix_type &     delta_vec,
+                const value_type        sum_rhs)
+        {
+            static const size_t max_iterations = 100;
+            static const auto   sigma          = value_type(0.1);
+            static const auto   tolerance      = value_type(1.0e-10);
+
+            const auto & d = problem.derivative_vec;
+            const auto & h = problem.hessian_mat;
+            const auto & l = problem.lower_vec;
+            const auto & u = problem.upper_vec;
+
+            const auto n = _free.size();
+            const auto m = n + (problem.is_sum_fixed ? 1 : 0);
+
+            _g .resize(n, 1);
+            _x .resize(n, 1);
+            _zl.resize(n, 1);
+            _zu.resize(n, 1);
+            _dx .resize(n, 1);
+            _dzl.resize(n, 1);
+            _dzu.resize(n, 1);
+            _rd .resize(n, 1);
+            _kkt.resize(m, m + 1);
+
+            //
+            // Start at the midpoints of the bounds, and fold the fixed
+            // components into the linear term.
+            //
+            auto g_norm = value_type(0);
+            for (size_t i = 0; i < n; i++)
+            {
+                const auto fi = _free[i];
+                auto g = -d[fi];
+                for (size_t k = 0; k < h.get_height(); k++)
+                    g -= h(fi, k) * delta_vec[k];
+
+                _g[i]  = g;
+                _x[i]  = (l[fi] + u[fi]) / value_type(2);
+                _zl[i] = value_type(1);
+                _zu[i] = value_type(1);
+                g_norm = std::max(g_norm, std::fabs(g));
+            }
+
+            auto y = value_type(0);
+
+            for (size_t iteration = 0; iteration < max_iterations; iteration++)
+            {
+                //
+                // Compute the dual and primal residuals and the duality gap.
+                //
+                auto rd_norm = value_type(0);
+                auto rp      = -sum_rhs;
+                auto gap     = value_type(0);
+                for (size_t i = 0; i < n; i++)
+                {
+                    const auto fi = _free[i];
+                    auto rd = _g[i] - _zl[i] + _zu[i] + y;
+                    for (size_t j = 0; j < n; j++)
+                        rd -= h(fi, _free[j]) * _x[j];
+
+                    _rd[i]   = rd;
+                    rd_norm  = std::max(rd_norm, std::fabs(rd));
+                    rp      += _x[i];
+                    gap     += (_x[i] - l[fi]) * _zl[i]
+                             + (u[fi] - _x[i]) * _zu[i];
+                }
+
+                if (!problem.is_sum_fixed)
+                    rp = value_type(0);
+
+                gap /= value_type(2 * n);
+
+                const auto scale = tolerance * (value_type(1) + g_norm);
+                if (gap < scale && rd_norm < scale && std::fabs(rp) < tolerance)
+                    return true;
+
+                //
+                // Assemble and solve the reduced Newton system for the
+                // change to delta and to the multiplier of the sum.
+                //
+                const auto mu = sigma * gap;
+                for (size_t i = 0; i < n; i++)
+                {
+                    const auto fi = _free[i];
+                    const auto s  = _x[i] - l[fi];
+                    const auto t  = u[fi] - _x[i];
+
+                    for (size_t j = 0; j < n; j++)
+                        _kkt(i, j) = -h(fi, _free[j]);
+                    _kkt(i, i) += _zl[i] / s + _zu[i] / t;
+                    _kkt(i, m)  = -_rd[i]
+                                + (mu / s - _zl[i])
+                                - (mu / t - _zu[i]);
+
+                    if (problem.is_sum_fixed)
+                    {
+                        _kkt(i, n) = value_type(1);
+                        _kkt(n, i) = value_type(1);
+                    }
+                }
+
+                if (problem.is_sum_fixed)
+                {
+                    _kkt(n, n) = value_type(0);
+                    _kkt(n, m) = -rp;
+                }
+
+                if (!_kkt.gesv())
+                    return false;
+
+                //
+                // Recover the changes to the dual variables, and step as far
+                // as possible toward the boundary of the feasible region.
+                //
+                auto alpha = value_type(1);
+                for (size_t i = 0; i < n; i++)
+                {
+                    const auto fi  = _free[i];
+                    const auto s   = _x[i] - l[fi];
+                    const auto t   = u[fi] - _x[i];
+                    const auto dx  = _kkt(i, m);
+                    if (!std::isfinite(dx))
+                        return false;
+
+                    const auto dzl = (mu - s * _zl[i] - _zl[i] * dx) / s;
+                    const auto dzu = (mu - t * _zu[i] + _zu[i] * dx) / t;
+
+                    _dx [i] = dx;
+                    _dzl[i] = dzl;
+                    _dzu[i] = dzu;
+
+                    _ratio(s,      +dx, alpha);
+                    _ratio(t,      -dx, alpha);
+                    _ratio(_zl[i], dzl, alpha);
+                    _ratio(_zu[i], dzu, alpha);
+                }
+
+                const auto dy = problem.is_sum_fixed
+                    ? _kkt(n, m)
+                    : value_type(0);
+
+                for (size_t i = 0; i < n; i++)
+                {
+                    _x[i]  += alpha * _dx[i];
+                    _zl[i] += alpha * _dzl[i];
+                    _zu[i] += alpha * _dzu[i];
+                }
+
+                y += alpha * dy;
+            }
+
+            return false;
+        }
+
+        // --------------------------------------------------------------------
+        // Limits the step length so a positive value remains positive after
+        // moving a fraction of the way to the boundary.
+        //
+        static void _ratio(
+                const value_type value,
+                const value_type change,
+                value_type &     alpha)
+        {
+            static const auto fraction = value_type(0.99);
+
+            if (change < value_type(0))
+                alpha = std::min(alpha, -fraction * value / change);
+        }
+
+        std::vector<size_t> _free;
+        matrix_type         _g;
+        matrix_type         _x;
+        matrix_type         _zl;
+        matrix_type         _zu;
+        matrix_type         _dx;
+        matrix_type         _dzl;
+        matrix_type         _dzu;
+        matrix_type         _rd;
+        matrix_type         _kkt;
+    };
+}
+
+#endif // JADE_INTERIOR_POINT_SOLVER_HPP__
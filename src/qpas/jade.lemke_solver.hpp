@@ -0,0 +1,281 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_LEMKE_SOLVER_HPP__
+#define JADE_LEMKE_SOLVER_HPP__
+
+#include "jade.lemke.hpp"
+#include "jade.qp_solver.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that solves quadratic subproblems using
+    /// Lemke's algorithm. Components with equal bounds are fixed and removed
+    /// from the problem, and the others are shifted by their lower bounds, y
+    /// = delta - lower, so y >= 0 is implied by the linear complementarity
+    /// problem; the upper bounds are the constraints -y >= lower - upper. If
+    /// the sum is fixed, the last component is eliminated with the sum
+    /// rather than constraining the sum with a pair of opposite
+    /// inequalities, which are degenerate for the pivoting; the bounds of
+    /// the last component then become constraints on the sum of the others.
+    /// The subproblems of nearly fixed frequencies are ill-conditioned and
+    /// have legitimately small pivots, so the pivot tolerance is lowered
+    /// from the default of the algorithm.
+    ///
+    template <typename TValue>
+    class basic_lemke_solver
+        : public basic_qp_solver<TValue>
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The matrix type.
+        typedef basic_matrix<value_type> matrix_type;
+
+        /// The Lemke type.
+        typedef basic_lemke<value_type> lemke_type;
+
+        /// The subproblem type.
+        typedef typename basic_qp_solver<value_type>::subproblem
+            subproblem_type;
+
+        ///
+        /// Initializes a new instance of the class.
+        ///
+        basic_lemke_solver()
+            : _free  ()
+            , _rows  ()
+            , _g_mat ()
+            , _g_vec ()
+            , _a_mat ()
+            , _b_vec ()
+            , _c_vec ()
+            , _q_mat ()
+            , _lemke (value_type(1.0e-12))
+        {
+        }
+
+        ///
+        /// Solves the specified subproblem and stores the change into the
+        /// [K x 1] delta vector.
+        ///
+        virtual void solve(
+                const subproblem_type & problem,   ///< The subproblem.
+                matrix_type &           delta_vec) ///< The change.
+                override
+        {
+            static const auto epsilon = value_type(1.0e-12);
+
+            const auto & d = problem.derivative_vec;
+            const auto & h = problem.hessian_mat;
+            const auto & l = problem.lower_vec;
+            const auto & u = problem.upper_vec;
+
+            const auto K = h.get_height();
+            assert(delta_vec.is_size(K, 1));
+
+            //
+            // Assign the fixed components, and compute the sum of the
+            // shifted free components, S = -sum(fixed) - sum(lower).
+            //
+            _free.clear();
+            auto sum = value_type(0);
+            for (size_t k = 0; k < K; k++)
+            {
+                if (u[k] - l[k] > epsilon)
+                {
+                    _free.push_back(k);
+                    delta_vec[k] = value_type(0);
+                    sum -= l[k];
+                    continue;
+                }
+
+                delta_vec[k] = (l[k] + u[k]) / value_type(2);
+                sum -= delta_vec[k];
+            }
+
+            const auto n = _free.size();
+            if (n == 0)
+                return;
+
+            if (problem.is_sum_fixed && n == 1)
+            {
+                delta_vec[_free[0]] = sum + l[_free[0]];
+                return;
+            }
+
+            //
+            // Minimize y' * G * y / 2 + c' * y, where G = -H and c = -(d +
+            // H * lower) for the free components, and the fixed components
+            // contribute to d.
+            //
+            _g_mat.resize(n, n);
+            _g_vec.resize(n, 1);
+            for (size_t i = 0; i < n; i++)
+            {
+                const auto fi = _free[i];
+
+                auto c = d[fi];
+                for (size_t k = 0; k < K; k++)
+                    c += h(fi, k) * delta_vec[k];
+
+                for (size_t j = 0; j < n; j++)
+                {
+                    const auto fj = _free[j];
+                    _g_mat(i, j) = -h(fi, fj);
+                    c += h(fi, fj) * l[fj];
+                }
+
+                _g_vec[i] = -c;
+            }
+
+            //
+            // Scale the objective so the largest value of G is one; the
+            // Hessians of nearly fixed frequencies are otherwise so large
+            // that the pivots fall below the tolerance of the algorithm.
+            //
+            auto g_max = value_type(0);
+            for (size_t i = 0; i < n * n; i++)
+                g_max = std::max(g_max, std::fabs(_g_mat[i]));
+            if (g_max > value_type(0))
+            {
+                _g_mat *= value_type(1) / g_max;
+                _g_vec *= value_type(1) / g_max;
+            }
+
+            const auto m = problem.is_sum_fixed ? n - 1 : n;
+            _init_constraints(problem, m, sum);
+
+            if (problem.is_sum_fixed)
+            {
+                //
+                // Substitute y_r = S - sum(z), where r is the last component
+                // and z are the others.
+                //
+                const auto r   = m;
+                const auto grr = _g_mat(r, r);
+                const auto cr  = _g_vec[r] + grr * sum;
+                _q_mat.resize(m, m);
+                _c_vec.resize(m, 1);
+                for (size_t i = 0; i < m; i++)
+                {
+                    const auto gir = _g_mat(i, r);
+                    for (size_t j = 0; j < m; j++)
+                        _q_mat(i, j) = _g_mat(i, j) - gir - _g_mat(r, j)
+                                     + grr;
+                    _c_vec[i] = _g_vec[i] + gir * sum - cr;
+                }
+            }
+
+            _lemke.reset(
+                    problem.is_sum_fixed ? _q_mat : _g_mat,
+                    _a_mat,
+                    problem.is_sum_fixed ? _c_vec : _g_vec,
+                    _b_vec);
+
+            //
+            // If q of the linear complementarity problem is nonnegative, the
+            // algorithm does not start, and z = 0 is the solution.
+            //
+            if (!_lemke.solve() && _lemke.get_state() !=
+                    lemke_type::state::aborted_initialization)
+            {
+                delta_vec.set_values(value_type(0));
+                return;
+            }
+
+            const auto z_vec = _lemke.get_output();
+            for (size_t i = 0; i < m; i++)
+            {
+                delta_vec[_free[i]] = z_vec[i] + l[_free[i]];
+                sum -= z_vec[i];
+            }
+
+            if (problem.is_sum_fixed)
+                delta_vec[_free[m]] = sum + l[_free[m]];
+        }
+
+    private:
+        // --------------------------------------------------------------------
+        // Creates the A matrix and b vector for the upper bounds of the m
+        // variables and, if the sum is fixed, the bounds of the eliminated
+        // variable. With a fixed sum, S, the variables are nonnegative and
+        // sum to at most S, so upper bounds of at least S are redundant;
+        // they are omitted because they tie in the ratio tests.
+        //
+        void _init_constraints(
+                const subproblem_type & problem,
+                const size_t            m,
+                const value_type        sum)
+        {
+            const auto & l = problem.lower_vec;
+            const auto & u = problem.upper_vec;
+
+            _rows.clear();
+            for (size_t i = 0; i < m; i++)
+            {
+                const auto width = u[_free[i]] - l[_free[i]];
+                if (!problem.is_sum_fixed || !_is_redundant(width, sum))
+                    _rows.push_back(-width);
+            }
+
+            const auto bounded = _rows.size();
+            if (problem.is_sum_fixed)
+            {
+                const auto width = u[_free[m]] - l[_free[m]];
+                _rows.push_back(-sum);
+                if (!_is_redundant(width, sum))
+                    _rows.push_back(sum - width);
+            }
+
+            _a_mat.resize(_rows.size(), m);
+            _b_vec.resize(_rows.size(), 1);
+            _a_mat.set_values(value_type(0));
+
+            for (size_t row = 0, i = 0; i < m; i++)
+            {
+                const auto width = u[_free[i]] - l[_free[i]];
+                if (!problem.is_sum_fixed || !_is_redundant(width, sum))
+                    _a_mat(row++, i) = value_type(-1);
+            }
+
+            for (size_t row = bounded; row < _rows.size(); row++)
+            {
+                const auto sign = row == bounded
+                    ? value_type(-1)
+                    : value_type(+1);
+                for (size_t i = 0; i < m; i++)
+                    _a_mat(row, i) = sign;
+            }
+
+            for (size_t row = 0; row < _rows.size(); row++)
+                _b_vec[row] = _rows[row];
+        }
+
+        // --------------------------------------------------------------------
+        static bool _is_redundant(
+                const value_type width,
+                const value_type sum)
+        {
+            static const auto epsilon = value_type(1.0e-12);
+            return width + epsilon >= sum;
+        }
+
+        std::vector<size_t>     _free;
+        std::vector<value_type> _rows;
+        matrix_type             _g_mat;
+        matrix_type             _g_vec;
+        matrix_type             _a_mat;
+        matrix_type             _b_vec;
+        matrix_type             _c_vec;
+        matrix_type             _q_mat;
+        lemke_type              _lemke;
+    };
+}
+
+#endif // JADE_LEMKE_SOLVER_HPP__
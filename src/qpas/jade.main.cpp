@@ -15,10 +15,17 @@ namespace
 ARGUMENTS
   g-matrix                      the path to a genotype matrix; the format of
                                 the file is determined based on the extension,
-                                .dgm (discrete genotype matrix) or
-                                .lgm (likelihood genotype matrix)
+                                .dgm (discrete genotype matrix),
+                                .lgm (likelihood genotype matrix), or
+                                .vcf (genotype likelihoods in VCF format)
 
 OPTIONS
+  --benchmark,-bm               indicates the program should perform one
+                                iteration from the initial Q and F matrices
+                                with each solver and write the number of
+                                subproblems, the average microseconds per
+                                subproblem, and the resulting log-likelihood
+                                for each solver, instead of optimizing
   --epsilon,-e                  indicates the next argument is the epsilon
                                 value; i.e. the minimum difference between
                                 likelihood calculations per iteration; this
@@ -65,6 +72,11 @@ OPTIONS
                                 computed Q matrix
   --seed,-s                     indicates the next argument is the seed for the
                                 random number generator
+  --solver,-so                  indicates the next argument is the name of the
+                                algorithm that solves the quadratic
+                                subproblems; the name is one of active-set,
+                                interior-point, or lemke; if unspecified, this
+                                value defaults to active-set
 
   At least one of --ksize, --qin, --fin, or --force must be specified in order
   to determine the number of components (K).
@@ -90,7 +102,9 @@ DESCRIPTION
   solve this inequality- and equality-constraint quadratic optimization
   problem, first we derive the first and second differentials for lnP1(Q, F)
   with respect to values in Q and F, separately.  Then we incorporate the
-  active set algorithm [Murty 1988].
+  active set algorithm [Murty 1988].  Alternatively, the subproblems may be
+  solved as linear complementarity problems with Lemke's algorithm, or with a
+  primal-dual interior point method.
 
   [Command-Line Output]
 
@@ -242,10 +256,16 @@ int main(const int argc, const char * argv[])
         typedef jade::basic_optimizer<value_type> optimizer_type;
 
         settings_type settings (args);
-        optimizer_type::execute(
-                settings,
-                settings.get_q(),
-                settings.get_f());
+        if (settings.get_options().is_benchmark())
+            optimizer_type::execute_benchmark(
+                    settings,
+                    settings.get_q(),
+                    settings.get_f());
+        else
+            optimizer_type::execute(
+                    settings,
+                    settings.get_q(),
+                    settings.get_f());
 
         return EXIT_SUCCESS;
     }
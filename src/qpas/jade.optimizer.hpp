@@ -8,6 +8,7 @@
 #define JADE_OPTIMIZER_HPP__
 
 #include "jade.improver.hpp"
+#include "jade.qp_solver_factory.hpp"
 #include "jade.settings.hpp"
 #include "jade.stopwatch.hpp"
 
@@ -35,6 +36,12 @@ namespace jade
         /// The improver type.
         typedef basic_improver<value_type> improver_type;
 
+        /// The solver type.
+        typedef basic_qp_solver<value_type> qp_solver_type;
+
+        /// The solver factory type.
+        typedef basic_qp_solver_factory<value_type> qp_solver_factory_type;
+
         ///
         /// Executes the optimization process.
         ///
@@ -58,6 +65,9 @@ namespace jade
             const auto & g    = settings.get_g();
             const auto   frb  = opts.is_frb();
 
+            std::unique_ptr<qp_solver_type> solver (
+                qp_solver_factory_type::create(opts.get_solver()));
+
             const stopwatch sw1;
 
             matrix_type fb (fa.get_height(), fa.get_width());
@@ -83,14 +93,16 @@ namespace jade
 
                 if (!opts.is_fixed_q())
                 {
-                    q = improver_type::improve_q(g, q, fa, fb, qfa, qfb, fg);
+                    q = improver_type::improve_q(
+                        g, q, fa, fb, qfa, qfb, fg, *solver);
                     matrix_type::gemm(q, fa, qfa);
                     matrix_type::gemm(q, fb, qfb);
                 }
 
                 if (!opts.is_fixed_f())
                 {
-                    fa = improver_type::improve_f(g, q, fa, fb, qfa, qfb, fif, frb);
+                    fa = improver_type::improve_f(
+                        g, q, fa, fb, qfa, qfb, fif, frb, *solver);
                     _clamp_f(settings, fa);
                     _compute_fb(fa, fb);
                     matrix_type::gemm(q, fa, qfa);
@@ -112,7 +124,129 @@ namespace jade
             _emit_results(settings, q, fa);
         }
 
+        ///
+        /// Executes one iteration from the initial Q and F matrices with
+        /// every solver, and writes the number of subproblems, the average
+        /// time to solve them, and the resulting log-likelihood per solver.
+        ///
+        static void execute_benchmark(
+                const settings_type & settings, ///< The settings.
+                matrix_type &         q0,       ///< The initial Q matrix.
+                matrix_type &         f0)       ///< The initial F matrix.
+        {
+            _clamp_f(settings, f0);
+
+            const auto & opts = settings.get_options();
+            const auto   fg   = settings.get_fg();
+            const auto   fif  = settings.get_fif();
+            const auto & g    = settings.get_g();
+            const auto   frb  = opts.is_frb();
+
+            matrix_type fb0 (f0.get_height(), f0.get_width());
+            _compute_fb(f0, fb0);
+
+            const matrix_type qfa0 = q0 * f0;
+            const matrix_type qfb0 = q0 * fb0;
+
+            std::cout
+                << "solver\tq-count\tq-usec\tf-count\tf-usec\t"
+                << "log-likelihood" << std::endl;
+
+            for (const auto & name : qp_solver_factory_type::get_names())
+            {
+                std::unique_ptr<qp_solver_type> solver (
+                    qp_solver_factory_type::create(name));
+
+                _timed_solver q_solver (*solver);
+                _timed_solver f_solver (*solver);
+
+                auto q   = q0;
+                auto fa  = f0;
+                auto fb  = fb0;
+                auto qfa = qfa0;
+                auto qfb = qfb0;
+
+                if (!opts.is_fixed_q())
+                {
+                    q = improver_type::improve_q(
+                        g, q, fa, fb, qfa, qfb, fg, q_solver);
+                    matrix_type::gemm(q, fa, qfa);
+                    matrix_type::gemm(q, fb, qfb);
+                }
+
+                if (!opts.is_fixed_f())
+                {
+                    fa = improver_type::improve_f(
+                        g, q, fa, fb, qfa, qfb, fif, frb, f_solver);
+                    _clamp_f(settings, fa);
+                    _compute_fb(fa, fb);
+                    matrix_type::gemm(q, fa, qfa);
+                    matrix_type::gemm(q, fb, qfb);
+                }
+
+                std::ostringstream line;
+                line << name
+                     << std::fixed << std::setprecision(3)
+                     << '\t' << q_solver.get_count()
+                     << '\t' << q_solver.get_microseconds()
+                     << '\t' << f_solver.get_count()
+                     << '\t' << f_solver.get_microseconds();
+                matrix_type::set_high_precision(line);
+                line << '\t' << g.compute_lle(q, fa, fb, qfa, qfb);
+
+                std::cout << line.str() << std::endl;
+            }
+        }
+
     private:
+        // --------------------------------------------------------------------
+        // A solver that forwards subproblems to another solver and measures
+        // the time spent solving them.
+        //
+        class _timed_solver
+            : public qp_solver_type
+        {
+        public:
+            typedef typename qp_solver_type::subproblem subproblem_type;
+            typedef std::chrono::high_resolution_clock  clock_type;
+            typedef std::chrono::duration<double>       duration_type;
+
+            explicit _timed_solver(qp_solver_type & solver)
+                : _solver  (solver)
+                , _count   (0)
+                , _seconds (0.0)
+            {
+            }
+
+            virtual void solve(
+                    const subproblem_type & problem,
+                    matrix_type &           delta_vec)
+                    override
+            {
+                const auto t0 = clock_type::now();
+                _solver.solve(problem, delta_vec);
+                _seconds += duration_type(clock_type::now() - t0).count();
+                _count++;
+            }
+
+            inline size_t get_count() const
+            {
+                return _count;
+            }
+
+            inline double get_microseconds() const
+            {
+                return _count == 0
+                    ? 0.0
+                    : 1.0e6 * _seconds / double(_count);
+            }
+
+        private:
+            qp_solver_type & _solver;
+            size_t           _count;
+            double           _seconds;
+        };
+
         // --------------------------------------------------------------------
         static void _clamp_f(const settings_type & settings, matrix_type & f)
         {
@@ -188,8 +322,8 @@ namespace jade
         {
             if (path.empty())
             {
-                matrix_type::set_high_precision(std::cout);
-                std::cout << "[" << name << " Matrix]\n" << matrix;
+                std::cout << "[" << name << " Matrix]\n";
+                matrix.write_exact(std::cout);
                 return;
             }
 
@@ -202,8 +336,7 @@ namespace jade
             if (!out.good())
                 throw error() << "failed to create matrix '" << path << "'";
 
-            matrix_type::set_high_precision(out);
-            out << matrix;
+            matrix.write_exact(out);
         }
 
         // --------------------------------------------------------------------
@@ -40,6 +40,15 @@ namespace jade
         static constexpr auto no_max_time =
             std::numeric_limits<double>::quiet_NaN();
 
+        /// The name of the active set solver.
+        static constexpr const char * active_set = "active-set";
+
+        /// The name of the primal-dual interior point solver.
+        static constexpr const char * interior_point = "interior-point";
+
+        /// The name of the Lemke solver.
+        static constexpr const char * lemke = "lemke";
+
         ///
         /// Initializes a new instance of the class.
         ///
@@ -52,11 +61,15 @@ namespace jade
             , _force          (a.read<std::string>("--force", "-fg"))
             , _fout           (a.read<std::string>("--fout",  "-fo"))
             , _ksize          (a.read("--ksize", "-k", no_ksize))
-            , _max_iterations (a.read("--max-iterations", "-mi", no_max_iterations))
+            , _max_iterations (a.read("--max-iterations", "-mi",
+                                   no_max_iterations))
             , _max_time       (a.read("--max-time", "-mt", no_max_time))
             , _qin            (a.read<std::string>("--qin", "-qi"))
             , _qout           (a.read<std::string>("--qout", "-qo"))
             , _seed           (a.read("--seed", "-s", std::random_device()()))
+            , _solver         (a.read<std::string>(
+                                   "--solver", "-so", active_set))
+            , _benchmark      (a.read_flag("--benchmark", "-bm"))
             , _frb            (a.read_flag("--frequency-bounds", "-frb"))
             , _fixed_f        (a.read_flag("--fixed-f", "-ff"))
             , _fixed_q        (a.read_flag("--fixed-q", "-fq"))
@@ -85,6 +98,13 @@ namespace jade
                     << "invalid value for --max-time option: "
                     << _max_time;
 
+            if (_solver != active_set &&
+                    _solver != interior_point &&
+                    _solver != lemke)
+                throw error()
+                    << "invalid value for --solver option: "
+                    << _solver;
+
             if (!is_ksize_specified() &&
                 !is_qin_specified() &&
                 !is_fin_specified() &&
@@ -232,6 +252,22 @@ namespace jade
             return _seed;
         }
 
+        ///
+        /// \return The solver value.
+        ///
+        inline const std::string & get_solver() const
+        {
+            return _solver;
+        }
+
+        ///
+        /// \return True if the benchmark option is specified.
+        ///
+        inline bool is_benchmark() const
+        {
+            return _benchmark;
+        }
+
         ///
         /// \return True if the epsilon option is specified.
         ///
@@ -358,8 +394,10 @@ namespace jade
         const std::string _qin;
         const std::string _qout;
         const seed_type   _seed;
+        const std::string _solver;
 
         // options without arguments
+        const bool _benchmark;
         const bool _frb;
         const bool _fixed_f;
         const bool _fixed_q;
@@ -0,0 +1,77 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_QP_SOLVER_HPP__
+#define JADE_QP_SOLVER_HPP__
+
+#include "jade.matrix.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for an abstract class that solves the quadratic subproblems
+    /// of the Newton steps for the Q and F matrices. Each subproblem finds
+    /// the change, delta, to one row of Q or one column of F that maximizes
+    /// d' * delta + delta' * H * delta / 2, where d and H are the derivative
+    /// vector and the Hessian matrix of the log-likelihood, subject to lower
+    /// <= delta <= upper and, for the rows of Q, sum(delta) = 0.
+    ///
+    template <typename TValue>
+    class basic_qp_solver
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The matrix type.
+        typedef basic_matrix<value_type> matrix_type;
+
+        ///
+        /// A quadratic subproblem.
+        ///
+        struct subproblem
+        {
+            matrix_type derivative_vec; ///< The [K x 1] derivative vector.
+            matrix_type hessian_mat;    ///< The [K x K] Hessian matrix.
+            matrix_type lower_vec;      ///< The [K x 1] lower bounds.
+            matrix_type upper_vec;      ///< The [K x 1] upper bounds.
+            bool        is_sum_fixed;   ///< True if sum(delta) is zero.
+
+            ///
+            /// Initializes a new instance of the structure for the specified
+            /// number of components.
+            ///
+            subproblem(
+                    const size_t k,         ///< The number of components.
+                    const bool   sum_fixed) ///< True if sum(delta) is zero.
+                : derivative_vec (k, 1)
+                , hessian_mat    (k, k)
+                , lower_vec      (k, 1)
+                , upper_vec      (k, 1)
+                , is_sum_fixed   (sum_fixed)
+            {
+            }
+        };
+
+        ///
+        /// Reclaims resources used by the class and derived classes.
+        ///
+        inline virtual ~basic_qp_solver()
+        {
+        }
+
+        ///
+        /// Solves the specified subproblem and stores the change into the
+        /// [K x 1] delta vector; if the solver fails, the change is zero.
+        ///
+        virtual void solve(
+                const subproblem & problem,   ///< The subproblem.
+                matrix_type &      delta_vec) ///< The change.
+                = 0;
+    };
+}
+
+#endif // JADE_QP_SOLVER_HPP__
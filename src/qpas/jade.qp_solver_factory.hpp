@@ -0,0 +1,73 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#ifndef JADE_QP_SOLVER_FACTORY_HPP__
+#define JADE_QP_SOLVER_FACTORY_HPP__
+
+#include "jade.active_set_solver.hpp"
+#include "jade.interior_point_solver.hpp"
+#include "jade.lemke_solver.hpp"
+#include "jade.options.hpp"
+
+namespace jade
+{
+    ///
+    /// A template for a class that creates the quadratic subproblem solvers
+    /// named by the --solver option.
+    ///
+    template <typename TValue>
+    class basic_qp_solver_factory
+    {
+    public:
+        /// The value type.
+        typedef TValue value_type;
+
+        /// The options type.
+        typedef basic_options<value_type> options_type;
+
+        /// The solver type.
+        typedef basic_qp_solver<value_type> qp_solver_type;
+
+        /// The active set solver type.
+        typedef basic_active_set_solver<value_type> active_set_solver_type;
+
+        /// The interior point solver type.
+        typedef basic_interior_point_solver<value_type>
+            interior_point_solver_type;
+
+        /// The Lemke solver type.
+        typedef basic_lemke_solver<value_type> lemke_solver_type;
+
+        ///
+        /// \return A new solver for the specified name.
+        ///
+        static qp_solver_type * create(
+                const std::string & name) ///< The name of the solver.
+        {
+            if (name == options_type::active_set)
+                return new active_set_solver_type();
+            if (name == options_type::interior_point)
+                return new interior_point_solver_type();
+            if (name == options_type::lemke)
+                return new lemke_solver_type();
+
+            throw error() << "invalid solver name: " << name;
+        }
+
+        ///
+        /// \return The names of all solvers.
+        ///
+        static std::vector<std::string> get_names()
+        {
+            return {
+                options_type::active_set,
+                options_type::interior_point,
+                options_type::lemke };
+        }
+    };
+}
+
+#endif // JADE_QP_SOLVER_FACTORY_HPP__
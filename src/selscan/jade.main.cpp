@@ -18,6 +18,8 @@ ARGUMENTS
   c-matrix     path to the [K-1 x K-1] global C matrix
 
 OPTIONS
+  --binary,-b        writes the results in a binary columnar format instead of
+                     text; see the description below
   --c-scale,-cs      indicates the next argument is the path to a [K-1 x K-1] C
                      matrix that provides scaling information; each step
                      linearly interpolates between the global C matrix and this
@@ -26,24 +28,60 @@ OPTIONS
                      values of the allele frequency matrix between (0 + fe) and
                      (1 - fe); if unspecified, this value defaults to 1.0e-6;
                      the value must be greater than 0.0 and less than 0.1
+  --fdr,-q           prints the q-value of each marker in an additional
+                     column after the p-value; the q-values are computed with
+                     the Benjamini-Hochberg procedure, which requires a first
+                     pass over all markers before the results are written
   --help,-h          shows this help message and exits
-  --steps,-s (100)   the number of steps to interpolate between C matrices
+  --steps,-s         indicates the next argument is the number of evenly spaced
+                     steps to interpolate between C matrices; if unspecified,
+                     the program optimizes the interpolation continuously
+  --top,-t           indicates the next argument is the number of markers with
+                     the highest likelihood ratios to print; if specified, the
+                     program prints only these markers, in descending order of
+                     their likelihood ratios, and it prints the one-based index
+                     of each marker in an additional first column
 
 DESCRIPTION
   Performs a selection scan to identify covariance outliers and prints for each
-  marker the step number when local optima is reached, the global likelihood,
-  the optimal local likelihood, and the likelihood ratio. By default, the
+  marker the scale at which the local optimum is reached, the likelihood ratio,
+  the global likelihood, the optimal local likelihood, the p-value of the
+  likelihood ratio, and the allele frequencies of the marker. By default, the
   program linearly interpolates between the global C matrix and 10 times its
   values, but it is possible to specify a scaling matrix using the --c-scale
   option.
 
+  The scale ranges from 0.0, the global C matrix, to 1.0, the scaling matrix,
+  and the program finds the optimal scale for each marker using Brent's
+  method. If the --steps option is specified, the program instead evaluates
+  the given number of evenly spaced steps and prints the step number of the
+  local optimum in place of the scale.
+
+  The results are written in marker order as blocks of markers are scored,
+  so the output of a scan can be processed as it is produced. For genome-wide
+  scans, the --top option avoids writing the results for every marker.
+
+  The p-value of each marker is computed from its likelihood ratio under a
+  null distribution that is an equal mixture of chi-square distributions with
+  zero and one degrees of freedom, since the global C matrix lies on the
+  boundary of the interpolation. Markers without a likelihood ratio have no
+  p-value, and they are assigned a p-value of 1.0 for the --fdr option.
+
+  The binary format begins with the 8 characters OHANASEL, a 32-bit version
+  number (1), and a 32-bit column count, followed by each column name as a
+  32-bit length and its characters. The header is followed by chunks of rows,
+  each consisting of a 64-bit row count N and then, for each column, N
+  double-precision values; a chunk with a row count of zero ends the output.
+  All integers and values are written in the native byte order.
+
   There are 'I' individuals, 'K' components, and 'J' markers. The sizes of
   the matrices evaluated by this program are:
 
   G matrix    [I x J]     the path to a genotype matrix; the format of the file
                           is determined based on the extension,
-                            .dgm (discrete genotype matrix) or
-                            .lgm (likelihood genotype matrix)
+                            .dgm (discrete genotype matrix),
+                            .lgm (likelihood genotype matrix), or
+                            .vcf (genotype likelihoods in VCF format)
   F matrix    [K x J]     floating-point values ranging from 0.0 to 1.0
   C matrix    [K-1 x K-1] floating-point values; the matrix is symmetric and
                           positive semidefinite
@@ -79,10 +117,9 @@ DESCRIPTION
 
 EXAMPLE
   $ selscan g.dgm f.matrix c.matrix
-  step    global-lle      local-lle       lle-ratio
-  0       +1.418028e+00   +1.418028e+00   +0.000000e+00
-  2       +1.769128e+00   +1.769128e+00   +0.000000e+00
-  0       +1.213023e+00   +1.213023e+00   +0.000000e+00
+  scale     lle-ratio  global-lle  local-lle  p-value    f-pop0     f-pop1
+  +1.0e+00  +2.1e+01   -1.2e+01    -1.1e+00   +1.8e-06   +9.7e-01   +4.6e-01
+  +6.0e-01  +3.5e+00   -2.0e+00    -2.1e-01   +3.0e-02   +1.0e+00   +7.0e-01
 
 BUGS
   Report any bugs to Jade Cheng <info@jade-cheng.com>.
@@ -8,7 +8,9 @@
 #define JADE_SELSCAN_HPP__
 
 #include "jade.args.hpp"
+#include "jade.brent.hpp"
 #include "jade.genotype_matrix_factory.hpp"
+#include "jade.parallel.hpp"
 
 namespace jade
 {
@@ -41,24 +43,30 @@ namespace jade
         ///
         explicit basic_selscan(
                 args & a) ///< The command-line arguments.
-            : steps     (a.read("--steps", "-s", size_t(100)))
+            : steps     (_read_steps(a))
+            , top       (a.read("--top", "-t", size_t(0)))
             , f_epsilon (_read_f_epsilon(a))
+            , c_scale   (a.read<std::string>("--c-scale", "-cs"))
+            , binary    (a.read_flag("--binary", "-b"))
+            , fdr       (a.read_flag("--fdr", "-q"))
             , g_ptr     (genotype_matrix_factory_type::create(a.pop<std::string>()))
             , g         (*g_ptr)
             , fa        (a.pop<std::string>())
             , c1        (a.pop<std::string>())
-            , c2        (_init_scaling_matrix(a, c1))
+            , c2        (_init_scaling_matrix(c_scale, c1))
             , RK        (c1.get_width())
             , J         (g.get_width())
             , mu        (g.create_mu(f_epsilon))
             , rooted_fa (_compute_rooted_fa(fa))
-            , c_inv     (RK, RK)
-            , f_j_c_inv (RK, 1)
+            , c_invs       ()
+            , log_dets     ()
+            , c1_lower     ()
+            , eigenvectors ()
+            , eigenvalues  ()
+            , log_c1_det   (0)
+            , p_table      ()
+            , q_table      ()
         {
-            if (steps < 2)
-                throw error() << "invalid value for --steps option ("
-                              << steps << "); expected at least two steps";
-
             a.validate_empty();
 
             verification_type::validate_g(g);
@@ -71,44 +79,595 @@ namespace jade
         }
 
         ///
-        /// Executes the program.
+        /// Executes the program. The markers are scored in waves of blocks on
+        /// multiple threads, and the results of each wave are written in
+        /// marker order before the next wave begins. If the --top option is
+        /// specified, only the markers with the highest likelihood ratios are
+        /// kept, and they are written after the scan in descending order. If
+        /// the --fdr option is specified, a first pass over the markers
+        /// collects the p-values for the Benjamini-Hochberg correction.
         ///
         void execute()
+        {
+            if (steps == 0)
+                _decompose();
+            else
+                _cache_inverses();
+
+            if (fdr)
+                _compute_q_table();
+
+            _write_header();
+
+            //
+            // Keep the best records in a heap with the lowest ranked record
+            // on top, so it can be removed when a better record is found.
+            //
+            const auto is_higher = [](const record & lhs, const record & rhs)
+            {
+                return lhs.is_higher(rhs);
+            };
+
+            std::priority_queue<
+                record,
+                std::vector<record>,
+                decltype(is_higher)> heap (is_higher);
+
+            _for_each_wave([&](const std::vector<record> & records)
+            {
+                if (top == 0)
+                {
+                    _write(records.data(), records.size());
+                    return;
+                }
+
+                for (const auto & r : records)
+                {
+                    if (heap.size() == top && !r.is_higher(heap.top()))
+                        continue;
+
+                    heap.push(r);
+                    if (heap.size() > top)
+                        heap.pop();
+                }
+            });
+
+            //
+            // Write the best records in descending order.
+            //
+            std::vector<record> best;
+            best.reserve(heap.size());
+            for (; !heap.empty(); heap.pop())
+                best.push_back(heap.top());
+
+            std::reverse(best.begin(), best.end());
+            _write(best.data(), best.size());
+
+            if (binary)
+            {
+                const std::uint64_t end = 0;
+                _write_binary(&end, 1);
+            }
+
+            std::cout.flush();
+        }
+
+        ///
+        /// Computes the p-value of a likelihood ratio. Because the global C
+        /// matrix lies on the boundary of the scale, the ratio follows an
+        /// equal mixture of chi-square distributions with zero and one
+        /// degrees of freedom under the null hypothesis.
+        ///
+        /// \return The p-value, or NaN if the ratio is not a number.
+        ///
+        static value_type compute_p_value(
+                const value_type lle_ratio) ///< The likelihood ratio.
+        {
+            if (std::isnan(lle_ratio))
+                return lle_ratio;
+
+            if (!(lle_ratio > value_type(0)))
+                return value_type(1);
+
+            return value_type(0.5) *
+                std::erfc(std::sqrt(lle_ratio / value_type(2)));
+        }
+
+        ///
+        /// Computes the q-values of the Benjamini-Hochberg procedure for the
+        /// specified p-values. Tied p-values have the same q-value.
+        ///
+        /// \return The q-values, in the order of the p-values.
+        ///
+        static std::vector<value_type> compute_q_values(
+                const std::vector<value_type> & p_values) ///< The p-values.
+        {
+            const auto n = p_values.size();
+
+            std::vector<size_t> order (n);
+            for (size_t i = 0; i < n; i++)
+                order[i] = i;
+
+            std::stable_sort(order.begin(), order.end(),
+                [&p_values](const size_t lhs, const size_t rhs)
+                {
+                    return p_values[lhs] < p_values[rhs];
+                });
+
+            const auto m = value_type(n);
+
+            std::vector<value_type> q_values (n);
+            auto q_min = value_type(1);
+            for (auto i = n; i > 0; i--)
+            {
+                const auto index = order[i - 1];
+                const auto q     = p_values[index] * m / value_type(i);
+                q_min = std::min(q_min, q);
+                q_values[index] = q_min;
+            }
+
+            return q_values;
+        }
+
+    private:
+        class record;
+
+        typedef std::unique_ptr<genotype_matrix_type> genotype_matrix_ptr;
+
+        /// The number of markers in each block scored by one thread.
+        static const size_t block_length = 1024;
+
+        /// The identifier at the start of the binary output.
+        static constexpr const char * binary_magic = "OHANASEL";
+
+        /// The version of the binary output.
+        static const std::uint32_t binary_version = 1;
+
+        // --------------------------------------------------------------------
+        // Appends one line of output for the specified record.
+        //
+        void _append(std::string & text, const record & r) const
         {
             const auto K = fa.get_height();
 
-            std::cout << "step\tlle-ratio\tglobal-lle\tlocal-lle";
+            if (top > 0)
+            {
+                text += std::to_string(r.get_j() + 1);
+                text += '\t';
+            }
+
+            if (steps == 0)
+                _append(text, r.get_scale());
+            else
+                text += std::to_string(r.get_step());
+
+            const auto p = r.get_p_value();
+
+            text += '\t';
+            _append(text, r.get_lle_ratio());
+            text += '\t';
+            _append(text, r.get_score());
+            text += '\t';
+            _append(text, r.get_best_score());
+            text += '\t';
+            _append(text, p);
+
+            if (fdr)
+            {
+                text += '\t';
+                _append(text, _get_q_value(p));
+            }
 
             for (size_t k = 0; k < K; k++)
-                std::cout << "\t" << "f-pop" << k;
+            {
+                text += '\t';
+                _append(text, fa(k, r.get_j()));
+            }
+
+            text += '\n';
+        }
+
+        // --------------------------------------------------------------------
+        // Appends a value in scientific notation with a sign and a high
+        // precision.
+        //
+        static void _append(std::string & text, const value_type value)
+        {
+            static const auto precision =
+                1 + std::numeric_limits<value_type>::digits10;
+
+            typedef long double long_double;
+
+            char buf[64];
+            const auto n = std::snprintf(
+                buf, sizeof(buf), "%+.*Le", precision, long_double(value));
+
+            text.append(buf, size_t(n));
+        }
+
+        // --------------------------------------------------------------------
+        // Collects the p-values of all markers in ascending order and
+        // computes their q-values.
+        //
+        void _compute_q_table()
+        {
+            p_table.clear();
+            p_table.reserve(J);
+
+            _for_each_wave([&](const std::vector<record> & records)
+            {
+                for (const auto & r : records)
+                {
+                    const auto p = r.get_p_value();
+                    p_table.push_back(std::isnan(p) ? value_type(1) : p);
+                }
+            });
+
+            std::sort(p_table.begin(), p_table.end());
+            q_table = compute_q_values(p_table);
+        }
 
-            std::cout << std::endl;
+        // --------------------------------------------------------------------
+        // Scores the markers in waves of blocks on multiple threads, and
+        // invokes the specified action with the records of each wave in
+        // marker order.
+        //
+        template <typename TAction>
+        void _for_each_wave(const TAction & action) const
+        {
+            const auto wave_length = block_length * std::max(size_t(1),
+                4 * parallel::get_thread_count());
 
             std::vector<record> records;
-            records.reserve(J);
-            for (size_t j = 0; j < J; j++)
-                records.emplace_back(j, _compute_score(0, j));
 
-            for (size_t si = 0; si < steps; si++)
-                for (auto & r : records)
-                    r.update(si, _compute_score(si, r.get_j()));
+            for (size_t first = 0; first < J; first += wave_length)
+            {
+                const auto last  = std::min(J, first + wave_length);
+                const auto count = (last - first + block_length - 1)
+                                 / block_length;
+
+                records.clear();
+                for (auto j = first; j < last; j++)
+                    records.emplace_back(j, value_type(0));
+
+                parallel::for_each(count, [&](const size_t block, size_t)
+                {
+                    const auto block_first = first + block * block_length;
+                    const auto block_last  = std::min(
+                        last, block_first + block_length);
+
+                    const auto ptr = records.data() + (block_first - first);
+
+                    if (steps == 0)
+                        _optimize_block(block_first, block_last, ptr);
+                    else
+                        _scan_block(block_first, block_last, ptr);
+                });
+
+                action(records);
+            }
+        }
 
-            for (const auto & r : records)
+        // --------------------------------------------------------------------
+        // Returns the q-value for the specified p-value; for tied p-values,
+        // this is the q-value of the last one in ascending order.
+        //
+        value_type _get_q_value(const value_type p) const
+        {
+            if (std::isnan(p))
+                return p;
+
+            const auto iter = std::upper_bound(
+                p_table.begin(), p_table.end(), p);
+
+            if (iter == p_table.begin())
+                throw error() << "failed to find the q-value of p-value " << p;
+
+            return q_table[size_t(iter - p_table.begin()) - 1];
+        }
+
+        // --------------------------------------------------------------------
+        // Returns the names of the output columns.
+        //
+        std::vector<std::string> _get_column_names() const
+        {
+            std::vector<std::string> names;
+
+            if (top > 0)
+                names.emplace_back("marker");
+
+            names.emplace_back(steps == 0 ? "scale" : "step");
+            names.emplace_back("lle-ratio");
+            names.emplace_back("global-lle");
+            names.emplace_back("local-lle");
+            names.emplace_back("p-value");
+
+            if (fdr)
+                names.emplace_back("q-value");
+
+            for (size_t k = 0; k < fa.get_height(); k++)
+                names.emplace_back("f-pop" + std::to_string(k));
+
+            return names;
+        }
+
+        // --------------------------------------------------------------------
+        // Writes the specified records to standard output. The records are
+        // formatted in blocks on multiple threads and written in order.
+        //
+        void _write(const record * records, const size_t n) const
+        {
+            if (n == 0)
+                return;
+
+            if (binary)
+            {
+                _write_binary_chunk(records, n);
+                return;
+            }
+
+            const auto count = (n + block_length - 1) / block_length;
+            std::vector<std::string> texts (count);
+
+            parallel::for_each(count, [&](const size_t block, size_t)
             {
-                std::cout << r.get_step()                << '\t'
-                          << _format(r.get_lle_ratio())  << '\t'
-                          << _format(r.get_score())      << '\t'
-                          << _format(r.get_best_score());
+                const auto last = std::min(n, (block + 1) * block_length);
+                for (auto i = block * block_length; i < last; i++)
+                    _append(texts[block], records[i]);
+            });
+
+            for (const auto & text : texts)
+                std::cout.write(text.data(), std::streamsize(text.size()));
+        }
+
+        // --------------------------------------------------------------------
+        template <typename TItem>
+        static void _write_binary(const TItem * items, const size_t n)
+        {
+            std::cout.write(
+                reinterpret_cast<const char *>(items),
+                std::streamsize(n * sizeof(TItem)));
+        }
+
+        // --------------------------------------------------------------------
+        // Writes a chunk of binary output: the number of rows as a 64-bit
+        // integer followed by the values of each column as doubles.
+        //
+        void _write_binary_chunk(const record * records, const size_t n) const
+        {
+            const auto K = fa.get_height();
+            const auto C = _get_column_names().size();
+
+            std::vector<double> table (C * n);
+
+            parallel::for_each(n, [&](const size_t i, size_t)
+            {
+                const auto & r = records[i];
+                const auto   p = r.get_p_value();
+
+                auto dst = table.data() + i;
+                const auto put = [&](const double value)
+                {
+                    *dst = value;
+                    dst += n;
+                };
+
+                if (top > 0)
+                    put(double(r.get_j() + 1));
+
+                put(steps == 0 ? double(r.get_scale()) : double(r.get_step()));
+                put(double(r.get_lle_ratio()));
+                put(double(r.get_score()));
+                put(double(r.get_best_score()));
+                put(double(p));
+
+                if (fdr)
+                    put(double(_get_q_value(p)));
 
                 for (size_t k = 0; k < K; k++)
-                    std::cout << '\t' << _format(fa(k, r.get_j()));
+                    put(double(fa(k, r.get_j())));
+            });
+
+            const auto rows = std::uint64_t(n);
+            _write_binary(&rows, 1);
+            _write_binary(table.data(), table.size());
+        }
+
+        // --------------------------------------------------------------------
+        // Writes the column names as a line of text or as the header of the
+        // binary output, which consists of an identifier, a version number,
+        // and the number of columns followed by the length and characters of
+        // each column name; the integers are 32 bits.
+        //
+        void _write_header() const
+        {
+            const auto names = _get_column_names();
 
-                std::cout << std::endl;
+            if (binary)
+            {
+                const auto version = binary_version;
+                const auto count   = std::uint32_t(names.size());
+                _write_binary(binary_magic, std::strlen(binary_magic));
+                _write_binary(&version, 1);
+                _write_binary(&count, 1);
+
+                for (const auto & name : names)
+                {
+                    const auto length = std::uint32_t(name.size());
+                    _write_binary(&length, 1);
+                    _write_binary(name.data(), name.size());
+                }
+
+                return;
+            }
+
+            std::string header;
+            for (const auto & name : names)
+            {
+                if (!header.empty())
+                    header += '\t';
+                header += name;
             }
+
+            header += '\n';
+            std::cout.write(header.data(), std::streamsize(header.size()));
         }
 
-    private:
-        typedef std::unique_ptr<genotype_matrix_type> genotype_matrix_ptr;
+        // --------------------------------------------------------------------
+        // Scores a block of markers at evenly spaced steps between the C
+        // matrices. For each step, the scores of the block are computed from
+        // one matrix product of the cached inverse and the rooted frequencies
+        // of the block.
+        //
+        void _scan_block(
+                const size_t first,
+                const size_t last,
+                record *     records)
+                const
+        {
+            matrix_type             product (RK, last - first);
+            std::vector<value_type> scores  (last - first);
+
+            for (size_t si = 0; si < steps; si++)
+            {
+                _compute_scores(si, first, product, scores);
+
+                for (auto j = first; j < last; j++)
+                {
+                    auto & r = records[j - first];
+
+                    if (si == 0)
+                        r = record(j, scores[j - first]);
+
+                    r.update(si, scores[j - first]);
+                }
+            }
+        }
+
+        // --------------------------------------------------------------------
+        // Decomposes the C matrices for the continuous optimization. With
+        // C1 = L L^T and the eigendecomposition
+        // L^-1 (C2 - C1) L^-T = V diag(lambda) V^T, the interpolated matrix
+        // C(t) = C1 + t (C2 - C1) has the log determinant
+        //
+        //   log|C1| + sum_k log(1 + t lambda_k)
+        //
+        // and, for z = V^T L^-1 f, the quadratic form
+        //
+        //   f^T C(t)^-1 f = sum_k z_k^2 / (1 + t lambda_k),
+        //
+        // so each evaluation of the score requires O(K) operations after the
+        // one-time decomposition.
+        //
+        void _decompose()
+        {
+            c1_lower = c1;
+            if (!c1_lower.potrf_lower())
+                throw error() << "the global C matrix is not positive definite";
+
+            log_c1_det = 0;
+            for (size_t k = 0; k < RK; k++)
+                log_c1_det += value_type(2) * std::log(c1_lower(k, k));
+
+            eigenvectors = c2 - c1;
+            _solve_lower(c1_lower, eigenvectors);
+            eigenvectors.transpose();
+            _solve_lower(c1_lower, eigenvectors);
+
+            if (!eigenvectors.syev_lower(eigenvalues))
+                throw error() << "failed to decompose the C matrices";
+        }
+
+        // --------------------------------------------------------------------
+        // Maximizes the scores of a block of markers over the continuous
+        // scale between the C matrices.
+        //
+        void _optimize_block(
+                const size_t first,
+                const size_t last,
+                record *     records)
+                const
+        {
+            typedef std::numeric_limits<value_type> limits_type;
+            typedef typename matrix_type::blas_type blas_type;
+
+            static const auto lowest    = limits_type::lowest();
+            static const auto tolerance = value_type(1.0e-6);
+            static const auto pi        = value_type(std::acos(-1.0));
+            static const auto tau       = value_type(2) * pi;
+
+            const auto rk = static_cast<value_type>(RK);
+            const auto n  = last - first;
+
+            matrix_type y (RK, n);
+            for (size_t k = 0; k < RK; k++)
+                for (size_t jj = 0; jj < n; jj++)
+                    y(k, jj) = rooted_fa(k, first + jj);
+
+            _solve_lower(c1_lower, y);
+
+            //
+            // Rotate the whitened frequencies into the eigenbasis with one
+            // matrix product for the block: Z := V^T * Y.
+            //
+            matrix_type z (RK, n);
+            blas_type::gemm(
+                CblasRowMajor,            // Layout
+                CblasTrans,               // transa
+                CblasNoTrans,             // transb
+                int(RK),                  // m
+                int(n),                   // n
+                int(RK),                  // k
+                1.0,                      // alpha
+                eigenvectors.get_data(),  // A
+                int(RK),                  // lda
+                y.get_data(),             // B
+                int(n),                   // ldb
+                0.0,                      // beta
+                z.get_data(),             // C
+                int(n));                  // ldc
+
+            std::vector<value_type> z2 (RK);
+
+            for (size_t jj = 0; jj < n; jj++)
+            {
+                const auto j = first + jj;
+
+                for (size_t k = 0; k < RK; k++)
+                    z2[k] = z(k, jj) * z(k, jj);
+
+                const auto mu_j = mu[j];
+                const auto c_j  = mu_j * (value_type(1) - mu_j);
+                const auto base = log_c1_det + rk * std::log(tau * c_j);
+
+                const auto score = [&](const value_type t) -> value_type
+                {
+                    auto log_det = base;
+                    auto dot     = value_type(0);
+                    for (size_t k = 0; k < RK; k++)
+                    {
+                        const auto s = value_type(1) + t * eigenvalues[k];
+                        if (!(s > value_type(0)))
+                            return lowest;
+
+                        log_det += std::log(s);
+                        dot     += z2[k] / s;
+                    }
+
+                    return -(log_det + dot / c_j) / value_type(2);
+                };
+
+                auto & r = records[jj];
+                r = record(j, score(value_type(0)));
+                r.update_scale(value_type(0), r.get_score());
+                r.update_scale(value_type(1), score(value_type(1)));
+
+                value_type t;
+                const auto best = brent::maximize(
+                    score, value_type(0), value_type(1), tolerance, t);
+                r.update_scale(t, best);
+            }
+        }
 
         // --------------------------------------------------------------------
         static matrix_type _compute_rooted_fa(const matrix_type & fa)
@@ -128,90 +687,104 @@ namespace jade
         }
 
         // --------------------------------------------------------------------
-        value_type _compute_score(
-                const size_t si,
-                const size_t j)
+        // Computes the inverse and the log of the determinant of the
+        // interpolated C matrix for each step.
+        //
+        void _cache_inverses()
+        {
+            c_invs.assign(steps, matrix_type(RK, RK));
+            log_dets.assign(steps, value_type(0));
+
+            parallel::for_each(steps, [&](const size_t si, size_t)
+            {
+                typedef std::numeric_limits<value_type> limits_type;
+
+                auto & c_inv = c_invs[si];
+
+                const auto percent = value_type(si) / value_type(steps - 1);
+                for (size_t i = 0; i < RK * RK; i++)
+                    c_inv[i] = c1[i] + percent * (c2[i] - c1[i]);
+
+                //
+                // If this fails, the matrix is not positive semidefinite;
+                // mark the step with a NaN log determinant so its scores are
+                // -Infinity to indicate these are unacceptable parameters.
+                //
+                if (!c_inv.invert(log_dets[si]))
+                    log_dets[si] = limits_type::quiet_NaN();
+            });
+        }
+
+        // --------------------------------------------------------------------
+        void _compute_scores(
+                const size_t              si,
+                const size_t              first,
+                matrix_type &             product,
+                std::vector<value_type> & scores)
+                const
         {
             typedef std::numeric_limits<value_type> limits_type;
             static const auto lowest = limits_type::lowest();
 
             typedef typename matrix_type::blas_type blas_type;
 
-            const auto percent = value_type(si) / value_type(steps - 1);
-            for (size_t i = 0; i < RK * RK; i++)
-                c_inv[i] = c1[i] + percent * (c2[i] - c1[i]);
-
-            //
-            // Compute the inverse and the log of the determinant. If this
-            // fails, the matrix is not positive semidefinite; return -Infinity
-            // to indicate these are unacceptable parameters.
-            //
-            value_type log_c_det;
-            if (!c_inv.invert(log_c_det))
-                return lowest;
-
-            //
-            // The ?gemv routines perform a matrix-vector operation defined as
-            //
-            // y := (alpha * A * x) + (beta * y)
-            //
-            // where alpha and beta are scalars, x and y are vectors, and A is
-            // an m-by-n matrix.
-            //
-            blas_type::gemv(
-                CblasRowMajor,               // Layout
-                CblasNoTrans,                // transa
-                int(c_inv.get_height()),     // m
-                int(c_inv.get_width()),      // n
-                1.0,                         // alpha
-                c_inv.get_data(),            // A
-                int(c_inv.get_width()),      // lda
-                rooted_fa.get_data() + j,    // x
-                int(rooted_fa.get_width()),  // incx
-                0.0,                         // beta
-                f_j_c_inv.get_data(),        // y
-                int(f_j_c_inv.get_width())); // yinc
+            const auto n         = product.get_width();
+            const auto log_c_det = log_dets[si];
+            if (std::isnan(log_c_det))
+            {
+                std::fill(scores.begin(), scores.end(), lowest);
+                return;
+            }
 
             //
-            // The ?dot routines perform a vector-vector reduction operation
-            // defined as
+            // The ?gemm routines perform a matrix-matrix operation defined as
             //
-            // res = Sum (x_i * y_i) for i = 1 to n
+            // C := (alpha * op(A) * op(B)) + (beta * C)
             //
-            // where x_i and y_i are elements of vectors x and y.
+            // where alpha and beta are scalars, and A, B, and C are matrices;
+            // here, B is the block of columns of the rooted F matrix.
             //
-            const auto dot = blas_type::dot(
-                int(f_j_c_inv.get_height()), // n (height = RK)
-                rooted_fa.get_data() + j,    // x
-                int(rooted_fa.get_width()),  // xinc (width = 1)
-                f_j_c_inv.get_data(),        // y
-                int(f_j_c_inv.get_width())); // yinc (width = 1)
+            blas_type::gemm(
+                CblasRowMajor,                // Layout
+                CblasNoTrans,                 // transa
+                CblasNoTrans,                 // transb
+                int(RK),                      // m
+                int(n),                       // n
+                int(RK),                      // k
+                1.0,                          // alpha
+                c_invs[si].get_data(),        // A
+                int(RK),                      // lda
+                rooted_fa.get_data() + first, // B
+                int(J),                       // ldb
+                0.0,                          // beta
+                product.get_data(),           // C
+                int(n));                      // ldc
 
             static const auto pi  = value_type(std::acos(-1.0));
             static const auto tau = value_type(2) * pi;
 
-            const auto rk   = static_cast<value_type>(RK);
-            const auto mu_j = mu[j];
-            const auto c_j  = mu_j * (value_type(1) - mu_j);
-            const auto term = (rk * std::log(tau * c_j)) + (dot / c_j);
-            return -(log_c_det + term) / value_type(2);
-        }
+            const auto rk = static_cast<value_type>(RK);
 
-        // --------------------------------------------------------------------
-        static std::string _format(const value_type value)
-        {
-            std::ostringstream out;
-            matrix_type::set_high_precision(out);
-            out << std::showpos << value;
-            return out.str();
+            for (size_t jj = 0; jj < n; jj++)
+            {
+                const auto j = first + jj;
+
+                value_type dot = 0;
+                for (size_t k = 0; k < RK; k++)
+                    dot += rooted_fa(k, j) * product(k, jj);
+
+                const auto mu_j = mu[j];
+                const auto c_j  = mu_j * (value_type(1) - mu_j);
+                const auto term = (rk * std::log(tau * c_j)) + (dot / c_j);
+                scores[jj] = -(log_c_det + term) / value_type(2);
+            }
         }
 
         // --------------------------------------------------------------------
         static matrix_type _init_scaling_matrix(
-                args &              a,
+                const std::string & path,
                 const matrix_type & c1)
         {
-            const auto path = a.read<std::string>("--c-scale", "-cs");
             return path.empty() ? value_type(10) * c1 : matrix_type(path);
         }
 
@@ -228,6 +801,50 @@ namespace jade
             return out;
         }
 
+        // --------------------------------------------------------------------
+        // Returns the number of steps, or zero if the option is unspecified
+        // and the scale is optimized continuously.
+        //
+        static size_t _read_steps(args & a)
+        {
+            const auto text = a.read<std::string>("--steps", "-s");
+            if (text.empty())
+                return 0;
+
+            std::istringstream in (text);
+            size_t out;
+            if (!(in >> out) || !in.eof() || out < 2)
+                throw error() << "invalid value for --steps option ("
+                              << text << "); expected at least two steps";
+
+            return out;
+        }
+
+        // --------------------------------------------------------------------
+        // Solves L X = B in place for a lower-triangular matrix L.
+        //
+        static void _solve_lower(const matrix_type & l, matrix_type & b)
+        {
+            const auto n = b.get_width();
+
+            for (size_t r = 0; r < b.get_height(); r++)
+            {
+                const auto dst = b.get_data(r, 0);
+
+                for (size_t k = 0; k < r; k++)
+                {
+                    const auto l_rk = l(r, k);
+                    const auto src  = b.get_data(k, 0);
+                    for (size_t c = 0; c < n; c++)
+                        dst[c] -= l_rk * src[c];
+                }
+
+                const auto l_rr = l(r, r);
+                for (size_t c = 0; c < n; c++)
+                    dst[c] /= l_rr;
+            }
+        }
+
         // --------------------------------------------------------------------
         class record
         {
@@ -237,6 +854,7 @@ namespace jade
                 : _best_score (std::numeric_limits<value_type>::lowest())
                 , _j          (j)
                 , _lle_ratio  (std::numeric_limits<value_type>::quiet_NaN())
+                , _scale      (std::numeric_limits<value_type>::quiet_NaN())
                 , _score      (score)
                 , _step       (std::numeric_limits<size_t>::max())
             {
@@ -260,6 +878,18 @@ namespace jade
                 return _lle_ratio;
             }
 
+            // ----------------------------------------------------------------
+            inline value_type get_p_value() const
+            {
+                return compute_p_value(_lle_ratio);
+            }
+
+            // ----------------------------------------------------------------
+            inline value_type get_scale() const
+            {
+                return _scale;
+            }
+
             // ----------------------------------------------------------------
             inline value_type get_score() const
             {
@@ -272,6 +902,21 @@ namespace jade
                 return _step;
             }
 
+            // ----------------------------------------------------------------
+            // Returns true if this record has a higher likelihood ratio than
+            // the other record; ratios that are not numbers are the lowest,
+            // and ties are broken by the marker order.
+            //
+            inline bool is_higher(const record & other) const
+            {
+                const auto lhs = _get_rank();
+                const auto rhs = other._get_rank();
+
+                if (lhs > rhs) return true;
+                if (lhs < rhs) return false;
+                return _j < other._j;
+            }
+
             // ----------------------------------------------------------------
             inline void update(const size_t step, const value_type score)
             {
@@ -283,16 +928,42 @@ namespace jade
                 _lle_ratio  = value_type(2) * (score - _score);
             }
 
+            // ----------------------------------------------------------------
+            inline void update_scale(
+                    const value_type scale,
+                    const value_type score)
+            {
+                if (score <= _best_score)
+                    return;
+
+                _scale      = scale;
+                _best_score = score;
+                _lle_ratio  = value_type(2) * (score - _score);
+            }
+
         private:
+            // ----------------------------------------------------------------
+            inline value_type _get_rank() const
+            {
+                return std::isnan(_lle_ratio)
+                    ? -std::numeric_limits<value_type>::infinity()
+                    : _lle_ratio;
+            }
+
             value_type _best_score;
             size_t     _j;
             value_type _lle_ratio;
+            value_type _scale;
             value_type _score;
             size_t     _step;
         };
 
         const size_t                 steps;
+        const size_t                 top;
         const value_type             f_epsilon;
+        const std::string            c_scale;
+        const bool                   binary;
+        const bool                   fdr;
         const genotype_matrix_ptr    g_ptr;
         const genotype_matrix_type & g;
         const matrix_type            fa;
@@ -302,8 +973,14 @@ namespace jade
         const size_t                 J;
         const matrix_type            mu;
         const matrix_type            rooted_fa;
-        matrix_type                  c_inv;
-        matrix_type                  f_j_c_inv;
+        std::vector<matrix_type>     c_invs;
+        std::vector<value_type>      log_dets;
+        matrix_type                  c1_lower;
+        matrix_type                  eigenvectors;
+        matrix_type                  eigenvalues;
+        value_type                   log_c1_det;
+        std::vector<value_type>      p_table;
+        std::vector<value_type>      q_table;
     };
 }
 
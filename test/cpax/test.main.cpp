@@ -1,13 +0,0 @@
-/* -------------------------------------------------------------------------
-   Ohana
-   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
-   Jade Cheng <info@jade-cheng.com>                              (='.'=)
-   ------------------------------------------------------------------------- */
-
-#include "test.main.hpp"
-
-// ----------------------------------------------------------------------------
-int main()
-{
-    return EXIT_SUCCESS;
-}
@@ -1,16 +0,0 @@
-/* -------------------------------------------------------------------------
-   Ohana
-   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
-   Jade Cheng <info@jade-cheng.com>                              (='.'=)
-   ------------------------------------------------------------------------- */
-
-#ifndef TEST_MAIN_HPP__
-#define TEST_MAIN_HPP__
-
-#include "test.hpp"
-
-namespace test
-{
-}
-
-#endif // TEST_MAIN_HPP__
@@ -0,0 +1,138 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.ldprune.hpp"
+
+namespace
+{
+    typedef jade::ldprune::data_type data_type;
+
+    // ------------------------------------------------------------------------
+    std::string run(
+            const std::string & text,
+            const char *        max_r2,
+            const char *        window = "50")
+    {
+        std::istringstream in (text);
+        std::ostringstream out;
+        jade::args args { "", "-w", window, max_r2 };
+        jade::ldprune ldprune (args);
+        ldprune.execute(in, out);
+        return out.str();
+    }
+
+    // ------------------------------------------------------------------------
+    void test_dgm()
+    {
+        //
+        // The second marker is identical to the first, the third marker is
+        // the first with the alleles swapped, and the fourth marker is
+        // identical to the first except for a missing genotype. The last
+        // marker is not correlated with the first.
+        //
+        const auto s = R"(
+           4 5
+           0 0 2 3 2
+           1 1 1 1 1
+           2 2 0 2 1
+           0 0 2 0 0
+        )";
+
+        TEST_EQUAL(std::string("4 2\n0\t2\n1\t1\n2\t1\n0\t0\n"), run(s, "0.5"));
+        TEST_EQUAL(std::string("4 5\n0\t0\t2\t3\t2\n1\t1\t1\t1\t1\n"
+            "2\t2\t0\t2\t1\n0\t0\t2\t0\t0\n"), run(s, "1"));
+
+        //
+        // Only the adjacent markers are compared with a window of two.
+        //
+        const auto t = R"(
+           3 3
+           0 1 0
+           1 0 1
+           2 2 2
+        )";
+
+        TEST_EQUAL(std::string("3 3\n0\t1\t0\n1\t0\t1\n2\t2\t2\n"),
+            run(t, "0.9", "2"));
+        TEST_EQUAL(std::string("3 2\n0\t1\n1\t0\n2\t2\n"), run(t, "0.9", "3"));
+    }
+
+    // ------------------------------------------------------------------------
+    void test_errors()
+    {
+        TEST_THROWS(run("1 1\n0\n", "1.5"));
+        TEST_THROWS(run("1 1\n0\n", "0.5", "1"));
+        TEST_THROWS(run("1 1\n7\n", "0.5"));
+    }
+
+    // ------------------------------------------------------------------------
+    void test_parallel()
+    {
+        //
+        // Compare the bit-packed correlations of a discrete genotype matrix
+        // with the correlations of an equivalent likelihood genotype matrix.
+        //
+        static const size_t I = 150;
+        static const size_t J = 3000;
+
+        std::mt19937 engine (5);
+        std::uniform_int_distribution<int> code (0, 2);
+        std::uniform_int_distribution<int> noise (0, 9);
+
+        jade::basic_matrix<int> g (I, J);
+        for (size_t i = 0; i < I; i++)
+        {
+            for (size_t j = 0; j < J; j++)
+            {
+                const auto n = noise(engine);
+                g(i, j) = n == 0 ? 3
+                        : n > 3 && j > 0 ? g(i, j - 1)
+                        : code(engine);
+            }
+        }
+
+        std::ostringstream lgm;
+        for (int k = 2; k >= 0; k--)
+        {
+            jade::basic_matrix<int> l (I, J);
+            for (size_t i = 0; i < l.get_length(); i++)
+                l[i] = g[i] == 3 ? 1 : g[i] == k ? 1 : 0;
+            lgm << l << '\n';
+        }
+
+        const auto thread_count = jade::parallel::get_thread_count();
+        jade::parallel::set_thread_count(4);
+
+        std::istringstream dgm_in (g.str());
+        std::istringstream lgm_in (lgm.str());
+        const data_type dgm_data (dgm_in);
+        const data_type lgm_data (lgm_in);
+        TEST_TRUE(dgm_data.is_dgm());
+        TEST_FALSE(lgm_data.is_dgm());
+
+        jade::args args { "", "--window", "20", "0.3" };
+        const jade::ldprune ldprune (args);
+        const auto keep = ldprune.select(dgm_data);
+        jade::parallel::set_thread_count(1);
+        const auto expected = ldprune.select(lgm_data);
+        jade::parallel::set_thread_count(thread_count);
+
+        TEST_TRUE(keep == expected);
+
+        const auto count = size_t(std::count(keep.begin(), keep.end(), true));
+        TEST_TRUE(count > 0 && count < J);
+    }
+}
+
+namespace test
+{
+    test_group ldprune {
+        TEST_CASE(test_dgm),
+        TEST_CASE(test_errors),
+        TEST_CASE(test_parallel)
+    };
+}
@@ -0,0 +1,90 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.maf.hpp"
+
+namespace
+{
+    // ------------------------------------------------------------------------
+    std::string run(const std::string & text, const char * min_maf)
+    {
+        std::istringstream in (text);
+        std::ostringstream out;
+        jade::args args { "", min_maf };
+        jade::maf maf (args);
+        maf.execute(in, out);
+        return out.str();
+    }
+
+    // ------------------------------------------------------------------------
+    void test_dgm()
+    {
+        const auto s = R"(
+           4 4
+           0 1 2 0
+           0 1 2 3
+           0 0 2 3
+           1 0 2 0
+        )";
+
+        //
+        // The minor allele frequencies are 1/8, 1/4, 0, and 0; the last
+        // marker is computed from the two individuals that are not missing.
+        //
+        TEST_EQUAL(std::string("4 2\n0\t1\n0\t1\n0\t0\n1\t0\n"), run(s, "0.1"));
+        TEST_EQUAL(std::string("4 1\n1\n1\n0\n0\n"), run(s, "0.25"));
+        TEST_THROWS(run(s, "0.3"));
+        TEST_EQUAL(std::string("4 4\n0\t1\t2\t0\n0\t1\t2\t3\n"
+            "0\t0\t2\t3\n1\t0\t2\t0\n"), run(s, "0"));
+    }
+
+    // ------------------------------------------------------------------------
+    void test_errors()
+    {
+        TEST_THROWS(run("1 1\n0\n", "0.6"));
+        TEST_THROWS(run("1 1\n0\n", "-0.1"));
+        TEST_THROWS(run("1 2\n0 4\n", "0.1"));
+        TEST_THROWS(run("1 2\n0 1.5\n", "0.1"));
+        TEST_THROWS(run("1 1\n0\n1 1\n0\n1 2\n0 0\n", "0.1"));
+    }
+
+    // ------------------------------------------------------------------------
+    void test_lgm()
+    {
+        //
+        // The minor allele frequencies are 0.2, 0.025, and 0.4; the last
+        // marker is missing for the first individual.
+        //
+        const auto s = R"(
+           2 3
+           0 0 0.5
+           0.2 0 0.5
+
+           2 3
+           0.2 0.1 0.5
+           0.2 0 0.2
+
+           2 3
+           0.8 0.9 0.5
+           0.6 1 0.3
+        )";
+
+        TEST_EQUAL(std::string(
+            "2 2\n0e+00\t5e-01\n2e-01\t5e-01\n\n"
+            "2 2\n2e-01\t5e-01\n2e-01\t2e-01\n\n"
+            "2 2\n8e-01\t5e-01\n6e-01\t3e-01\n"), run(s, "0.15"));
+    }
+}
+
+namespace test
+{
+    test_group maf {
+        TEST_CASE(test_dgm),
+        TEST_CASE(test_errors),
+        TEST_CASE(test_lgm)
+    };
+}
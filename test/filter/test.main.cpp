@@ -10,6 +10,9 @@
 int main(const int argc, const char * argv[])
 {
     return test::execute(argc, argv, {
+        test::ldprune,
+        test::maf,
+        test::missing,
         test::rema
     });
 }
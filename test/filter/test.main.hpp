@@ -11,6 +11,9 @@
 
 namespace test
 {
+    extern test_group ldprune;
+    extern test_group maf;
+    extern test_group missing;
     extern test_group rema;
 }
 
@@ -0,0 +1,79 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.missing.hpp"
+
+namespace
+{
+    // ------------------------------------------------------------------------
+    std::string run(const std::string & text, const char * max_rate)
+    {
+        std::istringstream in (text);
+        std::ostringstream out;
+        jade::args args { "", max_rate };
+        jade::missing missing (args);
+        missing.execute(in, out);
+        return out.str();
+    }
+
+    // ------------------------------------------------------------------------
+    void test_dgm()
+    {
+        const auto s = R"(
+           4 3
+           0 3 3
+           1 3 2
+           2 1 3
+           3 0 3
+        )";
+
+        TEST_EQUAL(std::string("4 1\n0\n1\n2\n3\n"), run(s, "0.25"));
+        TEST_EQUAL(std::string("4 2\n0\t3\n1\t3\n2\t1\n3\t0\n"), run(s, "0.5"));
+        TEST_THROWS(run(s, "0.2"));
+        TEST_EQUAL(std::string("4 3\n0\t3\t3\n1\t3\t2\n2\t1\t3\n3\t0\t3\n"),
+            run(s, "1"));
+    }
+
+    // ------------------------------------------------------------------------
+    void test_errors()
+    {
+        TEST_THROWS(run("1 1\n0\n", "1.5"));
+        TEST_THROWS(run("1 1\n0\n", "-1"));
+        TEST_THROWS(run("1 1\n-1\n", "0.5"));
+    }
+
+    // ------------------------------------------------------------------------
+    void test_lgm()
+    {
+        const auto s = R"(
+           2 2
+           0.1 0.25
+           0.5 0
+
+           2 2
+           0.2 0.25
+           0.5 0
+
+           2 2
+           0.7 0.25
+           0.5 0
+        )";
+
+        TEST_EQUAL(std::string("2 1\n1e-01\n5e-01\n\n2 1\n2e-01\n5e-01\n\n"
+            "2 1\n7e-01\n5e-01\n"), run(s, "0.5"));
+        TEST_THROWS(run(s, "0.4"));
+    }
+}
+
+namespace test
+{
+    test_group missing {
+        TEST_CASE(test_dgm),
+        TEST_CASE(test_errors),
+        TEST_CASE(test_lgm)
+    };
+}
@@ -120,6 +120,74 @@ namespace
         TEST_EQUAL(n1 + 5, m3(1, 1));
     }
 
+    // ------------------------------------------------------------------------
+    void test_all_markers()
+    {
+        std::istringstream in ("2 2\n1 2\n3 4\n");
+        std::ostringstream out;
+        jade::args args { "", "5" };
+        jade::rema rema (args);
+        rema.execute(in, out);
+
+        TEST_EQUAL(std::string("2 2\n1\t2\n3\t4\n"), out.str());
+    }
+
+    // ------------------------------------------------------------------------
+    void test_parallel()
+    {
+        static const size_t rows = 40;
+        static const size_t cols = 5000;
+
+        std::ostringstream text;
+        for (size_t k = 0; k < 3; k++)
+        {
+            text << rows << ' ' << cols << '\n';
+            for (size_t r = 0; r < rows; r++)
+                for (size_t c = 0; c < cols; c++)
+                    text << k * rows * cols + r * cols + c
+                         << (c + 1 == cols ? '\n' : ' ');
+        }
+
+        const auto thread_count = jade::parallel::get_thread_count();
+
+        std::string results[2];
+        for (size_t i = 0; i < 2; i++)
+        {
+            jade::parallel::set_thread_count(i == 0 ? 1 : 4);
+            std::istringstream in (text.str());
+            std::ostringstream out;
+            jade::args args { "", "-s", "7", "1000" };
+            jade::rema rema (args);
+            rema.execute(in, out);
+            results[i] = out.str();
+        }
+
+        jade::parallel::set_thread_count(thread_count);
+        TEST_EQUAL(results[0], results[1]);
+
+        std::istringstream in (results[1]);
+        const jade::basic_matrix<size_t> m1 (in);
+        const jade::basic_matrix<size_t> m2 (in);
+        const jade::basic_matrix<size_t> m3 (in);
+        TEST_TRUE(m3.is_size(rows, 1000));
+
+        auto valid = true;
+        for (size_t r = 0; r < rows; r++)
+        {
+            for (size_t c = 0; c < 1000; c++)
+            {
+                const auto col = m1(0, c);
+                valid = valid && col < cols
+                    && (c == 0 || m1(0, c - 1) < col)
+                    && m1(r, c) == r * cols + col
+                    && m2(r, c) == rows * cols + r * cols + col
+                    && m3(r, c) == 2 * rows * cols + r * cols + col;
+            }
+        }
+
+        TEST_TRUE(valid);
+    }
+
     // ------------------------------------------------------------------------
     void test_error_reading_second_matrix_dimensions()
     {
@@ -269,6 +337,7 @@ namespace
 namespace test
 {
     test::test_group rema {
+        TEST_CASE(::test_all_markers),
         TEST_CASE(::test_dgm),
         TEST_CASE(::test_error_reading_matrix_dimensions),
         TEST_CASE(::test_error_reading_second_matrix_dimensions),
@@ -279,6 +348,7 @@ namespace test
         TEST_CASE(::test_invalid_number_of_markers),
         TEST_CASE(::test_lgm),
         TEST_CASE(::test_missing_argument_for_option),
+        TEST_CASE(::test_parallel),
         TEST_CASE(::test_unexpected_end_of_matrix_data),
         TEST_CASE(::test_unexpected_symbol_after_matrix_data)
     };
@@ -0,0 +1,71 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.brent.hpp"
+
+namespace
+{
+    typedef jade::brent brent_type;
+
+    // ------------------------------------------------------------------------
+    void boundary()
+    {
+        //
+        // The maximum of an increasing function is found near the upper bound.
+        //
+        size_t count = 0;
+        double x;
+        const auto fx = brent_type::maximize([&](const double t)
+        {
+            count++;
+            return t;
+        }, 0.0, 1.0, 1.0e-8, x);
+
+        TEST_ALMOST(1.0, x, 1.0e-6);
+        TEST_ALMOST(1.0, fx, 1.0e-6);
+        TEST_TRUE(count < 100);
+    }
+
+    // ------------------------------------------------------------------------
+    void parabola()
+    {
+        size_t count = 0;
+        double x;
+        const auto fx = brent_type::maximize([&](const double t)
+        {
+            count++;
+            return 2.0 - (t - 0.3) * (t - 0.3);
+        }, -1.0, 4.0, 1.0e-6, x);
+
+        TEST_ALMOST(0.3, x, 1.0e-6);
+        TEST_ALMOST(2.0, fx, 1.0e-12);
+        TEST_TRUE(count < 10);
+    }
+
+    // ------------------------------------------------------------------------
+    void smooth()
+    {
+        double x;
+        const auto fx = brent_type::maximize([](const double t)
+        {
+            return std::log(t) - t * t;
+        }, 0.01, 3.0, 1.0e-10, x);
+
+        const auto expected = std::sqrt(0.5);
+        TEST_ALMOST(expected, x, 1.0e-6);
+        TEST_ALMOST(std::log(expected) - 0.5, fx, 1.0e-10);
+    }
+}
+
+namespace test
+{
+    test_group brent {
+        TEST_CASE(boundary),
+        TEST_CASE(parabola),
+        TEST_CASE(smooth)
+    };
+}
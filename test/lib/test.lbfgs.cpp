@@ -0,0 +1,115 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.lbfgs.hpp"
+
+namespace
+{
+    typedef jade::lbfgs                 lbfgs_type;
+    typedef lbfgs_type::container_type  container_type;
+
+    // ------------------------------------------------------------------------
+    template <typename TObjfunc>
+    void minimize(
+            lbfgs_type &     lbfgs,
+            const TObjfunc & objfunc,
+            const size_t     max_iterations)
+    {
+        for (size_t i = 0; i < max_iterations; i++)
+            if (!lbfgs.iterate(objfunc))
+                break;
+    }
+
+    // ------------------------------------------------------------------------
+    void quadratic()
+    {
+        //
+        // A convex quadratic function with its minimum at (1, -2, 3).
+        //
+        const auto objfunc = [](
+                const container_type & x,
+                container_type &       g)
+            -> double
+        {
+            const auto a = x[0] - 1.0;
+            const auto b = x[1] + 2.0;
+            const auto c = x[2] - 3.0;
+            g[0] = 2.0 * a + b;
+            g[1] = a + 20.0 * b;
+            g[2] = 0.2 * c;
+            return a * a + a * b + 10.0 * b * b + 0.1 * c * c;
+        };
+
+        lbfgs_type lbfgs (objfunc, { 0.0, 0.0, 0.0 });
+        TEST_EQUAL(size_t(1), lbfgs.get_evaluations());
+
+        minimize(lbfgs, objfunc, 100);
+
+        const auto & x = lbfgs.get_vertex();
+        TEST_ALMOST(+1.0, x[0], 1.0e-6);
+        TEST_ALMOST(-2.0, x[1], 1.0e-6);
+        TEST_ALMOST(+3.0, x[2], 1.0e-6);
+        TEST_ALMOST(0.0, lbfgs.get_objval(), 1.0e-10);
+        TEST_TRUE(lbfgs.get_gradient_norm() < 1.0e-5);
+        TEST_TRUE(lbfgs.get_iterations() < 30);
+    }
+
+    // ------------------------------------------------------------------------
+    void rosenbrock()
+    {
+        const auto objfunc = [](
+                const container_type & x,
+                container_type &       g)
+            -> double
+        {
+            const auto a = 1.0 - x[0];
+            const auto b = x[1] - x[0] * x[0];
+            g[0] = -2.0 * a - 400.0 * x[0] * b;
+            g[1] = 200.0 * b;
+            return a * a + 100.0 * b * b;
+        };
+
+        lbfgs_type lbfgs (objfunc, { -1.2, 1.0 });
+        minimize(lbfgs, objfunc, 1000);
+
+        const auto & x = lbfgs.get_vertex();
+        TEST_ALMOST(1.0, x[0], 1.0e-5);
+        TEST_ALMOST(1.0, x[1], 1.0e-5);
+        TEST_TRUE(lbfgs.get_iterations() < 100);
+    }
+
+    // ------------------------------------------------------------------------
+    void stationary()
+    {
+        //
+        // No step decreases a function at its minimum, so the iteration
+        // fails and leaves the parameters unchanged.
+        //
+        const auto objfunc = [](
+                const container_type & x,
+                container_type &       g)
+            -> double
+        {
+            g[0] = 2.0 * x[0];
+            return x[0] * x[0];
+        };
+
+        lbfgs_type lbfgs (objfunc, { 0.0 });
+        TEST_FALSE(lbfgs.iterate(objfunc));
+        TEST_EQUAL(size_t(0), lbfgs.get_iterations());
+        TEST_ALMOST(0.0, lbfgs.get_vertex()[0], 1.0e-12);
+    }
+}
+
+namespace test
+{
+    test_group lbfgs {
+        TEST_CASE(quadratic),
+        TEST_CASE(rosenbrock),
+        TEST_CASE(stationary)
+    };
+}
@@ -15,6 +15,48 @@ namespace
 
     static const auto epsilon = value_type(0.0001);
 
+    // ------------------------------------------------------------------------
+    // Solves a Q-step subproblem in the form qpas builds it with Lemke's
+    // algorithm: the components are shifted by one to be nonnegative, and
+    // the sum is constrained with a pair of opposite inequalities, which tie
+    // in the ratio tests along with the bounds. The solution is compared to
+    // the expected change of the row.
+    //
+    void test_q_step(
+            const matrix_type & row,
+            const matrix_type & h,
+            const matrix_type & d,
+            const matrix_type & expected)
+    {
+        const auto K = row.get_length();
+
+        matrix_type a (K + K + 2, K);
+        matrix_type b (K + K + 2, 1);
+        for (size_t k = 0; k < K; k++)
+        {
+            a(k, k)         = value_type(-1);
+            a(K + k, k)     = value_type(+1);
+            a(K + K, k)     = value_type(+1);
+            a(K + K + 1, k) = value_type(-1);
+            b[K + k]        = value_type(1);
+        }
+
+        b[K + K]     = value_type(+1);
+        b[K + K + 1] = value_type(-1);
+
+        matrix_type shift (K, 1);
+        shift.set_values(value_type(1));
+        b -= a * row.create_transpose();
+        b += a * shift;
+
+        lemke_type lemke (-h, -a, h * shift - d, -b);
+        TEST_TRUE(lemke.solve());
+
+        const auto z = lemke.get_output();
+        for (size_t k = 0; k < K; k++)
+            TEST_ALMOST(expected[k], z[k] - value_type(1), epsilon);
+    }
+
     // ------------------------------------------------------------------------
     void constructor()
     {
@@ -70,6 +112,77 @@ namespace
             TEST_EQUAL(i, labels[i]);
     }
 
+    // ------------------------------------------------------------------------
+    void complementarity()
+    {
+        //
+        // A quadratic program with bounds and a bounded sum, like those of
+        // qpas; the solution satisfies w = M z + q, w >= 0, z >= 0, and
+        // w' z = 0.
+        //
+        const matrix_type q {
+            { 2, 1, 0, 0 },
+            { 1, 3, 1, 0 },
+            { 0, 1, 4, 1 },
+            { 0, 0, 1, 2 }
+        };
+
+        const matrix_type a {
+            { +1, +0, +0, +0 },
+            { +0, +1, +0, +0 },
+            { +0, +0, +1, +0 },
+            { +0, +0, +0, +1 },
+            { -1, +0, +0, +0 },
+            { +0, -1, +0, +0 },
+            { +0, +0, -1, +0 },
+            { +0, +0, +0, -1 },
+            { +1, +1, +1, +1 },
+            { -1, -1, -1, -1 }
+        };
+
+        const matrix_type c { { -4 }, { 1 }, { -6 }, { 3 } };
+
+        const matrix_type b {
+            { +0 }, { +0 }, { +0 }, { +0 },
+            { -1 }, { -1 }, { -1 }, { -1 },
+            { +1 }, { -2 }
+        };
+
+        lemke_type lemke (q, a, c, b);
+        TEST_TRUE(lemke.solve());
+
+        const auto z = lemke.get_output();
+        TEST_EQUAL(size_t(14), z.get_length());
+        TEST_ALMOST(value_type(1.0), z[0], epsilon);
+        TEST_ALMOST(value_type(0.0), z[1], epsilon);
+        TEST_ALMOST(value_type(1.0), z[2], epsilon);
+        TEST_ALMOST(value_type(0.0), z[3], epsilon);
+
+        const auto n = z.get_length();
+        for (size_t i = 0; i < n; i++)
+        {
+            auto w = i < 4 ? c[i] : -b[i - 4];
+            for (size_t j = 0; j < 4; j++)
+                w += (i < 4 ? q(i, j) : a(i - 4, j)) * z[j];
+            for (size_t j = 4; j < n; j++)
+                w -= (i < 4 ? a(j - 4, i) : value_type(0)) * z[j];
+
+            TEST_TRUE(w > -epsilon);
+            TEST_TRUE(z[i] > -epsilon);
+            TEST_ALMOST(value_type(0), w * z[i], epsilon);
+        }
+
+        //
+        // The q column of the tableau holds the values of the basic
+        // variables.
+        //
+        const auto t      = lemke.get_tableau();
+        const auto labels = lemke.get_labels();
+        for (size_t i = 0; i < n; i++)
+            if (labels[i] >= n && labels[i] < n + n)
+                TEST_ALMOST(z[labels[i] - n], t(i, n + n + 1), epsilon);
+    }
+
     // ------------------------------------------------------------------------
     void iterate()
     {
@@ -119,6 +232,88 @@ namespace
         TEST_ALMOST(value_type(5.0), output[6], epsilon);
     }
 
+    // ------------------------------------------------------------------------
+    void q_step()
+    {
+        //
+        // Each of these subproblems ties the sum rows with bounds in exact
+        // arithmetic, so the choice of pivot row must not depend on the
+        // rounding errors of the ratios.
+        //
+        const matrix_type h1 {
+            { -4, -1, +0 },
+            { -1, -4, -1 },
+            { +0, -1, -4 }
+        };
+
+        const matrix_type h2 {
+            { -2, +0, +0 },
+            { +0, -2, +0 },
+            { +0, +0, -2 }
+        };
+
+        const matrix_type r1 { { 0.2, 0.3, 0.5 } };
+        const matrix_type r2 { { 0.25, 0.25, 0.5 } };
+        const matrix_type r3 { { 0.1, 0.6, 0.3 } };
+
+        test_q_step(r1, h1, matrix_type { { 1 }, { 2 }, { -1 } },
+            matrix_type { { 0.0 }, { 0.5 }, { -0.5 } });
+        test_q_step(r1, h1, matrix_type { { 4 }, { -1 }, { -2 } },
+            matrix_type { { 0.8 }, { -0.3 }, { -0.5 } });
+        test_q_step(r2, h2, matrix_type { { -3 }, { 1 }, { 2 } },
+            matrix_type { { -0.25 }, { -0.125 }, { 0.375 } });
+        test_q_step(r2, h2, matrix_type { { 0.5 }, { 0.5 }, { -1 } },
+            matrix_type { { 0.25 }, { 0.25 }, { -0.5 } });
+        test_q_step(r3, h1, matrix_type { { 1 }, { -1 }, { 0 } },
+            matrix_type { { 0.3125 }, { -0.375 }, { 0.0625 } });
+    }
+
+    // ------------------------------------------------------------------------
+    void reset()
+    {
+        const matrix_type t1 {
+            { +1, +0, -2, -1, -1, -6 },
+            { +0, +1, +1, +0, -1, +4 }
+        };
+
+        const matrix_type t2 {
+            { 1, 0, 0, 0, 0, 0, 0, -2, -0, +1, +0, -1, +1, -1, -1, -8 },
+            { 0, 1, 0, 0, 0, 0, 0, -0, -2, +0, +1, -1, +1, -1, -1, -6 },
+            { 0, 0, 1, 0, 0, 0, 0, -1, -0, -0, -0, -0, -0, -0, -1, -0 },
+            { 0, 0, 0, 1, 0, 0, 0, -0, -1, -0, -0, -0, -0, -0, -1, -0 },
+            { 0, 0, 0, 0, 1, 0, 0, +1, +1, -0, -0, -0, -0, -0, -1, +5 },
+            { 0, 0, 0, 0, 0, 1, 0, -1, -1, -0, -0, -0, -0, -0, -1, -2 },
+            { 0, 0, 0, 0, 0, 0, 1, +1, +1, -0, -0, -0, -0, -0, -1, +2 }
+        };
+
+        lemke_type lemke;
+        TEST_FALSE(lemke.is_executing());
+
+        //
+        // Solve problems of different sizes with the same instance.
+        //
+        for (size_t i = 0; i < 2; i++)
+        {
+            lemke.reset(t1);
+            TEST_TRUE(lemke.is_executing());
+            TEST_TRUE(lemke.solve());
+
+            const auto out1 = lemke.get_output();
+            TEST_EQUAL(size_t(2), out1.get_length());
+            TEST_ALMOST(value_type(3.0), out1[0], epsilon);
+            TEST_ALMOST(value_type(0.0), out1[1], epsilon);
+
+            lemke.reset(t2);
+            TEST_TRUE(lemke.solve());
+
+            const auto out2 = lemke.get_output();
+            TEST_EQUAL(size_t(7), out2.get_length());
+            TEST_ALMOST(value_type(1.5), out2[0], epsilon);
+            TEST_ALMOST(value_type(0.5), out2[1], epsilon);
+            TEST_ALMOST(value_type(5.0), out2[6], epsilon);
+        }
+    }
+
     // ------------------------------------------------------------------------
     void solve()
     {
@@ -154,9 +349,12 @@ namespace
 namespace test
 {
     test_group lemke {
+        TEST_CASE(complementarity),
         TEST_CASE(constructor),
         TEST_CASE(iterate),
         TEST_CASE(output),
+        TEST_CASE(q_step),
+        TEST_CASE(reset),
         TEST_CASE(solve)
     };
 }
@@ -0,0 +1,137 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.likelihood.hpp"
+
+namespace
+{
+    typedef double value_type;
+    typedef jade::basic_likelihood<value_type> likelihood_type;
+    typedef jade::basic_matrix<value_type> matrix_type;
+
+    // ------------------------------------------------------------------------
+    void add()
+    {
+        const matrix_type rf {
+            {  0.1, -0.2, 0.3,  0.0, -0.1 },
+            { -0.3,  0.1, 0.2, -0.2,  0.4 }
+        };
+
+        const matrix_type mu { { 0.2 }, { 0.5 }, { 0.0 }, { 0.7 }, { 0.4 } };
+
+        const matrix_type c {
+            { 2.0, 0.5 },
+            { 0.5, 1.0 }
+        };
+
+        auto c_inv = c;
+        value_type log_c_det;
+        TEST_TRUE(c_inv.invert(log_c_det));
+
+        //
+        // Combining the blocks of markers produces the same likelihood as
+        // all markers; the third marker has mu * (1 - mu) equal to zero.
+        //
+        const likelihood_type all (rf, mu);
+        const likelihood_type lhs (rf, mu, 0, 2);
+        const likelihood_type rhs (rf, mu, 2, 5);
+
+        likelihood_type sum (2);
+        TEST_EQUAL(size_t(0), sum.get_j());
+        sum.add(lhs, 1);
+        sum.add(rhs, 1);
+
+        TEST_EQUAL(size_t(5), all.get_j());
+        TEST_EQUAL(size_t(5), sum.get_j());
+        TEST_ALMOST(all(c_inv, log_c_det), sum(c_inv, log_c_det), 1.0e-12);
+
+        //
+        // Adding a block twice is the same as adding it to itself.
+        //
+        likelihood_type twice (2);
+        twice.add(lhs, 2);
+
+        likelihood_type copies (lhs);
+        copies.add(lhs, 1);
+
+        TEST_EQUAL(size_t(4), twice.get_j());
+        TEST_ALMOST(
+            copies(c_inv, log_c_det),
+            twice(c_inv, log_c_det),
+            1.0e-12);
+    }
+
+    // ------------------------------------------------------------------------
+    void compute_gradient()
+    {
+        const matrix_type rf {
+            {  0.1, -0.2, 0.3 },
+            { -0.3,  0.1, 0.2 }
+        };
+
+        const matrix_type mu { { 0.2 }, { 0.5 }, { 0.6 } };
+        const likelihood_type likelihood (rf, mu);
+
+        const matrix_type c {
+            { 2.0, 0.5 },
+            { 0.5, 1.0 }
+        };
+
+        const auto f = [&](const matrix_type & m) -> value_type
+        {
+            auto m_inv = m;
+            auto log_m_det = value_type(0);
+            TEST_TRUE(m_inv.invert(log_m_det));
+            return likelihood(m_inv, log_m_det);
+        };
+
+        auto c_inv = c;
+        value_type log_c_det;
+        TEST_TRUE(c_inv.invert(log_c_det));
+
+        matrix_type gradient (2, 2);
+        TEST_ALMOST(
+            f(c),
+            likelihood.compute_gradient(c_inv, log_c_det, gradient),
+            1.0e-12);
+
+        //
+        // Compare the gradient to central differences. The inverse reads only
+        // the lower triangle, so perturb C symmetrically; an off-diagonal
+        // perturbation then changes both cells, and the difference is twice
+        // the gradient entry.
+        //
+        static const auto h = 1.0e-6;
+        for (size_t i = 0; i < 2; i++)
+        {
+            for (size_t j = 0; j <= i; j++)
+            {
+                auto lo = c, hi = c;
+                lo(i, j) -= h;
+                hi(i, j) += h;
+                lo(j, i) = lo(i, j);
+                hi(j, i) = hi(i, j);
+
+                const auto scale = value_type(i == j ? 1 : 2);
+                TEST_ALMOST(
+                    (f(hi) - f(lo)) / (2 * h),
+                    scale * gradient(i, j),
+                    1.0e-6);
+            }
+        }
+
+        TEST_ALMOST(gradient(0, 1), gradient(1, 0), 1.0e-12);
+    }
+}
+
+namespace test
+{
+    test_group likelihood {
+        TEST_CASE(add),
+        TEST_CASE(compute_gradient)
+    };
+}
@@ -12,9 +12,12 @@ int main(const int argc, const char * argv[])
     return test::execute(argc, argv, {
         test::agi_reader,
         test::args,
+        test::brent,
         test::discrete_genotype_matrix,
         test::error,
+        test::lbfgs,
         test::lemke,
+        test::likelihood,
         test::likelihood_genotype_matrix,
         test::matrix,
         test::neighbor_joining,
@@ -24,6 +27,10 @@ int main(const int argc, const char * argv[])
         test::simplex,
         test::stopwatch,
         test::svg_tree,
+        test::text_reader,
+        test::text_writer,
+        test::topology,
+        test::vcf_reader,
         test::vec2
     });
 }
@@ -13,9 +13,12 @@ namespace test
 {
     extern test_group agi_reader;
     extern test_group args;
+    extern test_group brent;
     extern test_group discrete_genotype_matrix;
     extern test_group error;
+    extern test_group lbfgs;
     extern test_group lemke;
+    extern test_group likelihood;
     extern test_group likelihood_genotype_matrix;
     extern test_group matrix;
     extern test_group neighbor_joining;
@@ -25,6 +28,10 @@ namespace test
     extern test_group simplex;
     extern test_group stopwatch;
     extern test_group svg_tree;
+    extern test_group text_reader;
+    extern test_group text_writer;
+    extern test_group topology;
+    extern test_group vcf_reader;
     extern test_group vec2;
 }
 
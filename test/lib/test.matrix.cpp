@@ -449,6 +449,33 @@ namespace
         TEST_EQUAL(int_type(45), m.get_sum());
     }
 
+    // ------------------------------------------------------------------------
+    void syev()
+    {
+        const real_matrix m0 {
+            { 2, 1, 0 },
+            { 1, 2, 0 },
+            { 0, 0, 5 }
+        };
+
+        real_matrix m = m0;
+        real_matrix w;
+        TEST_TRUE(m.syev_lower(w));
+        TEST_TRUE(w.is_size(3, 1));
+
+        TEST_ALMOST(real_type(1.0), w[0], epsilon);
+        TEST_ALMOST(real_type(3.0), w[1], epsilon);
+        TEST_ALMOST(real_type(5.0), w[2], epsilon);
+
+        for (size_t k = 0; k < 3; k++)
+        {
+            const auto v  = m.copy_column(k);
+            const auto mv = m0 * v;
+            for (size_t r = 0; r < 3; r++)
+                TEST_ALMOST(w[k] * v[r], mv[r], epsilon);
+        }
+    }
+
     // ------------------------------------------------------------------------
     void transpose()
     {
@@ -533,6 +560,7 @@ namespace test
         TEST_CASE(resize),
         TEST_CASE(row),
         TEST_CASE(sum),
+        TEST_CASE(syev),
         TEST_CASE(transpose),
         TEST_CASE(write)
     };
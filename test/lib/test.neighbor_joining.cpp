@@ -13,6 +13,30 @@ namespace
     typedef jade::basic_neighbor_joining<value_type> neighbor_joining_type;
     typedef jade::basic_matrix<value_type> matrix_type;
 
+    // ------------------------------------------------------------------------
+    void additive()
+    {
+        //
+        // The distances between the leaves of the tree
+        // ((0:1,1:2):3,(2:1,3:4):2,(4:2,5:1):1); neighbor joining recovers
+        // an additive tree exactly.
+        //
+        const matrix_type distances {
+            {  0,  3,  7, 10,  7,  6 },
+            {  3,  0,  8, 11,  8,  7 },
+            {  7,  8,  0,  5,  6,  5 },
+            { 10, 11,  5,  0,  9,  8 },
+            {  7,  8,  6,  9,  0,  3 },
+            {  6,  7,  5,  8,  3,  0 }
+        };
+
+        const neighbor_joining_type neighbor_joining (distances);
+
+        TEST_EQUAL(
+            std::string("(4:2,((1:2,0:1):3,(3:4,2:1):2):1,5:1);"),
+            neighbor_joining.str());
+    }
+
     // ------------------------------------------------------------------------
     void constructor()
     {
@@ -35,6 +59,7 @@ namespace
 namespace test
 {
     test_group neighbor_joining {
+        TEST_CASE(additive),
         TEST_CASE(constructor)
     };
 }
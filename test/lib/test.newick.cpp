@@ -47,6 +47,41 @@ namespace
         }
     }
 
+    // ------------------------------------------------------------------------
+    void deep()
+    {
+        //
+        // Parse, write, and reroot a caterpillar tree deep enough to
+        // overflow the stack if any of these operations were recursive.
+        //
+        const size_t n = 200000;
+
+        std::ostringstream out;
+        out << std::string(n - 1, '(') << 0;
+        for (size_t i = 1; i < n; i++)
+            out << ',' << i << ')';
+        out << ';';
+
+        const auto str = out.str();
+        node_type node (str);
+        TEST_EQUAL(str, node.str());
+        TEST_EQUAL(n, node.find_leafs().size());
+
+        const auto leaf = node.find_name("0");
+        const auto id   = leaf->get_id();
+        TEST_EQUAL(int(n), id);
+        TEST_EQUAL(leaf, node.find_id(id));
+        TEST_EQUAL(&node, leaf->find_root());
+
+        node.reroot(leaf);
+        TEST_EQUAL(std::string("0"), node.get_name());
+        TEST_EQUAL(id, node.get_id());
+        TEST_EQUAL(n - 1, node.find_leafs().size());
+        TEST_EQUAL(&node, node.find_id(1)->find_root());
+        TEST_EQUAL(std::to_string(n - 1), node.find_id(1)->get_children()
+            .front()->get_name());
+    }
+
     // ------------------------------------------------------------------------
     void encode()
     {
@@ -355,6 +390,30 @@ namespace
 
         ptr_type e (node.find_name("e")->reroot());
         TEST_EQUAL(std::string("((d:3,(b:1)a:2)c:4)e;"), e->str());
+
+        //
+        // Reroot in place; this node remains the root and takes the
+        // contents of the new root, and the ids persist.
+        //
+        const auto id_a = node.find_name("a")->get_id();
+        const auto id_c = node.find_name("c")->get_id();
+        const auto id_d = node.find_name("d")->get_id();
+
+        node.reroot(node.find_name("c"));
+        TEST_EQUAL(std::string("(d:3,e:4,(b:1)a:2)c;"), node.str());
+        TEST_EQUAL(id_c, node.get_id());
+        TEST_EQUAL(std::string("a"), node.find_id(id_a)->get_name());
+        TEST_EQUAL(&node, node.find_id(id_a)->get_parent());
+
+        node.reroot(node.find_id(id_d));
+        TEST_EQUAL(std::string("((e:4,(b:1)a:2)c:3)d;"), node.str());
+        TEST_EQUAL(id_d, node.get_id());
+
+        node.reroot(node.find_id(id_a));
+        TEST_EQUAL(std::string("(b:1,(e:4,d:3)c:2)a;"), node.str());
+        TEST_EQUAL(std::string("c"), node.find_id(id_c)->get_name());
+        TEST_EQUAL(&node, node.find_id(id_c)->get_parent());
+        TEST_EQUAL(node.find_id(id_c), node.find_id(id_d)->get_parent());
     }
 
     // ------------------------------------------------------------------------
@@ -374,6 +433,7 @@ namespace test
 {
     test_group newick {
         TEST_CASE(constructor),
+        TEST_CASE(deep),
         TEST_CASE(encode),
         TEST_CASE(find_all),
         TEST_CASE(find_descendents),
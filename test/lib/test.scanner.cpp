@@ -117,10 +117,18 @@ namespace
         TEST_ALMOST(value_type(-1234.5), neg.read_real<value_type>(), epsilon);
         TEST_ALMOST(value_type(-1234.56), neg.read_real<value_type>(), epsilon);
 
+        jade::scanner exp (" 1e-07 -2.5E+3 3e2,");
+        TEST_ALMOST(value_type(1.0e-7), exp.read_real<value_type>(), 0.0);
+        TEST_ALMOST(value_type(-2500.0), exp.read_real<value_type>(), 0.0);
+        TEST_ALMOST(value_type(300.0), exp.read_real<value_type>(), 0.0);
+        TEST_TRUE(exp.try_char(','));
+
         TEST_THROWS(jade::scanner("").read_real<value_type>());
         TEST_THROWS(jade::scanner("a").read_real<value_type>());
         TEST_THROWS(jade::scanner(".x").read_real<value_type>());
         TEST_THROWS(jade::scanner("-x").read_real<value_type>());
+        TEST_THROWS(jade::scanner("1e").read_real<value_type>());
+        TEST_THROWS(jade::scanner("e5").read_real<value_type>());
     }
 
     // ------------------------------------------------------------------------
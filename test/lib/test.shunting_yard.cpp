@@ -12,6 +12,7 @@ namespace
     typedef double                                float_type;
     typedef jade::basic_shunting_yard<float_type> evaluator_type;
     typedef evaluator_type::args_type             args_type;
+    typedef evaluator_type::program_type          program_type;
 
     static const float_type epsilon = 1.0e-6;
 
@@ -72,6 +73,43 @@ namespace
         ::test_evaluation(8.7, "1.2 + 3 + 4.5");
     }
 
+    // ------------------------------------------------------------------------
+    void compile()
+    {
+        //
+        // Compile several expressions into one program, storing each output
+        // at a different index, and compare the outputs to the values from
+        // evaluating the expressions with a table of arguments.
+        //
+        const std::vector<std::string> names { "y", "x", "z" };
+        const std::vector<std::string> expressions {
+            "3*(x+2)*y", "x/3-y/2", "1.5", "z-(x-y)/(z*2)" };
+        const std::vector<float_type>  values { 4.0, 9.0, 0.5 };
+        const args_type args { { "y", 4.0 }, { "x", 9.0 }, { "z", 0.5 } };
+
+        program_type program;
+        for (size_t i = 0; i < expressions.size(); i++)
+            evaluator_type(expressions[i]).compile(names, 3 - i, program);
+
+        TEST_EQUAL(size_t(4), program.get_output_count());
+        TEST_EQUAL(size_t(4), program.get_stack_size());
+
+        std::vector<float_type> stack   (program.get_stack_size());
+        std::vector<float_type> outputs (program.get_output_count());
+        program.evaluate(values.data(), stack.data(), outputs.data());
+
+        for (size_t i = 0; i < expressions.size(); i++)
+        {
+            const auto expected = evaluator_type(expressions[i])(args);
+            TEST_ALMOST(expected, outputs[3 - i], epsilon);
+        }
+
+        //
+        // Compilation fails if a variable is not in the list of names.
+        //
+        TEST_THROWS(evaluator_type("x+w").compile(names, 0, program));
+    }
+
     // ------------------------------------------------------------------------
     void division()
     {
@@ -80,6 +118,64 @@ namespace
         ::test_evaluation(0.115942, "1.2 / 2.3 / 4.5");
     }
 
+    // ------------------------------------------------------------------------
+    void gradient()
+    {
+        //
+        // Compare the derivatives from forward-mode differentiation to
+        // central differences of the compiled expressions.
+        //
+        const std::vector<std::string> names { "x", "y" };
+        const std::vector<std::string> expressions {
+            "3*(x+2)*y", "x/y-y/2", "2.5", "x*x/(y-x*y)" };
+
+        program_type program;
+        for (size_t i = 0; i < expressions.size(); i++)
+            evaluator_type(expressions[i]).compile(names, i, program);
+
+        const auto n = names.size();
+        const auto m = program.get_output_count();
+        std::vector<float_type> stack    (program.get_stack_size());
+        std::vector<float_type> dstack   (program.get_stack_size() * n);
+        std::vector<float_type> outputs  (m);
+        std::vector<float_type> doutputs (m * n);
+
+        std::vector<float_type> args { 0.3, 1.7 };
+        program.evaluate_gradient(
+            args.data(),
+            n,
+            stack.data(),
+            dstack.data(),
+            outputs.data(),
+            doutputs.data());
+
+        std::vector<float_type> expected (m);
+        program.evaluate(args.data(), stack.data(), expected.data());
+        for (size_t i = 0; i < m; i++)
+            TEST_ALMOST(expected[i], outputs[i], epsilon);
+
+        static const float_type h = 1.0e-6;
+        std::vector<float_type> lhs (m), rhs (m);
+        for (size_t k = 0; k < n; k++)
+        {
+            const auto arg = args[k];
+            args[k] = arg + h;
+            program.evaluate(args.data(), stack.data(), rhs.data());
+            args[k] = arg - h;
+            program.evaluate(args.data(), stack.data(), lhs.data());
+            args[k] = arg;
+
+            for (size_t i = 0; i < m; i++)
+                TEST_ALMOST(
+                    (rhs[i] - lhs[i]) / (2.0 * h),
+                    doutputs[i * n + k],
+                    epsilon);
+        }
+
+        TEST_ALMOST(0.0, doutputs[2 * n + 0], epsilon);
+        TEST_ALMOST(0.0, doutputs[2 * n + 1], epsilon);
+    }
+
     // ------------------------------------------------------------------------
     void main()
     {
@@ -116,8 +212,10 @@ namespace test
 {
     test_group shunting_yard {
         TEST_CASE(addition),
+        TEST_CASE(compile),
         TEST_CASE(constructor),
         TEST_CASE(division),
+        TEST_CASE(gradient),
         TEST_CASE(main),
         TEST_CASE(multiplication),
         TEST_CASE(subtraction)
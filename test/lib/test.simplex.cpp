@@ -348,6 +348,105 @@ namespace
             TEST_ALMOST(value_type(i), v[i], epsilon);
     }
 
+    // ------------------------------------------------------------------------
+    void parallel()
+    {
+        typedef basic_himmelblau<value_type>        objfunc_type;
+        typedef typename objfunc_type::simplex_type simplex_type;
+        typedef typename simplex_type::options      options_type;
+        typedef typename simplex_type::stats        stats_type;
+
+        //
+        // The objective function receives the thread number, which must be
+        // in the range of the threads used to evaluate the simplex.
+        //
+        const auto thread_count = jade::parallel::get_thread_count();
+        std::atomic<bool> is_thread_valid (true);
+        const auto objfunc = [&](
+                const std::vector<value_type> & params,
+                const size_t                    thread)
+            -> value_type
+        {
+            if (thread >= thread_count)
+                is_thread_valid = false;
+            return objfunc_type::objfunc(params);
+        };
+
+        for (const auto speculative : { false, true })
+        {
+            options_type serial_opts (2);
+            serial_opts.vertex[0] = +1;
+            serial_opts.vertex[1] = -1;
+
+            options_type parallel_opts (serial_opts);
+            parallel_opts.parallel    = true;
+            parallel_opts.speculative = speculative;
+
+            simplex_type serial_s   (objfunc_type::objfunc, serial_opts);
+            simplex_type parallel_s (objfunc, parallel_opts);
+
+            //
+            // The simplex must take the same steps in every mode.
+            //
+            for (size_t i = 0; i < 50; i++)
+                TEST_EQUAL(
+                    serial_s.iterate(objfunc_type::objfunc),
+                    parallel_s.iterate(objfunc));
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                TEST_EQUAL(str(serial_s, i), str(parallel_s, i));
+                TEST_ALMOST(
+                    serial_s.get_objval(i),
+                    parallel_s.get_objval(i),
+                    epsilon);
+            }
+
+            const stats_type & a = serial_s.get_stats();
+            const stats_type & b = parallel_s.get_stats();
+            TEST_EQUAL(a.iterations,       b.iterations);
+            TEST_EQUAL(a.reflections,      b.reflections);
+            TEST_EQUAL(a.expansions,       b.expansions);
+            TEST_EQUAL(a.contractions_in,  b.contractions_in);
+            TEST_EQUAL(a.contractions_out, b.contractions_out);
+            TEST_EQUAL(a.shrinkages,       b.shrinkages);
+
+            //
+            // Speculative mode evaluates all four trial vertices in every
+            // iteration and the shrunken vertices after a shrinkage.
+            //
+            if (speculative)
+                TEST_EQUAL(
+                    3 + 4 * b.iterations + 2 * b.shrinkages,
+                    b.evaluations);
+            else
+                TEST_EQUAL(a.evaluations, b.evaluations);
+        }
+
+        TEST_TRUE(is_thread_valid);
+
+        //
+        // Without the parallel option, speculative mode has no effect, and
+        // the vertices are evaluated only as they are needed.
+        //
+        options_type lazy_opts (2);
+        lazy_opts.vertex[0]   = +1;
+        lazy_opts.vertex[1]   = -1;
+        options_type speculative_opts (lazy_opts);
+        speculative_opts.speculative = true;
+
+        simplex_type lazy_s        (objfunc_type::objfunc, lazy_opts);
+        simplex_type speculative_s (objfunc_type::objfunc, speculative_opts);
+        for (size_t i = 0; i < 50; i++)
+            TEST_EQUAL(
+                lazy_s.iterate(objfunc_type::objfunc),
+                speculative_s.iterate(objfunc_type::objfunc));
+
+        TEST_EQUAL(
+            lazy_s.get_stats().evaluations,
+            speculative_s.get_stats().evaluations);
+    }
+
     // ------------------------------------------------------------------------
     void options()
     {
@@ -395,6 +494,7 @@ namespace test
         TEST_CASE(himmelblau),
         TEST_CASE(length_squared),
         TEST_CASE(many_parameters),
-        TEST_CASE(options)
+        TEST_CASE(options),
+        TEST_CASE(parallel)
     };
 }
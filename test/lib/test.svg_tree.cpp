@@ -26,11 +26,113 @@ namespace
         svg.write(out);
         remove(path);
     }
+
+    // ------------------------------------------------------------------------
+    void coincident_nodes()
+    {
+        //
+        // The root and its twelve leaves with zero lengths are at the same
+        // point, so the quadtree divides their cell down to its maximum
+        // depth. Every cell is either a single point or a distant leaf, so
+        // the approximations are exact, and the default theta must give the
+        // same sum and gradient as a theta of zero; in particular, no node
+        // may be approximated as part of a cell containing itself.
+        //
+        std::ostringstream in;
+        in << '(';
+        for (size_t i = 0; i < 12; i++)
+            in << i << ":0,";
+        in << "12:1);";
+
+        const node_type tree (in.str());
+        svg_tree_type svg (tree);
+
+        std::vector<value_type> params;
+        for (size_t i = 0; i < 13; i++)
+            params.push_back(0.5 * value_type(i));
+
+        std::vector<value_type> exact, approx;
+        const auto f_exact  = svg.compute_objfunc(params, exact, 0.0);
+        const auto f_approx = svg.compute_objfunc(params, approx, 0.5);
+
+        TEST_ALMOST(f_exact, f_approx, 1.0e-9 * f_exact);
+        TEST_EQUAL(exact.size(), approx.size());
+        for (size_t i = 0; i < exact.size(); i++)
+            TEST_ALMOST(exact[i], approx[i], 1.0e-6);
+    }
+
+    // ------------------------------------------------------------------------
+    void compute_objfunc()
+    {
+        //
+        // The tree has eight nodes, so seven angles besides the root's. With
+        // a theta of zero, the Barnes-Hut quadtree computes the sum exactly,
+        // so the gradient must match central differences.
+        //
+        const node_type tree (
+            "((0:1,1:0.5):0.8,(2:0.7,3:1.2):0.6,4:0.9);");
+        svg_tree_type svg (tree);
+
+        const std::vector<value_type> params {
+            0.3, -1.1, 0.7, 2.0, -0.4, 1.3, -2.2 };
+
+        std::vector<value_type> gradient;
+        svg.compute_objfunc(params, gradient, 0.0);
+        TEST_EQUAL(params.size(), gradient.size());
+
+        static const auto h = 1.0e-6;
+        std::vector<value_type> unused;
+        for (size_t i = 0; i < params.size(); i++)
+        {
+            auto lo = params, hi = params;
+            lo[i] -= h;
+            hi[i] += h;
+
+            const auto f_lo = svg.compute_objfunc(lo, unused, 0.0);
+            const auto f_hi = svg.compute_objfunc(hi, unused, 0.0);
+            TEST_ALMOST((f_hi - f_lo) / (2 * h), gradient[i], 1.0e-5);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void optimize_positions()
+    {
+        //
+        // Create a caterpillar tree with enough nodes to divide the
+        // Barnes-Hut quadtree, and ensure every node is rendered at a finite
+        // position after the optimization.
+        //
+        const size_t n = 200;
+
+        std::ostringstream in;
+        in << std::string(n - 1, '(') << "0:1";
+        for (size_t i = 1; i < n; i++)
+            in << ',' << i << ":1):1";
+        in << ';';
+
+        const node_type tree (in.str());
+        svg_tree_type svg (tree);
+        svg.optimize_positions();
+
+        const auto str = svg.str();
+        TEST_TRUE(str.find("nan") == std::string::npos);
+        TEST_TRUE(str.find("inf") == std::string::npos);
+
+        size_t circles = 0;
+        for (auto i = str.find("<circle"); i != std::string::npos;
+                i = str.find("<circle", i + 1))
+            circles++;
+
+        TEST_EQUAL(2 * n - 1, circles);
+    }
 }
 
 namespace test
 {
     test_group svg_tree {
-        TEST_CASE(constructor)
+        TEST_CASE(coincident_nodes),
+        TEST_CASE(compute_objfunc),
+        TEST_CASE(constructor),
+        TEST_CASE(optimize_positions)
     };
 }
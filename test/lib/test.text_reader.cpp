@@ -0,0 +1,245 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.matrix.hpp"
+
+namespace
+{
+    typedef jade::text_reader               text_reader;
+    typedef jade::basic_matrix<double>      real_matrix;
+    typedef jade::basic_matrix<char>        char_matrix;
+
+    // ------------------------------------------------------------------------
+    template <typename TValue>
+    bool parse(const std::string & text, TValue & value)
+    {
+        std::istringstream in (text);
+        text_reader reader (in);
+        return reader.read(value);
+    }
+
+    // ------------------------------------------------------------------------
+    std::string error_message(const std::string & text)
+    {
+        try
+        {
+            std::istringstream in (text);
+            const real_matrix m (in);
+        }
+        catch (const std::exception & e)
+        {
+            return e.what();
+        }
+
+        return std::string();
+    }
+
+    // ------------------------------------------------------------------------
+    // A stream buffer that reads from a string but cannot seek, like a pipe.
+    //
+    class unseekable_buf : public std::streambuf
+    {
+    public:
+        explicit unseekable_buf(const std::string & text)
+            : _text (text)
+        {
+            setg(&_text[0], &_text[0], &_text[0] + _text.size());
+        }
+
+    private:
+        std::string _text;
+    };
+
+    // ------------------------------------------------------------------------
+    void characters()
+    {
+        std::istringstream in ("2 3\n0 1 2\n3\t2 1\n");
+        const char_matrix m (in);
+        TEST_EQUAL(std::string("012321"),
+            std::string(m.get_data(), m.get_length()));
+
+        char ch;
+        TEST_FALSE(parse(" \n", ch));
+    }
+
+    // ------------------------------------------------------------------------
+    void continuation()
+    {
+        std::istringstream in ("1 2 3 4\n1 1\n5\n end");
+        const real_matrix a (in);
+        const real_matrix b (in);
+        TEST_TRUE(a.is_size(1, 2));
+        TEST_TRUE(b.is_size(1, 1));
+        TEST_ALMOST(5.0, b[0], 0.0);
+
+        std::string word;
+        TEST_TRUE(static_cast<bool>(in >> word));
+        TEST_EQUAL(std::string("end"), word);
+    }
+
+    // ------------------------------------------------------------------------
+    void errors()
+    {
+        TEST_EQUAL(std::string("failed to parse matrix size"),
+            error_message("2"));
+        TEST_EQUAL(std::string("invalid matrix size [0x1]"),
+            error_message("0 1"));
+        TEST_EQUAL(std::string(
+            "failed to parse matrix value at cell [2,1]"),
+            error_message("2 2\n1 2\nx 4\n"));
+        TEST_EQUAL(std::string(
+            "failed to parse matrix value at cell [1,2]"),
+            error_message("2 2\n1 1e\n3 4\n"));
+        TEST_EQUAL(std::string(
+            "failed to parse matrix value at cell [2,2]"),
+            error_message("2 2\n1 2\n3"));
+    }
+
+    // ------------------------------------------------------------------------
+    void floats()
+    {
+        double d = 0.0;
+        TEST_TRUE(parse("  -1.5e-3", d));
+        TEST_ALMOST(-1.5e-3, d, 0.0);
+        TEST_TRUE(parse(".25", d));
+        TEST_ALMOST(0.25, d, 0.0);
+        TEST_TRUE(parse("7.", d));
+        TEST_ALMOST(7.0, d, 0.0);
+        TEST_TRUE(parse("+1E+2", d));
+        TEST_ALMOST(100.0, d, 0.0);
+        TEST_TRUE(parse("0.000", d));
+        TEST_ALMOST(0.0, d, 0.0);
+        TEST_FALSE(parse(".", d));
+        TEST_FALSE(parse("-", d));
+        TEST_FALSE(parse("1e400", d));
+        TEST_FALSE(parse("nan", d));
+
+        float f = 0.0f;
+        TEST_TRUE(parse("0.1", f));
+        TEST_ALMOST(0.1f, f, 0.0f);
+
+        //
+        // Compare values against the C library, including those with many
+        // digits that are converted by the C library.
+        //
+        std::mt19937_64 engine (3);
+        std::uniform_real_distribution<double> unit (0.0, 1.0);
+        std::uniform_int_distribution<int> precision (0, 19);
+        std::uniform_int_distribution<int> exponent (-40, 40);
+
+        size_t failures = 0;
+        for (size_t i = 0; i < 100000; i++)
+        {
+            char text[64];
+            std::snprintf(text, sizeof(text), "%.*e", precision(engine),
+                unit(engine) * std::pow(10.0, exponent(engine)));
+
+            double parsed;
+            if (!parse(text, parsed) ||
+                parsed < std::strtod(text, nullptr) ||
+                parsed > std::strtod(text, nullptr))
+                failures++;
+        }
+
+        TEST_EQUAL(size_t(0), failures);
+    }
+
+    // ------------------------------------------------------------------------
+    void integers()
+    {
+        int i = 0;
+        TEST_TRUE(parse("-2147483648", i));
+        TEST_EQUAL(std::numeric_limits<int>::min(), i);
+        TEST_TRUE(parse("+17", i));
+        TEST_EQUAL(17, i);
+        TEST_FALSE(parse("2147483648", i));
+
+        size_t n = 0;
+        TEST_TRUE(parse("18446744073709551615", n));
+        TEST_EQUAL(std::numeric_limits<size_t>::max(), n);
+        TEST_FALSE(parse("18446744073709551616", n));
+        TEST_FALSE(parse("-1", n));
+    }
+
+    // ------------------------------------------------------------------------
+    void parallel()
+    {
+        const auto thread_count = jade::parallel::get_thread_count();
+        jade::parallel::set_thread_count(4);
+
+        std::mt19937 engine (1);
+        std::uniform_real_distribution<double> dist (0.0, 1.0);
+        real_matrix m (257, 301);
+        for (size_t i = 0; i < m.get_length(); i++)
+            m[i] = dist(engine);
+
+        const auto text = m.str();
+
+        std::istringstream in (text);
+        const real_matrix m2 (in);
+        TEST_TRUE(m2.is_size(m));
+        TEST_EQUAL(text, m2.str());
+
+        //
+        // The rows do not need to be on separate lines.
+        //
+        auto flat = text;
+        std::replace(flat.begin() + 8, flat.end(), '\n', ' ');
+        std::istringstream flat_in (flat);
+        const real_matrix m3 (flat_in);
+        TEST_EQUAL(text, m3.str());
+
+        auto bad = text;
+        bad[bad.find('\t', bad.size() / 2) + 1] = 'x';
+        const auto message = error_message(bad);
+
+        jade::parallel::set_thread_count(1);
+        TEST_EQUAL(error_message(bad), message);
+        jade::parallel::set_thread_count(thread_count);
+
+        TEST_EQUAL(size_t(0), message.find("failed to parse matrix value"));
+    }
+
+    // ------------------------------------------------------------------------
+    void unseekable()
+    {
+        //
+        // Without seeking, the reader must not consume text beyond the
+        // values it parses.
+        //
+        unseekable_buf buf ("1 2 3 4\n1 1\n5\n end");
+        std::istream in (&buf);
+        const real_matrix a (in);
+        const real_matrix b (in);
+        TEST_TRUE(a.is_size(1, 2));
+        TEST_ALMOST(4.0, a[1], 0.0);
+        TEST_TRUE(b.is_size(1, 1));
+        TEST_ALMOST(5.0, b[0], 0.0);
+
+        std::string word;
+        TEST_TRUE(static_cast<bool>(in >> word));
+        TEST_EQUAL(std::string("end"), word);
+
+        unseekable_buf bad_buf ("2 2\n1 2\nx 4\n");
+        std::istream bad_in (&bad_buf);
+        real_matrix c;
+        TEST_THROWS(c.read(bad_in));
+    }
+}
+
+namespace test
+{
+    test_group text_reader {
+        TEST_CASE(characters),
+        TEST_CASE(continuation),
+        TEST_CASE(errors),
+        TEST_CASE(floats),
+        TEST_CASE(integers),
+        TEST_CASE(parallel),
+        TEST_CASE(unseekable)
+    };
+}
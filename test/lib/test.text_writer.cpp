@@ -0,0 +1,185 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.matrix.hpp"
+
+namespace
+{
+    typedef jade::text_writer               text_writer;
+    typedef jade::basic_matrix<double>      real_matrix;
+
+    // ------------------------------------------------------------------------
+    template <typename TValue>
+    std::string format(const TValue value)
+    {
+        char buf[text_writer::max_value_length];
+        const auto end = text_writer::format(buf, value);
+        return std::string(buf, end);
+    }
+
+    // ------------------------------------------------------------------------
+    template <typename TValue>
+    bool round_trips(const TValue value)
+    {
+        std::istringstream in (format(value));
+        TValue parsed;
+        if (!(in >> parsed))
+            return false;
+
+        return std::memcmp(&parsed, &value, sizeof(TValue)) == 0;
+    }
+
+    // ------------------------------------------------------------------------
+    // Returns true if the value is not written with more significant digits
+    // than the C library needs to read it back.
+    //
+    bool is_shortest(const double value)
+    {
+        const auto text = format(value);
+        const auto e    = text.find('e');
+        auto n = 0;
+        for (size_t i = 0; i < e; i++)
+            if (text[i] >= '0' && text[i] <= '9')
+                n++;
+
+        if (n <= 1)
+            return true;
+
+        char tmp[text_writer::max_value_length];
+        std::snprintf(tmp, sizeof(tmp), "%.*e", n - 2, value);
+        const auto parsed = std::strtod(tmp, nullptr);
+        return parsed < value || value < parsed;
+    }
+
+    // ------------------------------------------------------------------------
+    void integers()
+    {
+        TEST_EQUAL(std::string("0"), format(0));
+        TEST_EQUAL(std::string("-42"), format(-42));
+        TEST_EQUAL(std::string("18446744073709551615"),
+            format(std::numeric_limits<unsigned long long>::max()));
+        TEST_EQUAL(std::string("-9223372036854775808"),
+            format(std::numeric_limits<long long>::min()));
+        TEST_EQUAL(std::string("3"), format('3'));
+    }
+
+    // ------------------------------------------------------------------------
+    void table()
+    {
+        const real_matrix m {
+            { 0.1, 0.25, 1.0 / 3.0 },
+            { -2.0, 1.0e-300, 6.02214076e23 }
+        };
+
+        std::ostringstream out;
+        m.write_exact(out);
+        TEST_EQUAL(std::string(
+            "2 3\n"
+            "1e-01\t2.5e-01\t3.333333333333333e-01\n"
+            "-2e+00\t1e-300\t6.02214076e+23\n"), out.str());
+
+        std::istringstream in (out.str());
+        const real_matrix m2 (in);
+        TEST_TRUE(m2.is_size(m));
+        for (size_t i = 0; i < m.get_length(); i++)
+            TEST_TRUE(round_trips(m[i]) && !(m[i] < m2[i] || m2[i] < m[i]));
+    }
+
+    // ------------------------------------------------------------------------
+    void parallel()
+    {
+        const auto thread_count = jade::parallel::get_thread_count();
+        jade::parallel::set_thread_count(4);
+
+        std::mt19937 engine (1);
+        std::uniform_real_distribution<double> dist (0.0, 1.0);
+        real_matrix m (301, 257);
+        for (size_t i = 0; i < m.get_length(); i++)
+            m[i] = dist(engine);
+
+        std::ostringstream out;
+        m.write_exact(out);
+        jade::parallel::set_thread_count(1);
+        std::ostringstream expected;
+        m.write_exact(expected);
+        jade::parallel::set_thread_count(thread_count);
+
+        TEST_TRUE(out.str() == expected.str());
+
+        std::istringstream in (out.str());
+        const real_matrix m2 (in);
+        TEST_TRUE(m2.is_size(m));
+        auto same = true;
+        for (size_t i = 0; i < m.get_length(); i++)
+            same = same && !(m[i] < m2[i] || m2[i] < m[i]);
+        TEST_TRUE(same);
+    }
+
+    // ------------------------------------------------------------------------
+    void shortest()
+    {
+        TEST_EQUAL(std::string("3e-01"), format(0.3));
+        TEST_EQUAL(std::string("1e+00"), format(1.0));
+        TEST_EQUAL(std::string("1.5e+01"), format(15.0));
+        TEST_EQUAL(std::string("1e+22"), format(1.0e22));
+        TEST_EQUAL(std::string("-1.25e-05"), format(-1.25e-5));
+        TEST_EQUAL(std::string("5e-324"), format(5.0e-324));
+        TEST_EQUAL(std::string("1.7976931348623157e+308"),
+            format(std::numeric_limits<double>::max()));
+        TEST_EQUAL(std::string("5.577759602105813e-11"),
+            format(5.5777596021058127e-11));
+        TEST_EQUAL(std::string("3e-01"), format(0.3f));
+        TEST_EQUAL(std::string("0e+00"), format(0.0));
+        TEST_EQUAL(std::string("-0e+00"), format(-0.0));
+        TEST_EQUAL(std::string("inf"),
+            format(std::numeric_limits<double>::infinity()));
+        TEST_EQUAL(std::string("nan"),
+            format(std::numeric_limits<double>::quiet_NaN()));
+    }
+
+    // ------------------------------------------------------------------------
+    void round_trip()
+    {
+        std::mt19937_64 engine (7);
+        std::uniform_int_distribution<unsigned long long> bits;
+        std::uniform_real_distribution<double> unit (0.0, 1.0);
+
+        size_t failures = 0;
+        for (size_t i = 0; i < 200000; i++)
+        {
+            //
+            // Test arbitrary bit patterns as well as typical probabilities.
+            //
+            double d;
+            const auto b = bits(engine);
+            std::memcpy(&d, &b, sizeof(d));
+            if (!std::isfinite(d) || std::fabs(d) < 1.0e-300)
+                d = unit(engine);
+
+            const auto f = float(unit(engine));
+
+            if (!round_trips(d) || !round_trips(f) || !round_trips(d * 1e-5))
+                failures++;
+
+            if (!is_shortest(d) || !is_shortest(d * 1e-5))
+                failures++;
+        }
+
+        TEST_EQUAL(size_t(0), failures);
+    }
+}
+
+namespace test
+{
+    test_group text_writer {
+        TEST_CASE(integers),
+        TEST_CASE(parallel),
+        TEST_CASE(round_trip),
+        TEST_CASE(shortest),
+        TEST_CASE(table)
+    };
+}
@@ -0,0 +1,184 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.topology.hpp"
+
+namespace
+{
+    typedef double value_type;
+    typedef jade::basic_topology<value_type> topology_type;
+    typedef topology_type::container_type container_type;
+    typedef topology_type::matrix_type matrix_type;
+    typedef topology_type::node_type node_type;
+
+    // ------------------------------------------------------------------------
+    void compute_covariance()
+    {
+        const node_type node ("(0:1,(1:2,2:3):4,3:5);");
+        const topology_type tree (node);
+
+        matrix_type c (3, 3);
+        tree.compute_covariance(tree.get_lengths(), c);
+
+        const matrix_type expected {
+            { 7, 5, 1 },
+            { 5, 8, 1 },
+            { 1, 1, 6 }
+        };
+
+        TEST_EQUAL(expected.str(), c.str());
+    }
+
+    // ------------------------------------------------------------------------
+    void compute_gradient()
+    {
+        const node_type node ("(0:1,((1:2,4:1):1,2:3):4,3:5);");
+        const topology_type tree (node);
+
+        //
+        // Compare the gradient of sum(C .* W) to central differences.
+        //
+        const matrix_type w {
+            { 1, 2, 3, 4 },
+            { 2, 5, 6, 7 },
+            { 3, 6, 8, 9 },
+            { 4, 7, 9, 1 }
+        };
+
+        const auto f = [&](const container_type & lengths) -> value_type
+        {
+            matrix_type c (4, 4);
+            tree.compute_covariance(lengths, c);
+            auto sum = value_type(0);
+            for (size_t i = 0; i < c.get_length(); i++)
+                sum += c[i] * w[i];
+            return sum;
+        };
+
+        container_type gradient;
+        tree.compute_gradient(w, gradient);
+
+        const auto & lengths = tree.get_lengths();
+        TEST_EQUAL(lengths.size(), gradient.size());
+
+        for (size_t i = 0; i < lengths.size(); i++)
+        {
+            auto lhs = lengths, rhs = lengths;
+            lhs[i] -= 0.5;
+            rhs[i] += 0.5;
+            TEST_ALMOST(f(rhs) - f(lhs), gradient[i], 1.0e-9);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void constructor()
+    {
+        const node_type node ("(3:5,(1:2,2:3):4,0:1);");
+        const topology_type tree (node);
+
+        TEST_EQUAL(size_t(3), tree.get_rk());
+        TEST_EQUAL(size_t(5), tree.get_lengths().size());
+
+        //
+        // The key ignores the lengths and the order of the children.
+        //
+        const node_type other ("(0:9,3:8,(2:7,1:6):5);");
+        TEST_EQUAL(tree.get_key(), topology_type(other).get_key());
+
+        const node_type different ("(0:1,(1:2,3:3):4,2:5);");
+        TEST_TRUE(tree.get_key() != topology_type(different).get_key());
+
+        TEST_THROWS(topology_type(node_type("(0:1);")));
+    }
+
+    // ------------------------------------------------------------------------
+    void get_nni_neighbors()
+    {
+        const node_type node ("(0:1,((1:2,4:1):1,2:3):4,3:5);");
+        const topology_type tree (node);
+
+        //
+        // Each of the two internal edges produces two interchanges.
+        //
+        const auto neighbors = tree.get_nni_neighbors();
+        TEST_EQUAL(size_t(4), neighbors.size());
+
+        std::set<std::string> keys;
+        for (const auto & neighbor : neighbors)
+        {
+            TEST_EQUAL(size_t(4), neighbor.get_rk());
+            keys.insert(neighbor.get_key());
+        }
+
+        TEST_EQUAL(size_t(4), keys.size());
+        TEST_TRUE(keys.find(tree.get_key()) == keys.end());
+    }
+
+    // ------------------------------------------------------------------------
+    void get_spr_neighbors()
+    {
+        const node_type node ("(0:1,((1:2,4:1):1,2:3):4,3:5);");
+        const topology_type tree (node);
+
+        //
+        // Only subtrees without leaf "0" are moved, so 10 of the 14 other
+        // unrooted topologies of five leaves are one regraft away.
+        //
+        std::set<std::string> keys;
+        for (const auto & neighbor : tree.get_spr_neighbors())
+        {
+            TEST_EQUAL(size_t(4), neighbor.get_rk());
+            keys.insert(neighbor.get_key());
+        }
+
+        keys.erase(tree.get_key());
+        TEST_EQUAL(size_t(10), keys.size());
+
+        //
+        // The NNI neighbors are a subset of the SPR neighbors.
+        //
+        for (const auto & neighbor : tree.get_nni_neighbors())
+            TEST_TRUE(keys.find(neighbor.get_key()) != keys.end());
+    }
+
+    // ------------------------------------------------------------------------
+    void str()
+    {
+        const node_type node ("(0:1,(1:2,2:3):4,3:5);");
+        const topology_type tree (node);
+
+        const node_type copy (tree.str());
+        TEST_EQUAL(tree.get_key(), topology_type(copy).get_key());
+        TEST_EQUAL(tree.str(), topology_type(copy).str());
+
+        //
+        // Lengths are written exactly, regardless of the stream precision.
+        //
+        const node_type exact_node (
+            "(0:0.1,(1:1e-7,2:3):0.3333333333333333,3:5);");
+        std::ostringstream out;
+        out.precision(2);
+        topology_type(exact_node).write(out);
+        TEST_EQUAL(
+            std::string("(0:1e-01,(1:1e-07,2:3e+00):3.333333333333333e-01,"
+                        "3:5e+00);"),
+            out.str());
+        TEST_EQUAL(out.str(), topology_type(node_type(out.str())).str());
+    }
+}
+
+namespace test
+{
+    test_group topology {
+        TEST_CASE(compute_covariance),
+        TEST_CASE(compute_gradient),
+        TEST_CASE(constructor),
+        TEST_CASE(get_nni_neighbors),
+        TEST_CASE(get_spr_neighbors),
+        TEST_CASE(str)
+    };
+}
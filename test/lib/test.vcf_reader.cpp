@@ -0,0 +1,193 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.vcf_reader.hpp"
+
+namespace
+{
+    typedef double                                value_type;
+    typedef jade::basic_vcf_reader<value_type>    vcf_reader_type;
+    typedef vcf_reader_type::lgm_type             lgm_type;
+
+    const auto epsilon = value_type(1.0e-9);
+
+    const auto header =
+        "##fileformat=VCFv4.2\n"
+        "##FORMAT=<ID=GL,Number=G,Type=Float,Description=\"Likelihoods\">\n"
+        "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tA\tB\n";
+
+    // ------------------------------------------------------------------------
+    void read(const std::string & text)
+    {
+        std::istringstream in (text);
+        const vcf_reader_type reader (in);
+    }
+
+    // ------------------------------------------------------------------------
+    void gl()
+    {
+        std::istringstream in (std::string(header) +
+            "1\t10\tm1\tA\tC\t.\tPASS\t.\tGT:GL\t0/1:0,-1,-2\t1/1:-1,-1,0\n"
+            "1\t20\tm2\tA\tC,G\t.\tPASS\t.\tGT:GL\t0/1:0,-1,-2\t1/1:-1,-1,0\n"
+            "1\t30\tm3\tG\tT\t.\tPASS\t.\tGT:GL\t./.:.\t0/0:0,-2,-2\n");
+
+        const vcf_reader_type reader (in);
+        TEST_EQUAL(size_t(2), reader.get_marker_count());
+        TEST_EQUAL(size_t(1), reader.get_skipped_count());
+
+        const auto lgm = reader.create_lgm();
+        TEST_EQUAL(std::string("[2x2]"), lgm.get_size_str());
+
+        const auto & aa = lgm.get_minor_minor_matrix();
+        const auto & Aa = lgm.get_major_minor_matrix();
+        const auto & AA = lgm.get_major_major_matrix();
+
+        TEST_ALMOST(value_type(0.01 / 1.11), aa(0, 0), epsilon);
+        TEST_ALMOST(value_type(0.10 / 1.11), Aa(0, 0), epsilon);
+        TEST_ALMOST(value_type(1.00 / 1.11), AA(0, 0), epsilon);
+
+        TEST_ALMOST(value_type(1.00 / 1.20), aa(1, 0), epsilon);
+        TEST_ALMOST(value_type(0.10 / 1.20), Aa(1, 0), epsilon);
+        TEST_ALMOST(value_type(0.10 / 1.20), AA(1, 0), epsilon);
+
+        TEST_ALMOST(value_type(1.0 / 3.0), aa(0, 1), epsilon);
+        TEST_ALMOST(value_type(1.0 / 3.0), Aa(0, 1), epsilon);
+        TEST_ALMOST(value_type(1.0 / 3.0), AA(0, 1), epsilon);
+
+        TEST_ALMOST(value_type(0.01 / 1.02), aa(1, 1), epsilon);
+        TEST_ALMOST(value_type(0.01 / 1.02), Aa(1, 1), epsilon);
+        TEST_ALMOST(value_type(1.00 / 1.02), AA(1, 1), epsilon);
+
+        std::istringstream out (reader.str());
+        const lgm_type lgm2 (out);
+        TEST_ALMOST(aa(1, 0), lgm2.get_minor_minor_matrix()(1, 0), epsilon);
+        TEST_ALMOST(AA(1, 1), lgm2.get_major_major_matrix()(1, 1), epsilon);
+    }
+
+    // ------------------------------------------------------------------------
+    void invalid()
+    {
+        TEST_THROWS(read(
+            "1\t10\tm1\tA\tC\t.\tPASS\t.\tGT:GL\t0/1:0,-1,-2\n"));
+
+        TEST_THROWS(read(
+            std::string(header) +
+            "1\t10\tm1\tA\tC\t.\tPASS\t.\tGT:GL\t0/1:0,-1,-2\n"));
+
+        TEST_THROWS(read(
+            std::string(header) +
+            "1\t10\tm1\tA\tC\t.\tPASS\t.\tGT\t0/1\t1/1\n"));
+
+        TEST_THROWS(read(
+            std::string(header) +
+            "1\t10\tm1\tA\tC\t.\tPASS\t.\tGT:GL\t0/1:0,-1\t1/1:-1,-1,0\n"));
+
+        TEST_THROWS(read(
+            std::string(header) +
+            "1\t10\tm1\tA\tC\t.\tPASS\t.\tGT:GL\t0/1:0,x,-2\t1/1:-1,-1,0\n"));
+    }
+
+    // ------------------------------------------------------------------------
+    void missing()
+    {
+        //
+        // A missing value inside the list makes every genotype of the sample
+        // equally likely, like a missing field.
+        //
+        std::istringstream in (std::string(header) +
+            "1\t10\tm1\tA\tC\t.\tPASS\t.\tGT:GL\t0/1:0,.,-2\t1/1:-1,-1,0\n"
+            "1\t20\tm2\tA\tC\t.\tPASS\t.\tGT:PL\t0/1:.,.,.\t1/1:0,10,20\n");
+
+        const vcf_reader_type reader (in);
+        TEST_EQUAL(size_t(2), reader.get_marker_count());
+
+        const auto lgm = reader.create_lgm();
+        const auto & aa = lgm.get_minor_minor_matrix();
+        const auto & Aa = lgm.get_major_minor_matrix();
+        const auto & AA = lgm.get_major_major_matrix();
+
+        for (size_t j = 0; j < 2; j++)
+        {
+            TEST_ALMOST(value_type(1.0 / 3.0), aa(0, j), epsilon);
+            TEST_ALMOST(value_type(1.0 / 3.0), Aa(0, j), epsilon);
+            TEST_ALMOST(value_type(1.0 / 3.0), AA(0, j), epsilon);
+        }
+
+        TEST_ALMOST(value_type(1.00 / 1.20), aa(1, 0), epsilon);
+        TEST_ALMOST(value_type(1.00 / 1.11), AA(1, 1), epsilon);
+    }
+
+    // ------------------------------------------------------------------------
+    void pl()
+    {
+        std::istringstream in (std::string(header) +
+            "1\t10\tm1\tA\tC\t.\tPASS\t.\tGT:PL\t0/1:20,0,10\t1/1:0,10,20\n");
+
+        const vcf_reader_type reader (in);
+        const auto lgm = reader.create_lgm();
+
+        const auto & aa = lgm.get_minor_minor_matrix();
+        const auto & Aa = lgm.get_major_minor_matrix();
+        const auto & AA = lgm.get_major_major_matrix();
+
+        TEST_ALMOST(value_type(0.10 / 1.11), aa(0, 0), epsilon);
+        TEST_ALMOST(value_type(1.00 / 1.11), Aa(0, 0), epsilon);
+        TEST_ALMOST(value_type(0.01 / 1.11), AA(0, 0), epsilon);
+
+        TEST_ALMOST(value_type(0.01 / 1.11), aa(1, 0), epsilon);
+        TEST_ALMOST(value_type(0.10 / 1.11), Aa(1, 0), epsilon);
+        TEST_ALMOST(value_type(1.00 / 1.11), AA(1, 0), epsilon);
+    }
+
+    // ------------------------------------------------------------------------
+    void underflow()
+    {
+        //
+        // The likelihoods of these values underflow when they are taken as
+        // powers of ten directly, but the sites are still informative.
+        //
+        std::istringstream in (std::string(header) +
+            "1\t10\tm1\tA\tC\t.\tPASS\t.\tGT:PL\t0/1:3000,0,3000"
+                "\t1/1:0,3000,3010\n"
+            "1\t20\tm2\tA\tC\t.\tPASS\t.\tGT:GL\t0/1:-400,-401,-402"
+                "\t1/1:-500,-500,-400\n");
+
+        const vcf_reader_type reader (in);
+        const auto lgm = reader.create_lgm();
+
+        const auto & aa = lgm.get_minor_minor_matrix();
+        const auto & Aa = lgm.get_major_minor_matrix();
+        const auto & AA = lgm.get_major_major_matrix();
+
+        TEST_ALMOST(value_type(0), aa(0, 0), epsilon);
+        TEST_ALMOST(value_type(1), Aa(0, 0), epsilon);
+        TEST_ALMOST(value_type(0), AA(0, 0), epsilon);
+
+        TEST_ALMOST(value_type(0), aa(1, 0), epsilon);
+        TEST_ALMOST(value_type(0), Aa(1, 0), epsilon);
+        TEST_ALMOST(value_type(1), AA(1, 0), epsilon);
+
+        TEST_ALMOST(value_type(0.01 / 1.11), aa(0, 1), epsilon);
+        TEST_ALMOST(value_type(0.10 / 1.11), Aa(0, 1), epsilon);
+        TEST_ALMOST(value_type(1.00 / 1.11), AA(0, 1), epsilon);
+
+        TEST_ALMOST(value_type(1), aa(1, 1), epsilon);
+        TEST_ALMOST(value_type(0), Aa(1, 1), epsilon);
+        TEST_ALMOST(value_type(0), AA(1, 1), epsilon);
+    }
+}
+
+namespace test
+{
+    test_group vcf_reader {
+        TEST_CASE(gl),
+        TEST_CASE(invalid),
+        TEST_CASE(missing),
+        TEST_CASE(pl),
+        TEST_CASE(underflow)
+    };
+}
@@ -0,0 +1,214 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.controller_factory.hpp"
+
+namespace
+{
+    typedef double                                     value_type;
+    typedef jade::basic_controller<value_type>         controller_type;
+    typedef jade::basic_controller_factory<value_type> factory_type;
+    typedef jade::basic_settings<value_type>           settings_type;
+    typedef controller_type::container_type            container_type;
+    typedef jade::basic_newick_node<value_type>        node_type;
+    typedef jade::basic_rerooted_tree<value_type>      rerooted_tree_type;
+
+    const auto g_path = "tmp/test.controller.dgm";
+    const auto f_path = "tmp/test.controller.f";
+    const auto a_path = "tmp/test.controller.agi";
+    const auto t_path = "tmp/test.controller.tree";
+
+    const auto g_str = R"(
+        4 6
+        0 1 2 0 1 2
+        1 1 2 1 0 0
+        2 0 1 2 1 2
+        0 2 1 1 2 1
+        )";
+
+    const auto f_str = R"(
+        3 6
+        0.2  0.6  0.8  0.3  0.5  0.7
+        0.4  0.3  0.6  0.5  0.2  0.6
+        0.7  0.5  0.1  0.4  0.6  0.3
+        )";
+
+    const auto a_str = R"(
+        a b c d e f g
+        p
+        3
+        (1 - p) * (b + e + g + f + a) + p * (b + d + a)
+        p * a + (1 - p) * (g + f + a)
+        c + g + f + a
+        )";
+
+    const auto f5_str = R"(
+        5 6
+        0.2  0.6  0.8  0.3  0.5  0.7
+        0.4  0.3  0.6  0.5  0.2  0.6
+        0.7  0.5  0.1  0.4  0.6  0.3
+        0.3  0.8  0.5  0.6  0.4  0.2
+        0.6  0.2  0.4  0.7  0.3  0.5
+        )";
+
+    const auto t_str =
+        "((0:0.11,1:0.23)n1:0.37,((2:0.41,3:0.53)n2:0.67,4:0.79)n3:0.83);";
+
+    // ------------------------------------------------------------------------
+    // Creates the settings for the test matrices and the specified options.
+    //
+    settings_type * create_settings(
+            const std::vector<std::string> & options,
+            const char * const               f = f_str)
+    {
+        std::ofstream(g_path) << g_str;
+        std::ofstream(f_path) << f;
+        std::ofstream(a_path) << a_str;
+
+        std::vector<const char *> argv { "nemeco" };
+        for (const auto & option : options)
+            argv.push_back(option.c_str());
+        argv.push_back(g_path);
+        argv.push_back(f_path);
+
+        jade::args args (int(argv.size()), argv.data());
+        const auto settings = new settings_type(args);
+
+        remove(g_path);
+        remove(f_path);
+        remove(a_path);
+        return settings;
+    }
+
+    // ------------------------------------------------------------------------
+    // Verifies the gradient of the objective function of the limited-memory
+    // BFGS method matches central differences at the specified parameters.
+    //
+    void test_lbfgs_gradient(
+            controller_type &      ctrl,
+            const container_type & params)
+    {
+        static const auto h = value_type(1.0e-6);
+
+        container_type gradient;
+        const auto objval = ctrl.compute_lbfgs_objfunc(params, gradient);
+        TEST_TRUE(objval < std::numeric_limits<value_type>::max());
+        TEST_EQUAL(params.size(), gradient.size());
+
+        container_type unused;
+        for (size_t i = 0; i < params.size(); i++)
+        {
+            auto lo = params, hi = params;
+            lo[i] -= h;
+            hi[i] += h;
+
+            const auto f_lo = ctrl.compute_lbfgs_objfunc(lo, unused);
+            const auto f_hi = ctrl.compute_lbfgs_objfunc(hi, unused);
+            TEST_ALMOST((f_hi - f_lo) / (2 * h), gradient[i],
+                1.0e-5 * (1 + std::fabs(gradient[i])));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void agi_lbfgs()
+    {
+        const std::unique_ptr<settings_type> settings (create_settings({
+            "--ain", a_path }));
+        const std::unique_ptr<controller_type> ctrl (
+            factory_type::create(*settings));
+
+        //
+        // The parameters hold the logit of the proportion followed by the
+        // logarithms of the branch lengths; the matrix has an off-diagonal
+        // entry, so the gradient of both triangles must be chained.
+        //
+        test_lbfgs_gradient(*ctrl, ctrl->init_lbfgs_parameters());
+        test_lbfgs_gradient(*ctrl, {
+            0.8, -0.3, 0.2, -1.1, 0.5, -0.7, 0.1, -0.4 });
+    }
+    // ------------------------------------------------------------------------
+    // Copies the lengths from the container into the children of the node,
+    // in the order of the parameters of the tree controller.
+    //
+    void copy_lengths(
+            node_type &                      parent,
+            container_type::const_iterator & iterator)
+    {
+        for (const auto child : parent.get_children())
+        {
+            child->set_length(*iterator++);
+            copy_lengths(*child, iterator);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void tree_decode()
+    {
+        std::ofstream(t_path) << t_str;
+        const std::unique_ptr<settings_type> settings (create_settings({
+            "--tin", t_path }, f5_str));
+        const std::unique_ptr<controller_type> ctrl (
+            factory_type::create(*settings));
+        remove(t_path);
+
+        //
+        // Scale the lengths so each one is distinct from those in the file,
+        // and decode the matrix through the incidence matrix.
+        //
+        auto params = ctrl->init_parameters();
+        for (size_t i = 0; i < params.size(); i++)
+            params[i] *= value_type(i + 2);
+
+        const auto c = ctrl->create_c(params);
+        TEST_TRUE(c.is_size(4, 4));
+
+        //
+        // Each cell must be the sum of the lengths along the overlapping
+        // paths of the rerooted tree.
+        //
+        const node_type    tree     (t_str);
+        rerooted_tree_type rerooted (tree);
+        auto iterator = container_type::const_iterator(params.begin());
+        copy_lengths(rerooted.get_tree(), iterator);
+        TEST_TRUE(params.end() == iterator);
+
+        for (size_t row = 0; row < 4; row++)
+        {
+            for (size_t col = 0; col <= row; col++)
+            {
+                const auto expected =
+                    rerooted.get_overlap(row, col).get_length();
+                TEST_ALMOST(expected, c(row, col), 1.0e-12);
+                TEST_ALMOST(expected, c(col, row), 1.0e-12);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void treeless_lbfgs()
+    {
+        const std::unique_ptr<settings_type> settings (create_settings({ }));
+        const std::unique_ptr<controller_type> ctrl (
+            factory_type::create(*settings));
+
+        //
+        // The parameters hold the lower Cholesky factor column by column,
+        // with the logarithms of the diagonal values.
+        //
+        test_lbfgs_gradient(*ctrl, ctrl->init_lbfgs_parameters());
+        test_lbfgs_gradient(*ctrl, { -0.4, 0.3, 0.2 });
+    }
+}
+
+namespace test
+{
+    test_group controller {
+        TEST_CASE(agi_lbfgs),
+        TEST_CASE(tree_decode),
+        TEST_CASE(treeless_lbfgs)
+    };
+}
@@ -10,6 +10,8 @@
 int main(const int argc, const char * argv[])
 {
     return test::execute(argc, argv, {
-        test::nemeco
+        test::controller,
+        test::nemeco,
+        test::resampler
     });
 }
@@ -11,7 +11,9 @@
 
 namespace test
 {
+    extern test_group controller;
     extern test_group nemeco;
+    extern test_group resampler;
 }
 
 #endif // TEST_MAIN_HPP__
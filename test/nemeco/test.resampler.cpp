@@ -0,0 +1,140 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.resampler.hpp"
+
+namespace
+{
+    typedef double                             value_type;
+    typedef jade::basic_resampler<value_type>  resampler_type;
+    typedef jade::basic_settings<value_type>   settings_type;
+    typedef jade::basic_likelihood<value_type> likelihood_type;
+    typedef jade::basic_matrix<value_type>     matrix_type;
+
+    const auto g_path = "tmp/test.resampler.dgm";
+    const auto f_path = "tmp/test.resampler.f";
+
+    const auto g_str = R"(
+        4 6
+        0 1 2 0 1 2
+        1 1 2 1 0 0
+        2 0 1 2 1 2
+        0 2 1 1 2 1
+        )";
+
+    const auto f_str = R"(
+        2 6
+        0.2  0.6  0.8  0.3  0.5  0.7
+        0.4  0.3  0.6  0.5  0.2  0.6
+        )";
+
+    // ------------------------------------------------------------------------
+    // Creates the settings for the test matrices and the specified options.
+    //
+    settings_type * create_settings(const std::vector<std::string> & options)
+    {
+        std::ofstream(g_path) << g_str;
+        std::ofstream(f_path) << f_str;
+
+        std::vector<const char *> argv { "nemeco" };
+        for (const auto & option : options)
+            argv.push_back(option.c_str());
+        argv.push_back(g_path);
+        argv.push_back(f_path);
+
+        jade::args args (int(argv.size()), argv.data());
+        const auto settings = new settings_type(args);
+
+        remove(g_path);
+        remove(f_path);
+        return settings;
+    }
+
+    // ------------------------------------------------------------------------
+    // Creates 1x2 matrices holding the specified values and their doubles.
+    //
+    std::vector<matrix_type> create_replicates(
+            const std::vector<value_type> & values)
+    {
+        std::vector<matrix_type> replicates;
+        for (const auto value : values)
+            replicates.push_back(matrix_type { { value, 2.0 * value } });
+        return replicates;
+    }
+
+    // ------------------------------------------------------------------------
+    void bootstrap()
+    {
+        const std::unique_ptr<settings_type> settings (create_settings({
+            "--resample", "bootstrap", "--blocks", "3", "--replicates", "4",
+            "--seed", "1" }));
+
+        const resampler_type resampler (*settings);
+        TEST_EQUAL(size_t(3), resampler.get_block_count());
+        TEST_EQUAL(size_t(4), resampler.get_replicate_count());
+
+        //
+        // The values 1, 2, 4, and 5 have a mean of 3 and squared deviations
+        // that sum to 10, so the sample variance is 10 / 3.
+        //
+        const auto se = resampler.compute_standard_errors(
+            create_replicates({ 1.0, 2.0, 4.0, 5.0 }));
+
+        TEST_TRUE(se.is_size(1, 2));
+        TEST_ALMOST(std::sqrt(10.0 / 3.0), se[0], 1.0e-12);
+        TEST_ALMOST(std::sqrt(40.0 / 3.0), se[1], 1.0e-12);
+    }
+
+    // ------------------------------------------------------------------------
+    void jackknife()
+    {
+        const std::unique_ptr<settings_type> settings (create_settings({
+            "--resample", "jackknife", "--blocks", "3" }));
+
+        const resampler_type resampler (*settings);
+        TEST_EQUAL(size_t(3), resampler.get_block_count());
+        TEST_EQUAL(size_t(3), resampler.get_replicate_count());
+
+        //
+        // The values 1, 2, and 4 have a mean of 7 / 3 and squared deviations
+        // that sum to 42 / 9, so the jackknife variance is 2 / 3 of the sum.
+        //
+        const auto se = resampler.compute_standard_errors(
+            create_replicates({ 1.0, 2.0, 4.0 }));
+
+        TEST_TRUE(se.is_size(1, 2));
+        TEST_ALMOST(std::sqrt(28.0 / 9.0), se[0], 1.0e-12);
+        TEST_ALMOST(std::sqrt(112.0 / 9.0), se[1], 1.0e-12);
+
+        //
+        // The second replicate omits the second block of two markers.
+        //
+        const auto & rf = settings->get_rf();
+        const auto & mu = settings->get_mu();
+
+        likelihood_type expected (rf.get_height());
+        expected.add(likelihood_type(rf, mu, 0, 2), 1);
+        expected.add(likelihood_type(rf, mu, 4, 6), 1);
+
+        const auto actual = resampler.create_likelihood(1);
+        TEST_EQUAL(size_t(4), actual.get_j());
+
+        matrix_type c_inv { { 2.0 } };
+        TEST_ALMOST(
+            expected(c_inv, std::log(0.5)),
+            actual(c_inv, std::log(0.5)),
+            1.0e-12);
+    }
+}
+
+namespace test
+{
+    test_group resampler {
+        TEST_CASE(bootstrap),
+        TEST_CASE(jackknife)
+    };
+}
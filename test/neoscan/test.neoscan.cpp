@@ -14,6 +14,7 @@ namespace
     typedef jade::basic_matrix<value_type>                   matrix_type;
     typedef jade::basic_discrete_genotype_matrix<value_type> dgm_type;
     typedef jade::basic_discrete_genotype_matrix<value_type> lgm_type;
+    typedef jade::basic_genotype_matrix<value_type>          gm_type;
 
     typedef neoscan_type::output    output_type;
     typedef std::queue<output_type> queue_type;
@@ -77,13 +78,186 @@ namespace
     const auto expected_lgm = []()
     {
         queue_type out;
-        out.push({ -1.999980e-01, -3.969019e-01, -1.667654e-01 });
-        out.push({ +6.999980e-01, -8.615658e-01, -5.063768e-02 });
-        out.push({ -1.599993e-01, -3.054189e+00, -3.028255e+00 });
-        out.push({ -7.999980e-01, -3.028255e+00, -9.560749e-01 });
+        out.push({ -1.999992e-01, -3.969019e-01, -1.667644e-01 });
+        out.push({ +6.999992e-01, -8.615658e-01, -5.063707e-02 });
+        out.push({ -1.600000e-01, -3.054189e+00, -3.028255e+00 });
+        out.push({ -7.999992e-01, -3.028255e+00, -9.560730e-01 });
         return out;
     }();
 
+    // ------------------------------------------------------------------------
+    // Computes the log likelihood of a column of the discrete genotypes
+    // directly from its definition, clamping every frequency.
+    //
+    value_type compute_reference_lle(
+            const matrix_type & g,
+            const matrix_type & q,
+            const matrix_type & f,
+            const matrix_type & y,
+            const size_t        j,
+            const value_type    d)
+    {
+        const auto lo = value_type(1.0e-6);
+        const auto hi = value_type(1.0) - lo;
+
+        auto lle = value_type(0);
+        for (size_t i = 0; i < q.get_height(); i++)
+        {
+            auto a = value_type(0);
+            auto b = value_type(0);
+            for (size_t k = 0; k < q.get_width(); k++)
+            {
+                const auto x    = f(k, j) + d * y[i];
+                const auto f_ij = std::min(std::max(lo, x), hi);
+                a += q(i, k) * f_ij;
+                b += q(i, k) * (value_type(1) - f_ij);
+            }
+
+            lle += g(i, j) * std::log(a) + (2 - g(i, j)) * std::log(b);
+        }
+
+        return lle;
+    }
+
+    // ------------------------------------------------------------------------
+    void test_derivatives()
+    {
+        std::istringstream q_in (q_str);
+        std::istringstream f_in (f_str);
+        std::istringstream y_in (y_str);
+
+        const matrix_type q (q_in);
+        const matrix_type f (f_in);
+        const matrix_type y (y_in);
+
+        //
+        // Compare the analytic derivatives with central differences for the
+        // discrete and likelihood genotypes at deltas where some, all, or
+        // none of the frequencies are clamped, away from the kinks.
+        //
+        const auto check = [&](const gm_type & g)
+        {
+            const neoscan_type neoscan (g, q, f, y);
+            const auto h = value_type(1.0e-5);
+
+            for (size_t j = 0; j < f.get_width(); j++)
+            {
+                for (const auto d : { -0.47, -0.13, 0.01, 0.08, 0.33, 0.61 })
+                {
+                    value_type d1, d2, lo1, lo2, hi1, hi2;
+                    neoscan.compute_lle(j, d, d1, d2);
+                    const auto lo = neoscan.compute_lle(j, d - h, lo1, lo2);
+                    const auto hi = neoscan.compute_lle(j, d + h, hi1, hi2);
+
+                    const auto fd1 = (hi - lo) / (2 * h);
+                    const auto fd2 = (hi1 - lo1) / (2 * h);
+                    TEST_ALMOST(fd1, d1, 1.0e-5 * (1 + std::fabs(d1)));
+                    TEST_ALMOST(fd2, d2, 1.0e-4 * (1 + std::fabs(d2)));
+                }
+            }
+        };
+
+        std::istringstream dgm_in (dgm_str);
+        std::istringstream lgm_in (lgm_str);
+        check(dgm_type(dgm_in));
+        check(jade::basic_likelihood_genotype_matrix<value_type>(lgm_in));
+    }
+
+    // ------------------------------------------------------------------------
+    void test_parallel()
+    {
+        //
+        // Scan enough random columns for several waves of blocks, and verify
+        // the outputs are the same and in the same order for any number of
+        // threads.
+        //
+        const size_t I = 12, K = 3, J = 2500;
+
+        std::mt19937 engine (11);
+        std::uniform_real_distribution<value_type> unit (0.0, 1.0);
+        std::uniform_int_distribution<int> code (0, 3);
+
+        std::ostringstream g_out;
+        g_out << I << ' ' << J << '\n';
+        for (size_t i = 0; i < I; i++)
+            for (size_t j = 0; j < J; j++)
+                g_out << code(engine) << (j + 1 < J ? ' ' : '\n');
+
+        matrix_type q (I, K), f (K, J), y (I, 1);
+        for (size_t i = 0; i < I; i++)
+        {
+            auto sum = value_type(0);
+            for (size_t k = 0; k < K; k++)
+                sum += q(i, k) = unit(engine);
+            for (size_t k = 0; k < K; k++)
+                q(i, k) /= sum;
+            y[i] = value_type(1000) * unit(engine);
+        }
+
+        for (size_t i = 0; i < f.get_length(); i++)
+            f[i] = unit(engine);
+
+        std::istringstream g_in (g_out.str());
+        const dgm_type     g    (g_in);
+
+        const auto scan = [&](const size_t thread_count)
+        {
+            jade::parallel::set_thread_count(thread_count);
+            std::vector<output_type> outputs;
+            const neoscan_type neoscan (g, q, f, y);
+            neoscan.execute([&outputs](const output_type & out)
+            {
+                outputs.push_back(out);
+            });
+            return outputs;
+        };
+
+        const auto thread_count = jade::parallel::get_thread_count();
+        const auto serial       = scan(1);
+        const auto parallel     = scan(4);
+        jade::parallel::set_thread_count(thread_count);
+
+        TEST_EQUAL(J, serial.size());
+        TEST_EQUAL(J, parallel.size());
+        for (size_t j = 0; j < J; j++)
+            TEST_EQUAL(serial[j].to_string(), parallel[j].to_string());
+    }
+
+    // ------------------------------------------------------------------------
+    void test_terms()
+    {
+        std::istringstream g_in (dgm_str);
+        std::istringstream q_in (q_str);
+        std::istringstream f_in (f_str);
+        std::istringstream y_in (y_str);
+        std::istringstream r_in (dgm_str);
+
+        const dgm_type    g (g_in);
+        const matrix_type q (q_in);
+        const matrix_type f (f_in);
+        const matrix_type y (y_in);
+        const matrix_type r (r_in);
+
+        //
+        // The years 0, 1, and 2 are scaled to 0.5, 0, and -0.5; small deltas
+        // use the precomputed products of Q and F, and large deltas clamp
+        // some of the frequencies, but both must match the definition.
+        //
+        const matrix_type scaled { { 0.5 }, { 0.0 }, { -0.5 } };
+
+        const neoscan_type neoscan (g, q, f, y);
+        for (size_t j = 0; j < f.get_width(); j++)
+        {
+            for (const auto d : { -0.9, -0.35, -0.05, 0.0, 0.07, 0.4, 0.95 })
+            {
+                value_type d1, d2;
+                TEST_ALMOST(compute_reference_lle(r, q, f, scaled, j, d),
+                    neoscan.compute_lle(j, d, d1, d2), 1.0e-12);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
     void test_dgm()
     {
         std::istringstream g_in (dgm_str);
@@ -150,7 +324,10 @@ namespace
 namespace test
 {
     test_group neoscan {
+        TEST_CASE(test_derivatives),
         TEST_CASE(test_dgm),
-        TEST_CASE(test_lgm)
+        TEST_CASE(test_lgm),
+        TEST_CASE(test_parallel),
+        TEST_CASE(test_terms)
     };
 }
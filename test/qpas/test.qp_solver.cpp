@@ -0,0 +1,199 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.discrete_genotype_matrix.hpp"
+#include "jade.qp_solver_factory.hpp"
+
+namespace
+{
+    typedef double                                           value_type;
+    typedef jade::basic_matrix<value_type>                   matrix_type;
+    typedef jade::basic_qp_solver<value_type>                qp_solver_type;
+    typedef jade::basic_qp_solver_factory<value_type>        factory_type;
+    typedef qp_solver_type::subproblem                       subproblem_type;
+    typedef jade::basic_discrete_genotype_matrix<value_type> dgm_type;
+
+    static const auto epsilon = value_type(0.000001);
+
+    // ------------------------------------------------------------------------
+    // Solves the subproblem with every solver and verifies the change is the
+    // expected one.
+    //
+    void test_solvers(
+            const subproblem_type & problem,
+            const matrix_type &     expected)
+    {
+        const auto K = expected.get_height();
+
+        for (const auto & name : factory_type::get_names())
+        {
+            std::unique_ptr<qp_solver_type> solver (
+                factory_type::create(name));
+
+            matrix_type actual (K, 1);
+            solver->solve(problem, actual);
+
+            for (size_t k = 0; k < K; k++)
+                TEST_ALMOST(expected[k], actual[k], epsilon);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void box()
+    {
+        //
+        // Maximize d' * delta - delta' * delta; the unconstrained solution,
+        // d / 2, is clipped to the bounds.
+        //
+        subproblem_type problem (3, false);
+        problem.derivative_vec = matrix_type { { 1.4 }, { -3.0 }, { 0.2 } };
+        problem.hessian_mat    = matrix_type {
+            { -2.0,  0.0,  0.0 },
+            {  0.0, -2.0,  0.0 },
+            {  0.0,  0.0, -2.0 } };
+        problem.lower_vec      = matrix_type { { -0.5 }, { -0.5 }, { -0.5 } };
+        problem.upper_vec      = matrix_type { {  0.5 }, {  0.5 }, {  0.5 } };
+
+        test_solvers(problem, matrix_type { { 0.5 }, { -0.5 }, { 0.1 } });
+    }
+
+    // ------------------------------------------------------------------------
+    void create()
+    {
+        TEST_THROWS(factory_type::create("simplex"));
+
+        for (const auto & name : factory_type::get_names())
+        {
+            std::unique_ptr<qp_solver_type> solver (
+                factory_type::create(name));
+            TEST_TRUE(nullptr != solver.get());
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    void dense()
+    {
+        //
+        // Take the subproblems of a Q step and an F step from real matrices;
+        // their Hessians are dense, and the solutions are inside the bounds
+        // for the Q row and on a bound for the F column.
+        //
+        const auto AA = jade::genotype_major_major;
+        const auto Aa = jade::genotype_major_minor;
+        const auto aa = jade::genotype_minor_minor;
+
+        const dgm_type g {
+            { AA, AA, Aa, Aa, aa },
+            { AA, aa, Aa, AA, AA },
+            { Aa, Aa, aa, AA, Aa },
+            { AA, AA, aa, Aa, AA }
+        };
+
+        const matrix_type q {
+            { 0.2, 0.3, 0.5 },
+            { 0.3, 0.4, 0.3 },
+            { 0.9, 0.1, 0.0 },
+            { 0.3, 0.1, 0.6 }
+        };
+
+        const matrix_type fa {
+            { 0.7, 0.8, 0.6, 0.9, 0.8 },
+            { 0.2, 0.1, 0.3, 0.4, 0.2 },
+            { 0.2, 0.4, 0.2, 0.1, 0.5 }
+        };
+
+        matrix_type fb (3, 5);
+        fb.set_values(1);
+        fb -= fa;
+
+        const auto qfa = q * fa;
+        const auto qfb = q * fb;
+
+        subproblem_type q_problem (3, true);
+        g.compute_derivatives_q(q, fa, fb, qfa, qfb, 2,
+            q_problem.derivative_vec, q_problem.hessian_mat);
+        for (size_t k = 0; k < 3; k++)
+        {
+            q_problem.lower_vec[k] = -q(2, k);
+            q_problem.upper_vec[k] = value_type(1) - q(2, k);
+        }
+
+        test_solvers(q_problem, matrix_type {
+            { -0.232163033260626 },
+            {  0.185002034201347 },
+            {  0.047160999059279 } });
+
+        subproblem_type f_problem (3, false);
+        g.compute_derivatives_f(q, fa, fb, qfa, qfb, 3,
+            f_problem.derivative_vec, f_problem.hessian_mat);
+        for (size_t k = 0; k < 3; k++)
+        {
+            f_problem.lower_vec[k] = -fa(k, 3);
+            f_problem.upper_vec[k] = value_type(1) - fa(k, 3);
+        }
+
+        test_solvers(f_problem, matrix_type {
+            { -0.129252921072921 },
+            { -0.4 },
+            {  0.273886208125200 } });
+    }
+
+    // ------------------------------------------------------------------------
+    void fixed()
+    {
+        //
+        // The first component is fixed by its bounds, so the remaining
+        // components take up the change of the sum.
+        //
+        subproblem_type problem (3, true);
+        problem.derivative_vec = matrix_type { { 4.0 }, { 1.4 }, { -1.4 } };
+        problem.hessian_mat    = matrix_type {
+            { -2.0,  0.0,  0.0 },
+            {  0.0, -2.0,  0.0 },
+            {  0.0,  0.0, -2.0 } };
+        problem.lower_vec      = matrix_type { { 0.0 }, { -0.5 }, { -0.5 } };
+        problem.upper_vec      = matrix_type { { 0.0 }, {  0.5 }, {  0.5 } };
+
+        test_solvers(problem, matrix_type { { 0.0 }, { 0.5 }, { -0.5 } });
+    }
+
+    // ------------------------------------------------------------------------
+    void sum()
+    {
+        //
+        // Maximize d' * delta + delta' * H * delta / 2 subject to the bounds
+        // and sum(delta) = 0; the sum constraint and the second bound are
+        // active, and the Lagrange conditions give the remaining values.
+        //
+        subproblem_type problem (3, true);
+        problem.derivative_vec = matrix_type { { 1.0 }, { 2.0 }, { -1.0 } };
+        problem.hessian_mat    = matrix_type {
+            { -4.0, -1.0,  0.0 },
+            { -1.0, -4.0, -1.0 },
+            {  0.0, -1.0, -4.0 } };
+        problem.lower_vec      = matrix_type { { -0.4 }, { -0.4 }, { -0.4 } };
+        problem.upper_vec      = matrix_type { {  0.3 }, {  0.2 }, {  0.3 } };
+
+        //
+        // With delta_2 = 0.2 and delta_3 = -0.2 - delta_1, stationarity of
+        // the remaining free direction (1, 0, -1) requires
+        // 1 - 4 d1 - 0.2 - (-1 - 0.2 + 4 (0.2 + d1)) = 0, so d1 = 0.15.
+        //
+        test_solvers(problem, matrix_type { { 0.15 }, { 0.2 }, { -0.35 } });
+    }
+}
+
+namespace test
+{
+    test_group qp_solver {
+        TEST_CASE(box),
+        TEST_CASE(create),
+        TEST_CASE(dense),
+        TEST_CASE(fixed),
+        TEST_CASE(sum)
+    };
+}
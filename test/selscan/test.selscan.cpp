@@ -0,0 +1,279 @@
+/* -------------------------------------------------------------------------
+   Ohana
+   Copyright (c) 2015-2020 Jade Cheng                            (\___/)
+   Jade Cheng <info@jade-cheng.com>                              (='.'=)
+   ------------------------------------------------------------------------- */
+
+#include "test.main.hpp"
+#include "jade.selscan.hpp"
+
+namespace
+{
+    typedef double                           value_type;
+    typedef jade::basic_selscan<value_type>  selscan_type;
+    typedef std::vector<std::string>         row_type;
+    typedef std::vector<row_type>            table_type;
+
+    const auto g_path = "tmp/test.selscan.dgm";
+    const auto f_path = "tmp/test.selscan.f";
+    const auto c_path = "tmp/test.selscan.c";
+
+    const auto g_str = R"(
+        6 8
+        0 1 2 0 1 2 0 1
+        0 1 2 1 1 0 2 1
+        1 1 2 2 0 0 0 1
+        1 0 0 2 0 2 2 3
+        2 0 0 2 1 0 1 1
+        2 0 1 2 1 2 0 1
+        )";
+
+    const auto f_str = R"(
+        2 8
+        0.1  0.6  0.9  0.2  0.5  0.5  0.3  0.4
+        0.8  0.3  0.2  0.9  0.5  0.4  0.4  0.5
+        )";
+
+    const auto c_str = R"(
+        1 1
+        0.05
+        )";
+
+    // ------------------------------------------------------------------------
+    // Runs the program with the test matrices and the specified options, and
+    // returns the standard output.
+    //
+    std::string run(const std::vector<std::string> & options)
+    {
+        std::ofstream(g_path) << g_str;
+        std::ofstream(f_path) << f_str;
+        std::ofstream(c_path) << c_str;
+
+        std::vector<const char *> argv { "selscan" };
+        for (const auto & option : options)
+            argv.push_back(option.c_str());
+        argv.push_back(g_path);
+        argv.push_back(f_path);
+        argv.push_back(c_path);
+
+        std::ostringstream out;
+        const auto buf = std::cout.rdbuf(out.rdbuf());
+
+        try
+        {
+            jade::args args (int(argv.size()), argv.data());
+            selscan_type selscan (args);
+            selscan.execute();
+        }
+        catch (...)
+        {
+            std::cout.rdbuf(buf);
+            throw;
+        }
+
+        std::cout.rdbuf(buf);
+        remove(g_path);
+        remove(f_path);
+        remove(c_path);
+        return out.str();
+    }
+
+    // ------------------------------------------------------------------------
+    // Splits the text output into rows of tab-delimited fields.
+    //
+    table_type split(const std::string & text)
+    {
+        table_type table;
+        std::istringstream in (text);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            row_type row;
+            std::istringstream line_in (line);
+            std::string field;
+            while (std::getline(line_in, field, '\t'))
+                row.push_back(field);
+            table.push_back(row);
+        }
+
+        return table;
+    }
+
+    // ------------------------------------------------------------------------
+    std::string join(
+            row_type::const_iterator first,
+            row_type::const_iterator last)
+    {
+        std::string out;
+        for (auto iter = first; iter != last; ++iter)
+            out += (out.empty() ? "" : "\t") + *iter;
+        return out;
+    }
+
+    // ------------------------------------------------------------------------
+    // Returns the index of the named column in the header row.
+    //
+    size_t find_column(const table_type & table, const std::string & name)
+    {
+        const auto & header = table.front();
+        return size_t(std::find(header.begin(), header.end(), name)
+            - header.begin());
+    }
+
+    // ------------------------------------------------------------------------
+    template <typename TItem>
+    TItem read_binary(const std::string & text, size_t & pos)
+    {
+        TItem item;
+        std::memcpy(&item, text.data() + pos, sizeof(TItem));
+        pos += sizeof(TItem);
+        return item;
+    }
+
+    // ------------------------------------------------------------------------
+    void binary()
+    {
+        const auto table = split(run({ "--top", "3", "--fdr" }));
+        const auto text  = run({ "--top", "3", "--fdr", "--binary" });
+
+        size_t pos = 8;
+        TEST_EQUAL(std::string("OHANASEL"), text.substr(0, pos));
+        TEST_EQUAL(std::uint32_t(1), read_binary<std::uint32_t>(text, pos));
+
+        const auto columns = read_binary<std::uint32_t>(text, pos);
+        TEST_EQUAL(table.front().size(), size_t(columns));
+
+        for (size_t c = 0; c < columns; c++)
+        {
+            const auto length = read_binary<std::uint32_t>(text, pos);
+            TEST_EQUAL(table.front()[c], text.substr(pos, length));
+            pos += length;
+        }
+
+        //
+        // The text values have enough digits to read back exactly, so the
+        // binary values must be identical to them.
+        //
+        const auto rows = read_binary<std::uint64_t>(text, pos);
+        TEST_EQUAL(std::uint64_t(3), rows);
+
+        for (size_t c = 0; c < columns; c++)
+            for (size_t r = 0; r < rows; r++)
+                TEST_ALMOST(std::strtod(table[r + 1][c].c_str(), nullptr),
+                    read_binary<double>(text, pos), 0.0);
+
+        TEST_EQUAL(std::uint64_t(0), read_binary<std::uint64_t>(text, pos));
+        TEST_EQUAL(text.size(), pos);
+    }
+
+    // ------------------------------------------------------------------------
+    void fdr()
+    {
+        const auto table = split(run({ "--fdr" }));
+        TEST_EQUAL(size_t(9), table.size());
+
+        const auto p_column = find_column(table, "p-value");
+        const auto q_column = find_column(table, "q-value");
+        TEST_EQUAL(p_column + 1, q_column);
+
+        std::vector<value_type> p_values;
+        for (size_t r = 1; r < table.size(); r++)
+            p_values.push_back(std::strtod(
+                table[r][p_column].c_str(), nullptr));
+
+        const auto q_values = selscan_type::compute_q_values(p_values);
+        for (size_t r = 1; r < table.size(); r++)
+            TEST_ALMOST(q_values[r - 1], std::strtod(
+                table[r][q_column].c_str(), nullptr), 1.0e-15);
+    }
+
+    // ------------------------------------------------------------------------
+    void p_values()
+    {
+        //
+        // The ratios are the 0.95, 0.975, and 0.995 quantiles of the
+        // chi-square distribution with one degree of freedom, so the
+        // p-values of the mixture are half of the upper tails.
+        //
+        const auto epsilon = value_type(1.0e-12);
+        TEST_ALMOST(0.025, selscan_type::compute_p_value(3.841458820694124),
+            epsilon);
+        TEST_ALMOST(0.0125, selscan_type::compute_p_value(5.023886187314888),
+            epsilon);
+        TEST_ALMOST(0.0025, selscan_type::compute_p_value(7.879438576622419),
+            epsilon);
+        TEST_ALMOST(1.0, selscan_type::compute_p_value(0.0), 0.0);
+        TEST_ALMOST(1.0, selscan_type::compute_p_value(-1.0e-9), 0.0);
+        TEST_TRUE(std::isnan(selscan_type::compute_p_value(
+            std::numeric_limits<value_type>::quiet_NaN())));
+    }
+
+    // ------------------------------------------------------------------------
+    void q_values()
+    {
+        //
+        // In ascending order, the p-values 0.005, 0.02, 0.02, 0.04, and 0.3
+        // give the ratios p * 5 / rank of 0.025, 0.05, 0.1 / 3, 0.05, and
+        // 0.3; each q-value is the minimum ratio at its rank or above, so the
+        // tied p-values share the q-value of the higher rank.
+        //
+        const auto q = selscan_type::compute_q_values(
+            { 0.02, 0.3, 0.005, 0.04, 0.02 });
+
+        const auto epsilon = value_type(1.0e-15);
+        TEST_EQUAL(size_t(5), q.size());
+        TEST_ALMOST(0.1 / 3.0, q[0], epsilon);
+        TEST_ALMOST(0.3,       q[1], epsilon);
+        TEST_ALMOST(0.025,     q[2], epsilon);
+        TEST_ALMOST(0.05,      q[3], epsilon);
+        TEST_ALMOST(0.1 / 3.0, q[4], epsilon);
+
+        TEST_TRUE(selscan_type::compute_q_values({ }).empty());
+    }
+
+    // ------------------------------------------------------------------------
+    void top()
+    {
+        const auto all  = split(run({ }));
+        const auto best = split(run({ "--top", "3" }));
+
+        TEST_EQUAL(size_t(9), all.size());
+        TEST_EQUAL(size_t(4), best.size());
+        TEST_EQUAL(std::string("marker"), best.front().front());
+
+        //
+        // Rank the markers by their likelihood ratios, breaking ties by the
+        // marker order.
+        //
+        const auto ratio = find_column(all, "lle-ratio");
+        std::vector<size_t> order;
+        for (size_t j = 0; j < 8; j++)
+            order.push_back(j);
+
+        std::stable_sort(order.begin(), order.end(),
+            [&](const size_t lhs, const size_t rhs)
+            {
+                return std::strtod(all[lhs + 1][ratio].c_str(), nullptr)
+                     > std::strtod(all[rhs + 1][ratio].c_str(), nullptr);
+            });
+
+        for (size_t r = 0; r < 3; r++)
+        {
+            const auto j = order[r];
+            TEST_EQUAL(std::to_string(j + 1), best[r + 1].front());
+            TEST_EQUAL(join(all[j + 1].begin(), all[j + 1].end()),
+                join(best[r + 1].begin() + 1, best[r + 1].end()));
+        }
+    }
+}
+
+namespace test
+{
+    test_group selscan {
+        TEST_CASE(binary),
+        TEST_CASE(fdr),
+        TEST_CASE(p_values),
+        TEST_CASE(q_values),
+        TEST_CASE(top)
+    };
+}